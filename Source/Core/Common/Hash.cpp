@@ -7,8 +7,13 @@
 #include <bit>
 #include <cstring>
 
+#include <xxhash.h>
 #include <zlib.h>
 
+#ifdef HAVE_XXH_X86DISPATCH
+#include <xxh_x86dispatch.h>
+#endif
+
 #include "Common/BitUtils.h"
 #include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
@@ -401,6 +406,17 @@ static u64 GetHash64_ARMv8_CRC32(const u8* src, u32 len, u32 samples)
 
 #endif
 
+u64 HashXXH3(const u8* data, size_t len)
+{
+#ifdef HAVE_XXH_X86DISPATCH
+  // The bundled xxHash picks AVX2 or AVX-512 when the CPU has them, where a build for baseline
+  // x86-64 would only use SSE2. A system xxHash is used as it was built.
+  return XXH3_64bits_dispatch(data, len);
+#else
+  return XXH3_64bits(data, len);
+#endif
+}
+
 using TextureHashFunction = u64 (*)(const u8* src, u32 len, u32 samples);
 static u64 SetHash64Function(const u8* src, u32 len, u32 samples);
 static TextureHashFunction s_texture_hash_func = SetHash64Function;
@@ -424,6 +440,10 @@ static u64 SetHash64Function(const u8* src, u32 len, u32 samples)
 
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
+  // Hashing every byte with XXH3 beats the CRC32 kernels, so only use those when sampling.
+  if (samples == 0 || samples >= len / 8)
+    return HashXXH3(src, len);
+
   return s_texture_hash_func(src, len, samples);
 }
 
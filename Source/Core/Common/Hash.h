@@ -14,7 +14,11 @@ u32 HashAdler32(const u8* data, size_t len);
 // JUNK. DO NOT USE FOR NEW THINGS
 u32 HashEctor(const u8* data, size_t len);
 
-// Specialized hash function used for the texture cache
+// Fast 64-bit hash (XXH3) of the full contents of the buffer
+u64 HashXXH3(const u8* data, size_t len);
+
+// Specialized hash function used for the texture cache. With samples != 0, only that many 8-byte
+// words are hashed, which is faster but can miss changes to the data.
 u64 GetHash64(const u8* src, u32 len, u32 samples);
 
 u32 StartCRC32();
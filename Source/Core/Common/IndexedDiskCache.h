@@ -0,0 +1,587 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+#include "Common/MappedFile.h"
+#include "Common/Version.h"
+
+// On disk format:
+// header {
+//   u32 'DICX';
+//   u32 format_version;
+//   u16 sizeof(key_type);
+//   u16 sizeof(value_type);
+//   u32 entry_count;    // number of entries in the index
+//   u64 index_offset;   // zero while the index is being rewritten
+//   char version[40];   // caller-defined, the git revision by default
+// }
+//
+// record {              // in the order they were appended
+//   u32 value_size;
+//   u32 checksum;       // covers the key and the value
+//   key_type key;
+//   value_type value[value_size];
+// }
+//
+// index_entry {         // entry_count of them, sorted by the bytes of the key
+//   key_type key;
+//   u64 record_offset;
+//   u32 value_size;
+//   u32 checksum;
+// }
+
+namespace Common
+{
+// Key-value store with a sorted index, which replaces LinearDiskCache where the cache can grow
+// large. Opening a cache only reads the index. Values are memory-mapped and are only read from
+// disk (and checksummed) when they are accessed.
+//
+// New entries are appended after the existing records, and the index is rewritten after them by
+// Sync and Close. If the index is missing, e.g. because Dolphin crashed, it is rebuilt by scanning
+// the records. Replaced and erased entries leave stale records behind, which are dropped by
+// compacting the file. This happens automatically on Close once they take up most of the file.
+//
+// K and V must be trivially copyable. Keys are compared by their bytes.
+template <typename K, typename V>
+class IndexedDiskCache
+{
+  static_assert(std::is_trivially_copyable_v<K>, "K must be a trivially copyable type");
+  static_assert(std::is_trivially_copyable_v<V>, "V must be a trivially copyable type");
+
+public:
+  IndexedDiskCache() = default;
+  ~IndexedDiskCache() { Close(); }
+
+  IndexedDiskCache(const IndexedDiskCache&) = delete;
+  IndexedDiskCache& operator=(const IndexedDiskCache&) = delete;
+
+  // Opens the cache, recreating it if it is missing, corrupted or was written with a different
+  // version string. Returns the number of entries.
+  u32 Open(const std::string& filename, std::string_view version = GetScmRevGitStr())
+  {
+    Close();
+
+    m_filename = filename;
+    m_header = {};
+    std::memcpy(&m_header.id, "DICX", sizeof(u32));
+    m_header.format_version = FORMAT_VERSION;
+    m_header.key_size = sizeof(K);
+    m_header.value_size = sizeof(V);
+    std::memcpy(m_header.version, version.data(),
+                std::min(version.size(), sizeof(Header::version)));
+
+    if (!Load())
+      Create();
+    return GetEntryCount();
+  }
+
+  // Drop-in replacement for LinearDiskCache::OpenAndRead. The reader is called in key order.
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader,
+                  std::string_view version = GetScmRevGitStr())
+  {
+    Open(filename, version);
+    ForEach([&reader](const K& key, const V* value, u32 value_size) {
+      reader.Read(key, value, value_size);
+    });
+    return GetEntryCount();
+  }
+
+  bool IsOpen() const { return m_file.IsOpen(); }
+  u32 GetEntryCount() const { return static_cast<u32>(m_index.size()); }
+  bool Contains(const K& key) const { return m_index.contains(key); }
+
+  // Space taken up by replaced or erased records.
+  u64 GetStaleBytes() const { return m_data_end - sizeof(Header) - m_live_bytes; }
+
+  // Calls function(key, value, value_size) for every entry, in key order.
+  // Entries whose checksum doesn't match are erased instead.
+  template <typename F>
+  void ForEach(F&& function)
+  {
+    std::vector<u8> scratch;
+    std::vector<K> corrupt_keys;
+    for (const auto& [key, entry] : m_index)
+    {
+      const V* value = GetValue(key, entry, &scratch);
+      if (value)
+        function(key, value, entry.value_size);
+      else
+        corrupt_keys.push_back(key);
+    }
+
+    for (const K& key : corrupt_keys)
+      Erase(key);
+  }
+
+  // Copies a value out of the cache. Returns false if the key is missing or the value is corrupt.
+  bool Read(const K& key, std::vector<V>* value) const
+  {
+    const auto it = m_index.find(key);
+    if (it == m_index.end())
+      return false;
+
+    std::vector<u8> scratch;
+    const V* data = GetValue(key, it->second, &scratch);
+    if (!data)
+      return false;
+
+    value->assign(data, data + it->second.value_size);
+    return true;
+  }
+
+  // Adds a key-value pair to the store, replacing any existing value for the key.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    if (!m_file.IsOpen())
+      return;
+
+    InvalidateIndexOnDisk();
+
+    Entry entry;
+    entry.offset = m_data_end;
+    entry.value_size = value_size;
+    entry.checksum = Checksum(key, reinterpret_cast<const u8*>(value),
+                              static_cast<size_t>(value_size) * sizeof(V));
+
+    const u32 record_header[] = {entry.value_size, entry.checksum};
+    m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+    if (!m_file.WriteArray(record_header, 2) || !m_file.WriteArray(&key, 1) ||
+        (value_size != 0 && !m_file.WriteArray(value, value_size)))
+    {
+      // Don't index a partially written record. The next append overwrites it.
+      m_file.ClearError();
+      return;
+    }
+
+    AddToIndex(key, entry);
+    m_data_end += RecordSize(value_size);
+  }
+
+  void Erase(const K& key)
+  {
+    const auto it = m_index.find(key);
+    if (it == m_index.end())
+      return;
+
+    m_live_bytes -= RecordSize(it->second.value_size);
+    m_index.erase(it);
+    m_index_dirty = true;
+  }
+
+  // Writes the index, so that the next Open doesn't have to scan the records.
+  void Sync()
+  {
+    if (!m_file.IsOpen())
+      return;
+
+    if (m_index_dirty)
+    {
+      m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+      if (WriteIndex(m_file, m_index))
+      {
+        m_header.entry_count = GetEntryCount();
+        m_header.index_offset = m_data_end;
+        m_file.Seek(0, File::SeekOrigin::Begin);
+        if (m_file.WriteArray(&m_header, 1))
+        {
+          m_index_dirty = false;
+          m_index_on_disk = true;
+        }
+      }
+      m_file.ClearError();
+    }
+
+    m_file.Flush();
+  }
+
+  // Rewrites the file without stale records.
+  bool Compact()
+  {
+    if (!m_file.IsOpen())
+      return false;
+
+    const std::string temp_filename = m_filename + ".compact";
+    bool success;
+    {
+      File::IOFile out(temp_filename, "wb");
+      success = WriteCompacted(out);
+    }
+
+    m_file.Close();
+    m_mapping.Close();
+    m_index.clear();
+
+    if (!success || !File::Rename(temp_filename, m_filename))
+      File::Delete(temp_filename);
+
+    if (!Load())
+      Create();
+    return success;
+  }
+
+  void Close()
+  {
+    if (!m_file.IsOpen())
+      return;
+
+    if (GetStaleBytes() > m_live_bytes)
+      Compact();
+    else
+      Sync();
+
+    m_file.Close();
+    m_mapping.Close();
+    m_index.clear();
+  }
+
+  // Compacts a cache which is not currently open.
+  static bool CompactFile(const std::string& filename,
+                          std::string_view version = GetScmRevGitStr())
+  {
+    if (!File::Exists(filename))
+      return false;
+
+    IndexedDiskCache cache;
+    cache.Open(filename, version);
+    return cache.Compact();
+  }
+
+private:
+  static constexpr u32 FORMAT_VERSION = 1;
+  static constexpr u64 RECORD_HEADER_SIZE = sizeof(u32) * 2;
+  static constexpr size_t INDEX_ENTRY_SIZE = sizeof(K) + sizeof(u64) + sizeof(u32) * 2;
+
+  struct Header
+  {
+    u32 id;
+    u32 format_version;
+    u16 key_size;
+    u16 value_size;
+    u32 entry_count;
+    u64 index_offset;
+    char version[40];
+
+    bool operator==(const Header&) const = default;
+  };
+  static_assert(sizeof(Header) == 64, "Header must not contain padding");
+
+  struct Entry
+  {
+    u64 offset;
+    u32 value_size;
+    u32 checksum;
+  };
+
+  struct KeyLess
+  {
+    bool operator()(const K& a, const K& b) const { return std::memcmp(&a, &b, sizeof(K)) < 0; }
+  };
+
+  using Index = std::map<K, Entry, KeyLess>;
+
+  static u64 RecordSize(u32 value_size)
+  {
+    return RECORD_HEADER_SIZE + sizeof(K) + static_cast<u64>(value_size) * sizeof(V);
+  }
+
+  void AddToIndex(const K& key, const Entry& entry)
+  {
+    const auto [it, inserted] = m_index.try_emplace(key, entry);
+    if (!inserted)
+    {
+      m_live_bytes -= RecordSize(it->second.value_size);
+      it->second = entry;
+    }
+    m_live_bytes += RecordSize(entry.value_size);
+  }
+
+  static u32 Checksum(const K& key, const u8* value, size_t size)
+  {
+    const u64 hash = HashXXH3(reinterpret_cast<const u8*>(&key), sizeof(K)) ^
+                     (HashXXH3(value, size) * 0x9E3779B97F4A7C15ULL);
+    return static_cast<u32>(hash ^ (hash >> 32));
+  }
+
+  // Returns a pointer to the record's value, read into scratch if it isn't mapped or is misaligned
+  // for V, or nullptr if it can't be read or its checksum doesn't match.
+  const V* GetValue(const K& key, const Entry& entry, std::vector<u8>* scratch) const
+  {
+    const u64 value_offset = entry.offset + RECORD_HEADER_SIZE + sizeof(K);
+    const u64 value_bytes = static_cast<u64>(entry.value_size) * sizeof(V);
+    if (value_bytes == 0)
+    {
+      static const V empty_value{};
+      return Checksum(key, nullptr, 0) == entry.checksum ? &empty_value : nullptr;
+    }
+
+    const u8* data = GetBytes(value_offset, value_bytes, scratch);
+    if (!data || Checksum(key, data, static_cast<size_t>(value_bytes)) != entry.checksum)
+      return nullptr;
+
+    if (reinterpret_cast<uintptr_t>(data) % alignof(V) != 0)
+    {
+      scratch->resize(static_cast<size_t>(value_bytes) + alignof(V));
+      u8* aligned = scratch->data();
+      while (reinterpret_cast<uintptr_t>(aligned) % alignof(V) != 0)
+        aligned++;
+      std::memmove(aligned, data, static_cast<size_t>(value_bytes));
+      data = aligned;
+    }
+
+    return reinterpret_cast<const V*>(data);
+  }
+
+  // Only records which existed when the file was mapped are read through the mapping. Newer ones
+  // may still be sitting in the write buffer, so they go through the file.
+  const u8* GetBytes(u64 offset, u64 size, std::vector<u8>* scratch) const
+  {
+    if (offset + size <= m_mapped_data_end)
+    {
+      const std::span<const u8> span = m_mapping.GetSpan(offset, size);
+      if (!span.empty())
+        return span.data();
+    }
+
+    scratch->resize(static_cast<size_t>(size));
+    File::IOFile& file = const_cast<File::IOFile&>(m_file);
+    const bool success = file.Seek(offset, File::SeekOrigin::Begin) &&
+                         file.ReadBytes(scratch->data(), scratch->size());
+    file.ClearError();
+    return success ? scratch->data() : nullptr;
+  }
+
+  static bool WriteIndex(File::IOFile& file, const Index& index)
+  {
+    std::vector<u8> buffer(index.size() * INDEX_ENTRY_SIZE);
+    u8* ptr = buffer.data();
+    for (const auto& [key, entry] : index)
+    {
+      std::memcpy(ptr, &key, sizeof(K));
+      std::memcpy(ptr + sizeof(K), &entry.offset, sizeof(u64));
+      std::memcpy(ptr + sizeof(K) + sizeof(u64), &entry.value_size, sizeof(u32));
+      std::memcpy(ptr + sizeof(K) + sizeof(u64) + sizeof(u32), &entry.checksum, sizeof(u32));
+      ptr += INDEX_ENTRY_SIZE;
+    }
+    return file.WriteBytes(buffer.data(), buffer.size());
+  }
+
+  bool ReadIndex(const Header& header, u64 file_size)
+  {
+    const u64 index_size = static_cast<u64>(header.entry_count) * INDEX_ENTRY_SIZE;
+    if (header.index_offset < sizeof(Header) || header.index_offset > file_size ||
+        index_size > file_size - header.index_offset)
+    {
+      return false;
+    }
+
+    std::vector<u8> buffer(static_cast<size_t>(index_size));
+    if (!m_file.Seek(header.index_offset, File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(buffer.data(), buffer.size()))
+    {
+      return false;
+    }
+
+    const u8* ptr = buffer.data();
+    for (u32 i = 0; i < header.entry_count; i++, ptr += INDEX_ENTRY_SIZE)
+    {
+      K key;
+      Entry entry;
+      std::memcpy(&key, ptr, sizeof(K));
+      std::memcpy(&entry.offset, ptr + sizeof(K), sizeof(u64));
+      std::memcpy(&entry.value_size, ptr + sizeof(K) + sizeof(u64), sizeof(u32));
+      std::memcpy(&entry.checksum, ptr + sizeof(K) + sizeof(u64) + sizeof(u32), sizeof(u32));
+
+      // The index must be sorted, and every record must lie before it.
+      if (entry.offset < sizeof(Header) || entry.offset > header.index_offset ||
+          RecordSize(entry.value_size) > header.index_offset - entry.offset ||
+          (!m_index.empty() && !KeyLess()(m_index.rbegin()->first, key)))
+      {
+        return false;
+      }
+
+      m_index.emplace_hint(m_index.end(), key, entry);
+      m_live_bytes += RecordSize(entry.value_size);
+    }
+
+    m_data_end = header.index_offset;
+    return true;
+  }
+
+  // Rebuilds the index from the records, stopping at the first one which is incomplete or corrupt.
+  void ScanRecords(u64 file_size)
+  {
+    std::vector<u8> scratch;
+    u64 offset = sizeof(Header);
+    while (file_size - offset >= RECORD_HEADER_SIZE + sizeof(K))
+    {
+      u32 record_header[2];
+      K key;
+      if (!m_file.Seek(offset, File::SeekOrigin::Begin) || !m_file.ReadArray(record_header, 2) ||
+          !m_file.ReadArray(&key, 1))
+      {
+        break;
+      }
+
+      Entry entry;
+      entry.offset = offset;
+      entry.value_size = record_header[0];
+      entry.checksum = record_header[1];
+      const u64 record_size = RecordSize(entry.value_size);
+      if (record_size > file_size - offset || !GetValue(key, entry, &scratch))
+        break;
+
+      AddToIndex(key, entry);
+      offset += record_size;
+    }
+
+    m_file.ClearError();
+    m_data_end = offset;
+    m_index_dirty = true;
+  }
+
+  bool Load()
+  {
+    m_index.clear();
+    m_live_bytes = 0;
+    m_index_dirty = false;
+    m_index_on_disk = false;
+
+    if (!m_file.Open(m_filename, "r+b", File::SharedAccess::Read))
+      return false;
+
+    Header header;
+    if (!m_file.ReadArray(&header, 1) || header.id != m_header.id ||
+        header.format_version != m_header.format_version ||
+        header.key_size != m_header.key_size || header.value_size != m_header.value_size ||
+        std::memcmp(header.version, m_header.version, sizeof(Header::version)) != 0)
+    {
+      m_file.Close();
+      return false;
+    }
+
+    // If mapping fails (e.g. for Android content URIs), values are read through the file instead.
+    m_mapping.Open(m_filename);
+
+    const u64 file_size = m_file.GetSize();
+    m_data_end = sizeof(Header);
+    m_mapped_data_end = file_size;
+    if (header.index_offset != 0 && ReadIndex(header, file_size))
+    {
+      m_header.entry_count = header.entry_count;
+      m_header.index_offset = header.index_offset;
+      m_index_on_disk = true;
+    }
+    else
+    {
+      m_index.clear();
+      m_live_bytes = 0;
+      ScanRecords(file_size);
+    }
+
+    m_mapped_data_end = m_data_end;
+    m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+    return true;
+  }
+
+  void Create()
+  {
+    m_file.Close();
+    m_mapping.Close();
+    m_index.clear();
+    m_live_bytes = 0;
+    m_data_end = sizeof(Header);
+    m_mapped_data_end = 0;
+    m_header.entry_count = 0;
+    m_header.index_offset = 0;
+    m_index_dirty = true;
+    m_index_on_disk = false;
+
+    if (m_file.Open(m_filename, "w+b", File::SharedAccess::Read))
+      m_file.WriteArray(&m_header, 1);
+  }
+
+  // Appended records overwrite the index, so mark it as missing before the first one.
+  void InvalidateIndexOnDisk()
+  {
+    m_index_dirty = true;
+    if (!m_index_on_disk)
+      return;
+
+    m_header.entry_count = 0;
+    m_header.index_offset = 0;
+    m_file.Seek(0, File::SeekOrigin::Begin);
+    m_file.WriteArray(&m_header, 1);
+    m_index_on_disk = false;
+  }
+
+  bool WriteCompacted(File::IOFile& out)
+  {
+    Header header = m_header;
+    header.entry_count = 0;
+    header.index_offset = 0;
+    if (!out.WriteArray(&header, 1))
+      return false;
+
+    Index new_index;
+    std::vector<u8> scratch;
+    u64 offset = sizeof(Header);
+    for (const auto& [key, entry] : m_index)
+    {
+      const V* value = GetValue(key, entry, &scratch);
+      if (!value)
+        continue;
+
+      const u32 record_header[] = {entry.value_size, entry.checksum};
+      if (!out.WriteArray(record_header, 2) || !out.WriteArray(&key, 1) ||
+          !out.WriteArray(value, entry.value_size))
+      {
+        return false;
+      }
+
+      new_index.emplace_hint(new_index.end(), key,
+                             Entry{offset, entry.value_size, entry.checksum});
+      offset += RecordSize(entry.value_size);
+    }
+
+    if (!WriteIndex(out, new_index))
+      return false;
+
+    header.entry_count = static_cast<u32>(new_index.size());
+    header.index_offset = offset;
+    return out.Seek(0, File::SeekOrigin::Begin) && out.WriteArray(&header, 1) && out.Flush();
+  }
+
+  std::string m_filename;
+  Header m_header{};
+  File::IOFile m_file;
+  MappedFile m_mapping;
+  Index m_index;
+
+  // End of the last record, where the index is written and new records are appended.
+  u64 m_data_end = 0;
+  // Records before this offset can be read through the mapping.
+  u64 m_mapped_data_end = 0;
+  // Total size of the records in the index.
+  u64 m_live_bytes = 0;
+  // Whether the index differs from the one in the file.
+  bool m_index_dirty = false;
+  // Whether the header currently points to a valid index.
+  bool m_index_on_disk = false;
+};
+}  // namespace Common
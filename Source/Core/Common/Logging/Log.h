@@ -30,6 +30,7 @@ enum class LogType : int
   DVDINTERFACE,
   DYNA_REC,
   EXPANSIONINTERFACE,
+  FIFOPLAYER,
   FILEMON,
   FRAMEDUMP,
   GDB_STUB,
@@ -114,6 +114,7 @@ LogManager::LogManager()
   m_log[LogType::DVDINTERFACE] = {"DVD", "DVD Interface"};
   m_log[LogType::DYNA_REC] = {"JIT", "JIT Dynamic Recompiler"};
   m_log[LogType::EXPANSIONINTERFACE] = {"EXI", "Expansion Interface"};
+  m_log[LogType::FIFOPLAYER] = {"FIFOPLAYER", "FIFO Player"};
   m_log[LogType::FILEMON] = {"FileMon", "File Monitor"};
   m_log[LogType::FRAMEDUMP] = {"FRAMEDUMP", "FrameDump"};
   m_log[LogType::GDB_STUB] = {"GDB_STUB", "GDB Stub"};
@@ -0,0 +1,52 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// Read-only view of a whole file, mapped into memory so that pages are only read from disk when
+// they are first accessed. The mapping reflects the size of the file at the time it was opened.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  bool Open(const std::string& filename);
+  void Close();
+
+  bool IsOpen() const { return m_is_open; }
+  const u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+  // Returns an empty span if the range is not entirely within the file.
+  std::span<const u8> GetSpan(u64 offset, u64 size) const
+  {
+    if (offset > m_size || size > m_size - offset)
+      return {};
+    return {m_data + offset, static_cast<size_t>(size)};
+  }
+
+private:
+  void Swap(MappedFile& other) noexcept;
+
+  const u8* m_data = nullptr;
+  u64 m_size = 0;
+  bool m_is_open = false;
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
+};
+}  // namespace Common
@@ -0,0 +1,104 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPool.h"
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+ThreadPool::ThreadPool(std::string_view name, u32 num_workers)
+{
+  Reset(name, num_workers);
+}
+
+ThreadPool::~ThreadPool()
+{
+  Shutdown();
+}
+
+void ThreadPool::Reset(std::string_view name, u32 num_workers)
+{
+  Shutdown();
+
+  std::lock_guard lk(m_lock);
+  m_name = name;
+  m_shutdown = false;
+  m_workers.reserve(num_workers);
+  for (u32 i = 0; i < num_workers; i++)
+    m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+void ThreadPool::Shutdown()
+{
+  {
+    std::lock_guard lk(m_lock);
+    m_shutdown = true;
+    m_worker_cond_var.notify_all();
+  }
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+  if (m_workers.empty() || count <= 1)
+  {
+    for (size_t i = 0; i < count; i++)
+      function(i);
+    return;
+  }
+
+  Job job;
+  job.function = &function;
+  job.count = count;
+  {
+    std::lock_guard lk(m_lock);
+    m_job = &job;
+    m_generation++;
+    m_worker_cond_var.notify_all();
+  }
+
+  RunJob(&job);
+
+  // Every item has been claimed at this point, but workers may still be processing theirs.
+  // Unpublish the job first so that no worker which wakes up late can start on it.
+  std::unique_lock lk(m_lock);
+  m_job = nullptr;
+  m_done_cond_var.wait(lk, [&] { return job.active_workers == 0; });
+}
+
+void ThreadPool::RunJob(Job* job)
+{
+  for (size_t i = job->next_index++; i < job->count; i = job->next_index++)
+    (*job->function)(i);
+}
+
+void ThreadPool::WorkerLoop()
+{
+  Common::SetCurrentThreadName(m_name.c_str());
+
+  std::unique_lock lk(m_lock);
+  u64 last_generation = m_generation;
+  while (true)
+  {
+    m_worker_cond_var.wait(
+        lk, [&] { return m_shutdown || (m_job != nullptr && m_generation != last_generation); });
+    if (m_shutdown)
+      return;
+
+    Job* const job = m_job;
+    last_generation = m_generation;
+    job->active_workers++;
+    lk.unlock();
+
+    RunJob(job);
+
+    lk.lock();
+    if (--job->active_workers == 0)
+      m_done_cond_var.notify_one();
+  }
+}
+}  // namespace Common
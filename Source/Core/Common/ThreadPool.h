@@ -0,0 +1,71 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A fixed set of worker threads that split a loop of independent items between them.
+// The calling thread takes part in the work, and ParallelFor only returns once every item has been
+// processed, so the items may freely reference the caller's stack.
+
+namespace Common
+{
+class ThreadPool
+{
+public:
+  ThreadPool() = default;
+  ThreadPool(std::string_view name, u32 num_workers);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  // Stops the current workers (if any) and starts num_workers new ones.
+  // With zero workers, ParallelFor runs every item on the calling thread.
+  void Reset(std::string_view name, u32 num_workers);
+
+  // Blocks until all workers have exited.
+  void Shutdown();
+
+  // Number of worker threads, not counting the thread calling ParallelFor.
+  u32 GetNumWorkers() const { return static_cast<u32>(m_workers.size()); }
+
+  // Calls function(i) for every i in [0, count) and waits for all calls to finish.
+  // Must not be called from multiple threads at the same time, nor from within a work item.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& function);
+
+private:
+  struct Job
+  {
+    const std::function<void(size_t)>* function;
+    size_t count;
+    std::atomic<size_t> next_index{0};
+    u32 active_workers = 0;
+  };
+
+  static void RunJob(Job* job);
+  void WorkerLoop();
+
+  std::string m_name;
+  std::vector<std::thread> m_workers;
+  std::mutex m_lock;
+  std::condition_variable m_worker_cond_var;
+  std::condition_variable m_done_cond_var;
+  Job* m_job = nullptr;
+  u64 m_generation = 0;
+  bool m_shutdown = false;
+};
+}  // namespace Common
@@ -0,0 +1,290 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/TraceRecorder.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common
+{
+namespace
+{
+constexpr std::size_t EVENTS_PER_CHUNK = 1 << 14;
+
+enum class EventType : u8
+{
+  Zone,
+  Marker,
+};
+
+struct Event
+{
+  const char* name;
+  u64 start;
+  u64 end;
+  EventType type;
+};
+
+using Chunk = std::array<Event, EVENTS_PER_CHUNK>;
+
+// A ring of the latest events, written only by its thread. Events are published through the
+// release store of the number of events, so the buffer can be read while the thread is still adding
+// to it. The reader checks num_started afterwards to find the events overwritten meanwhile.
+struct ThreadBuffer
+{
+  ThreadBuffer(u32 thread_id_, std::string name_, std::size_t max_events)
+      : thread_id(thread_id_), name(std::move(name_)),
+        capacity(std::max<std::size_t>(max_events, 1)),
+        chunks((capacity + EVENTS_PER_CHUNK - 1) / EVENTS_PER_CHUNK)
+  {
+  }
+
+  void Push(const Event& event)
+  {
+    const std::size_t index = num_events.load(std::memory_order_relaxed);
+    const std::size_t slot = index % capacity;
+    const std::size_t chunk = slot / EVENTS_PER_CHUNK;
+    if (!chunks[chunk])
+      chunks[chunk] = std::make_unique<Chunk>();
+    num_started.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    (*chunks[chunk])[slot % EVENTS_PER_CHUNK] = event;
+    num_events.store(index + 1, std::memory_order_release);
+  }
+
+  const Event& Get(std::size_t index) const
+  {
+    const std::size_t slot = index % capacity;
+    return (*chunks[slot / EVENTS_PER_CHUNK])[slot % EVENTS_PER_CHUNK];
+  }
+
+  // Returns the index of the oldest event which hasn't been overwritten.
+  std::size_t GetFirstIndex(std::size_t end) const { return end - std::min(end, capacity); }
+
+  const u32 thread_id;
+  // Guarded by s_mutex.
+  std::string name;
+  const std::size_t capacity;
+  // Never resized, so that the reader doesn't race with the allocation of chunks.
+  std::vector<std::unique_ptr<Chunk>> chunks;
+  // The number of events added since the start of the recording, including overwritten ones.
+  std::atomic<std::size_t> num_events = 0;
+  std::atomic<std::size_t> num_started = 0;
+};
+
+struct ThreadState
+{
+  std::shared_ptr<ThreadBuffer> buffer;
+  u32 session = 0;
+  u32 thread_id = 0;
+  std::string name;
+};
+
+std::mutex s_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+std::size_t s_max_events_per_thread = 0;
+u64 s_start_time = 0;
+std::atomic<u32> s_session = 0;
+std::atomic<u32> s_next_thread_id = 1;
+
+thread_local ThreadState s_thread;
+
+ThreadBuffer* GetThreadBuffer()
+{
+  if (s_thread.buffer && s_thread.session == s_session.load(std::memory_order_relaxed))
+    return s_thread.buffer.get();
+
+  std::lock_guard lk(s_mutex);
+  if (!TraceRecorder::IsRecording())
+    return nullptr;
+
+  if (s_thread.thread_id == 0)
+    s_thread.thread_id = s_next_thread_id++;
+  std::string name =
+      s_thread.name.empty() ? fmt::format("Thread {}", s_thread.thread_id) : s_thread.name;
+  s_thread.buffer = std::make_shared<ThreadBuffer>(s_thread.thread_id, std::move(name),
+                                                   s_max_events_per_thread);
+  s_thread.session = s_session.load(std::memory_order_relaxed);
+  s_buffers.push_back(s_thread.buffer);
+  return s_thread.buffer.get();
+}
+
+void AddEvent(const Event& event)
+{
+  if (ThreadBuffer* buffer = GetThreadBuffer())
+    buffer->Push(event);
+}
+
+std::string EscapeJson(std::string_view str)
+{
+  std::string result;
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    if (static_cast<unsigned char>(c) < 0x20)
+      result += fmt::format("\\u{:04x}", static_cast<int>(c));
+    else
+      result += c;
+  }
+  return result;
+}
+}  // namespace
+
+void TraceRecorder::Start(std::size_t max_events_per_thread)
+{
+  std::lock_guard lk(s_mutex);
+  s_buffers.clear();
+  s_max_events_per_thread = max_events_per_thread;
+  s_start_time = GetTimestamp();
+  // Threads notice the new session on their next event, and start a new buffer.
+  s_session++;
+  s_recording.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Stop()
+{
+  std::lock_guard lk(s_mutex);
+  s_recording.store(false, std::memory_order_relaxed);
+}
+
+std::size_t TraceRecorder::GetNumOverwrittenEvents()
+{
+  std::lock_guard lk(s_mutex);
+  std::size_t num_overwritten = 0;
+  for (const auto& buffer : s_buffers)
+    num_overwritten += buffer->GetFirstIndex(buffer->num_events.load(std::memory_order_acquire));
+  return num_overwritten;
+}
+
+bool TraceRecorder::WriteChromeTrace(const std::string& path)
+{
+  std::lock_guard lk(s_mutex);
+  File::IOFile file(path, "wb");
+  if (!file)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open trace file {}", path);
+    return false;
+  }
+
+  // Timestamps are in microseconds, relative to the start of the recording.
+  const auto to_us = [](u64 time) {
+    return static_cast<double>(time - std::min(time, s_start_time)) / 1000;
+  };
+
+  std::string out = R"({"displayTimeUnit":"ms","traceEvents":[)";
+  const char* separator = "\n";
+  std::size_t num_events = 0;
+  std::size_t num_overwritten = 0;
+  std::vector<Event> events;
+  bool success = true;
+  for (const auto& buffer : s_buffers)
+  {
+    fmt::format_to(std::back_inserter(out),
+                   R"({}{{"ph":"M","pid":1,"tid":{},"name":"thread_name","args":{{"name":"{}"}}}})",
+                   separator, buffer->thread_id, EscapeJson(buffer->name));
+    separator = ",\n";
+
+    // The thread may still be adding events, so they are copied first, and the ones which were
+    // overwritten meanwhile are skipped.
+    const std::size_t end = buffer->num_events.load(std::memory_order_acquire);
+    const std::size_t first = buffer->GetFirstIndex(end);
+    events.clear();
+    for (std::size_t i = first; i < end; i++)
+      events.push_back(buffer->Get(i));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::size_t started = buffer->num_started.load(std::memory_order_relaxed);
+    const std::size_t skipped = std::min(buffer->GetFirstIndex(started) - first, events.size());
+
+    for (auto it = events.begin() + skipped; it != events.end(); ++it)
+    {
+      const Event& event = *it;
+      if (event.type == EventType::Zone)
+      {
+        fmt::format_to(std::back_inserter(out),
+                       R"({}{{"ph":"X","pid":1,"tid":{},"name":"{}","ts":{:.3f},"dur":{:.3f}}})",
+                       separator, buffer->thread_id, EscapeJson(event.name), to_us(event.start),
+                       static_cast<double>(event.end - event.start) / 1000);
+      }
+      else
+      {
+        fmt::format_to(std::back_inserter(out),
+                       R"({}{{"ph":"i","s":"g","pid":1,"tid":{},"name":"{}","ts":{:.3f}}})",
+                       separator, buffer->thread_id, EscapeJson(event.name), to_us(event.start));
+      }
+
+      // Write in pieces rather than keeping the whole trace in memory.
+      if (out.size() >= 1 << 20)
+      {
+        success &= file.WriteString(out);
+        out.clear();
+      }
+    }
+    num_events += events.size() - skipped;
+    num_overwritten += first + skipped;
+  }
+  out += "\n]}\n";
+  success &= file.WriteString(out);
+
+  if (num_overwritten != 0)
+  {
+    NOTICE_LOG_FMT(COMMON, "{} older trace events were overwritten, as the buffers were full",
+                   num_overwritten);
+  }
+  if (!success)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to write trace file {}", path);
+    return false;
+  }
+
+  NOTICE_LOG_FMT(COMMON, "Wrote {} trace events to {}", num_events, path);
+  return true;
+}
+
+void TraceRecorder::SetCurrentThreadName(const char* name)
+{
+  s_thread.name = name;
+  if (s_thread.buffer)
+  {
+    std::lock_guard lk(s_mutex);
+    s_thread.buffer->name = name;
+  }
+}
+
+void TraceRecorder::AddZone(const char* name, u64 start_ns, u64 end_ns)
+{
+  if (!IsRecording())
+    return;
+
+  AddEvent({name, start_ns, end_ns, EventType::Zone});
+}
+
+void TraceRecorder::AddMarker(const char* name)
+{
+  if (!IsRecording())
+    return;
+
+  const u64 time = GetTimestamp();
+  AddEvent({name, time, time, EventType::Marker});
+}
+
+u64 TraceRecorder::GetTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace Common
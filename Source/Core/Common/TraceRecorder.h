@@ -0,0 +1,75 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Records timed zones on any thread, to be viewed in chrome://tracing or ui.perfetto.dev.
+//
+// Every thread appends to its own buffer without taking locks, so a zone costs two clock reads
+// while recording and a single relaxed load otherwise. Once a thread's buffer is full, its new
+// events overwrite the oldest ones, so a recording of any length keeps its latest events.
+
+namespace Common
+{
+class TraceRecorder
+{
+public:
+  static constexpr std::size_t DEFAULT_MAX_EVENTS_PER_THREAD = 1 << 20;
+
+  // Discards the events of the previous recording.
+  static void Start(std::size_t max_events_per_thread = DEFAULT_MAX_EVENTS_PER_THREAD);
+  static void Stop();
+  static bool IsRecording() { return s_recording.load(std::memory_order_relaxed); }
+
+  // Writes the events of the last recording in Chrome's trace event format.
+  static bool WriteChromeTrace(const std::string& path);
+
+  // Returns the number of events which were overwritten by newer ones during the last recording.
+  static std::size_t GetNumOverwrittenEvents();
+
+  // Names the current thread in the trace. Called by Common::SetCurrentThreadName.
+  static void SetCurrentThreadName(const char* name);
+
+  // The names must be string literals, as only the pointers are stored.
+  static void AddZone(const char* name, u64 start_ns, u64 end_ns);
+  static void AddMarker(const char* name);
+
+  static u64 GetTimestamp();
+
+  class Zone
+  {
+  public:
+    explicit Zone(const char* name)
+    {
+      if (IsRecording())
+      {
+        m_name = name;
+        m_start = GetTimestamp();
+      }
+    }
+    ~Zone()
+    {
+      if (m_name)
+        AddZone(m_name, m_start, GetTimestamp());
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+  private:
+    const char* m_name = nullptr;
+    u64 m_start = 0;
+  };
+
+private:
+  static inline std::atomic<bool> s_recording = false;
+};
+}  // namespace Common
+
+#define TRACE_ZONE(name) Common::TraceRecorder::Zone trace_zone_gen(name)
@@ -357,11 +357,13 @@ private:
   void WriteSSSE3Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteSSE41Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
   void WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
+  void WriteAVX2Op(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
+                   int extrabytes = 0);
   void WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
@@ -877,6 +879,30 @@ public:
   void VPOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
 
+  // AVX: VEX encoded moves and conversions. Unlike their SSE counterparts, these can be mixed with
+  // 256-bit instructions without a state transition penalty.
+  void VMOVD_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVQ_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVDQU(X64Reg dest, const OpArg& arg);
+  void VMOVSS(const OpArg& arg, X64Reg src);
+  void VMOVLPS(const OpArg& arg, X64Reg src);
+  void VMOVUPS(const OpArg& arg, X64Reg src);
+  void VEXTRACTPS(const OpArg& arg, X64Reg src, u8 subreg);
+  void VCVTSI2SS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VZEROUPPER();
+
+  // AVX and AVX2: 256-bit operations. Register operands are YMM registers, except for the 128-bit
+  // operand of VEXTRACTI128. The broadcasts only take memory operands here.
+  void VCVTDQ2PS_256(X64Reg dest, const OpArg& arg);
+  void VMULPS_256(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSHUFB_256(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSRAD_256(X64Reg dest, X64Reg src, u8 shift);
+  void VPBLENDD_256(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 blend);
+  void VPBROADCASTD_256(X64Reg dest, const OpArg& arg);
+  void VPBROADCASTQ_256(X64Reg dest, const OpArg& arg);
+  void VBROADCASTI128(X64Reg dest, const OpArg& arg);
+  void VEXTRACTI128(const OpArg& arg, X64Reg src, u8 lane);
+
   // FMA3
   void VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VFMADD213PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
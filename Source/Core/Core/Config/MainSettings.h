@@ -145,6 +145,11 @@ extern const Info<std::string> MAIN_GPU_DETERMINISM_MODE;
 GPUDeterminismMode GetGPUDeterminismMode();
 
 extern const Info<std::string> MAIN_PERF_MAP_DIR;
+// Records a trace of the emulation threads, written to the Dump folder when emulation stops.
+// Each thread keeps only its latest MAIN_TRACE_MAX_EVENTS_PER_THREAD events, so long sessions
+// are cut down to their end.
+extern const Info<bool> MAIN_TRACE_RECORDING;
+extern const Info<u32> MAIN_TRACE_MAX_EVENTS_PER_THREAD;
 extern const Info<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
@@ -300,6 +305,7 @@ extern const Info<bool> MAIN_GAMELIST_COLUMN_TAGS;
 
 extern const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY;
 extern const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES;
+extern const Info<bool> MAIN_FIFOPLAYER_COMPRESS_RECORDINGS;
 
 // Main.AutoUpdate
 
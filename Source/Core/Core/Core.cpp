@@ -37,6 +37,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/TraceRecorder.h"
 #include "Common/Version.h"
 
 #include "Core/AchievementManager.h"
@@ -44,6 +45,7 @@
 #include "Core/BootManager.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -475,6 +477,14 @@ static void FifoPlayerThread(Core::System& system, const std::optional<std::stri
   }
 }
 
+static std::string GenerateTraceName(std::time_t start_time)
+{
+  const std::string path = File::GetUserPath(D_DUMP_IDX);
+  File::CreateFullPath(path);
+  return fmt::format("{}trace_{}_{:%Y-%m-%d_%H-%M-%S}.json", path,
+                     SConfig::GetInstance().GetGameID(), fmt::localtime(start_time));
+}
+
 // Initialize and create emulation thread
 // Call browser: Init():s_emu_thread().
 // See the BootManager.cpp file description for a complete call schedule.
@@ -492,6 +502,17 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
 
   Common::SetCurrentThreadName("Emuthread - Starting");
 
+  const bool record_trace = Config::Get(Config::MAIN_TRACE_RECORDING);
+  const std::time_t trace_start_time = std::time(nullptr);
+  if (record_trace)
+    Common::TraceRecorder::Start(Config::Get(Config::MAIN_TRACE_MAX_EVENTS_PER_THREAD));
+  Common::ScopeGuard trace_guard{[record_trace, trace_start_time] {
+    if (!record_trace)
+      return;
+    Common::TraceRecorder::Stop();
+    Common::TraceRecorder::WriteChromeTrace(GenerateTraceName(trace_start_time));
+  }};
+
   DeclareAsGPUThread();
 
   // For a time this acts as the CPU thread...
@@ -545,7 +566,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
 
   FreeLook::LoadInputConfig();
 
-  system.GetCustomAssetLoader().Init();
+  system.GetCustomAssetLoader().Init(Config::Get(Config::GFX_CUSTOM_ASSET_LOADER_THREADS));
   Common::ScopeGuard asset_loader_guard([&system] { system.GetCustomAssetLoader().Shutdown(); });
 
   system.GetMovie().Init(*boot);
@@ -873,6 +894,7 @@ void RunOnCPUThread(Core::System& system, std::function<void()> function, bool w
 // frame is presented to the host screen
 void Callback_FramePresented(double actual_emulation_speed)
 {
+  Common::TraceRecorder::AddMarker("Frame");
   g_perf_metrics.CountFrame();
 
   s_last_actual_emulation_speed = actual_emulation_speed;
@@ -9,18 +9,24 @@
 #include <string>
 #include <vector>
 
+#include <zstd.h>
+
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
+constexpr u32 VERSION_NUMBER = 6;
 constexpr u32 MIN_LOADER_VERSION = 1;
 // This value is only used if the DFF file was created with overridden RAM sizes.
 // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
 constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+// Likewise, only used for compressed files.
+constexpr u32 MIN_LOADER_VERSION_FOR_COMPRESSION = 6;
 
 #pragma pack(push, 1)
 
@@ -75,6 +81,67 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 #pragma pack(pop)
 
+namespace
+{
+using ZSTDDecompressContext = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+
+FifoFrameView GetRecordedFrame(const FifoFrameInfo& frame, bool include_memory_updates)
+{
+  FifoFrameView view;
+  view.fifoData = frame.fifoData;
+  view.fifoStart = frame.fifoStart;
+  view.fifoEnd = frame.fifoEnd;
+
+  if (include_memory_updates)
+  {
+    view.memoryUpdates.reserve(frame.memoryUpdates.size());
+    for (const MemoryUpdate& update : frame.memoryUpdates)
+      view.memoryUpdates.push_back({update.fifoPosition, update.address, update.data, update.type});
+  }
+
+  return view;
+}
+
+// Checks that the data at the offset is within the file. Compressed data must be a zstd frame
+// which decompresses to exactly size bytes.
+bool IsDataInFile(const Common::MappedFile& file, u64 offset, u32 size, bool compressed)
+{
+  if (!compressed)
+    return file.GetSpan(offset, size).size() == size;
+
+  const u64 file_size = file.GetSize();
+  const std::span<const u8> data = file.GetSpan(offset, file_size - std::min(offset, file_size));
+  return !ZSTD_isError(ZSTD_findFrameCompressedSize(data.data(), data.size())) &&
+         ZSTD_getFrameContentSize(data.data(), data.size()) == size;
+}
+
+// The list was checked to be within the file when it was loaded.
+FileMemoryUpdate ReadMemoryUpdate(const Common::MappedFile& file, u64 list_offset, u32 index)
+{
+  FileMemoryUpdate update;
+  const std::span<const u8> data =
+      file.GetSpan(list_offset + index * sizeof(FileMemoryUpdate), sizeof(FileMemoryUpdate));
+  std::memcpy(&update, data.data(), sizeof(FileMemoryUpdate));
+  return update;
+}
+
+// Decompresses the zstd frame at the offset, which must hold exactly size bytes, to out.
+std::span<const u8> DecompressData(const Common::MappedFile& file, ZSTD_DCtx* context, u64 offset,
+                                   u32 size, u8* out)
+{
+  const std::span<const u8> data = file.GetSpan(offset, file.GetSize() - offset);
+  const size_t compressed_size = ZSTD_findFrameCompressedSize(data.data(), data.size());
+  if (ZSTD_isError(compressed_size) ||
+      ZSTD_decompressDCtx(context, out, size, data.data(), compressed_size) != size)
+  {
+    ERROR_LOG_FMT(FIFOPLAYER, "Failed to decompress FIFO log data at offset {}", offset);
+    return {};
+  }
+
+  return {out, size};
+}
+}  // namespace
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -104,109 +171,129 @@ void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
   m_Frames.push_back(frameInfo);
 }
 
-bool FifoDataFile::Save(const std::string& filename)
+FifoFrameView FifoDataFile::GetFrame(u32 frame, bool include_memory_updates) const
 {
-  File::IOFile file;
-  if (!file.Open(filename, "wb"))
-    return false;
+  if (!m_mapped_file.IsOpen())
+    return GetRecordedFrame(m_Frames[frame], include_memory_updates);
 
-  // Add space for header
-  PadFile(sizeof(FileHeader), file);
-
-  // Add space for frame list
-  u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
-
-  u64 bpMemOffset = file.Tell();
-  file.WriteArray(m_BPMem);
-
-  u64 cpMemOffset = file.Tell();
-  file.WriteArray(m_CPMem);
-
-  u64 xfMemOffset = file.Tell();
-  file.WriteArray(m_XFMem);
+  return GetLoadedFrame(m_loaded_frames[frame], include_memory_updates);
+}
 
-  u64 xfRegsOffset = file.Tell();
-  file.WriteArray(m_XFRegs);
+u32 FifoDataFile::GetFrameCount() const
+{
+  if (!m_mapped_file.IsOpen())
+    return static_cast<u32>(m_Frames.size());
 
-  u64 texMemOffset = file.Tell();
-  file.WriteArray(m_TexMem);
+  return static_cast<u32>(m_loaded_frames.size());
+}
 
-  // Write header
-  FileHeader header;
-  header.fileId = FILE_ID;
-  header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+FifoFrameView FifoDataFile::GetLoadedFrame(const LoadedFrame& frame,
+                                           bool include_memory_updates) const
+{
+  if (GetFlag(FLAG_IS_COMPRESSED))
+  {
+    {
+      std::lock_guard lk(m_frame_cache_mutex);
+      if (m_cached_frame == &frame && include_memory_updates)
+        return m_cached_frame_view;
+      if (m_cached_frame == &frame)
+      {
+        return {m_cached_frame_view.fifoData, m_cached_frame_view.fifoStart,
+                m_cached_frame_view.fifoEnd, {}, m_cached_frame_view.storage};
+      }
+    }
+
+    FifoFrameView view = DecompressFrame(frame, include_memory_updates);
+    if (include_memory_updates)
+    {
+      std::lock_guard lk(m_frame_cache_mutex);
+      m_cached_frame = &frame;
+      m_cached_frame_view = view;
+    }
+    return view;
+  }
 
-  header.bpMemOffset = bpMemOffset;
-  header.bpMemSize = BP_MEM_SIZE;
+  FifoFrameView view;
+  view.fifoData = m_mapped_file.GetSpan(frame.fifoDataOffset, frame.fifoDataSize);
+  view.fifoStart = frame.fifoStart;
+  view.fifoEnd = frame.fifoEnd;
 
-  header.cpMemOffset = cpMemOffset;
-  header.cpMemSize = CP_MEM_SIZE;
+  if (include_memory_updates)
+  {
+    view.memoryUpdates.reserve(frame.numMemoryUpdates);
+    for (u32 i = 0; i < frame.numMemoryUpdates; ++i)
+    {
+      // The data was checked to be within the file when it was loaded.
+      const FileMemoryUpdate update = ReadMemoryUpdate(m_mapped_file, frame.memoryUpdatesOffset, i);
+      view.memoryUpdates.push_back({update.fifoPosition, update.address,
+                                    m_mapped_file.GetSpan(update.dataOffset, update.dataSize),
+                                    static_cast<MemoryUpdate::Type>(update.type)});
+    }
+  }
 
-  header.xfMemOffset = xfMemOffset;
-  header.xfMemSize = XF_MEM_SIZE;
+  return view;
+}
 
-  header.xfRegsOffset = xfRegsOffset;
-  header.xfRegsSize = XF_REGS_SIZE;
+FifoFrameView FifoDataFile::DecompressFrame(const LoadedFrame& frame,
+                                            bool include_memory_updates) const
+{
+  std::vector<FileMemoryUpdate> updates;
+  size_t size = frame.fifoDataSize;
+  if (include_memory_updates)
+  {
+    updates.reserve(frame.numMemoryUpdates);
+    for (u32 i = 0; i < frame.numMemoryUpdates; ++i)
+    {
+      updates.push_back(ReadMemoryUpdate(m_mapped_file, frame.memoryUpdatesOffset, i));
+      size += updates.back().dataSize;
+    }
+  }
 
-  header.texMemOffset = texMemOffset;
-  header.texMemSize = TEX_MEM_SIZE;
+  // All of the frame's data is decompressed into one buffer, which is kept alive by the view.
+  auto storage = std::make_shared<std::vector<u8>>(size);
+  const ZSTDDecompressContext context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+  u8* out = storage->data();
 
-  header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  FifoFrameView view;
+  view.fifoData =
+      DecompressData(m_mapped_file, context.get(), frame.fifoDataOffset, frame.fifoDataSize, out);
+  view.fifoStart = frame.fifoStart;
+  view.fifoEnd = frame.fifoEnd;
+  out += frame.fifoDataSize;
 
-  header.flags = m_Flags;
+  view.memoryUpdates.reserve(updates.size());
+  for (const FileMemoryUpdate& update : updates)
+  {
+    view.memoryUpdates.push_back(
+        {update.fifoPosition, update.address,
+         DecompressData(m_mapped_file, context.get(), update.dataOffset, update.dataSize, out),
+         static_cast<MemoryUpdate::Type>(update.type)});
+    out += update.dataSize;
+  }
 
-  auto& system = Core::System::GetInstance();
-  auto& memory = system.GetMemory();
-  header.mem1_size = memory.GetRamSizeReal();
-  header.mem2_size = memory.GetExRamSizeReal();
+  view.storage = std::move(storage);
+  return view;
+}
 
-  file.Seek(0, File::SeekOrigin::Begin);
-  file.WriteBytes(&header, sizeof(FileHeader));
+bool FifoDataFile::Save(const std::string& filename)
+{
+  FifoDataFileWriter writer;
+  if (!writer.Open(filename, Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS)))
+    return false;
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
+  for (u32 i = 0; i < GetFrameCount(); ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+    if (!writer.WriteFrame(GetFrame(i)))
+      return false;
   }
 
-  if (!file.Close())
-    return false;
-
-  return true;
+  return writer.Close(*this);
 }
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file)
+  Common::MappedFile mapped_file;
+  if (!mapped_file.Open(filename))
     return nullptr;
 
   auto panic_failed_to_read = []() {
@@ -214,16 +301,24 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     return nullptr;
   };
 
-  if (file.GetSize() == 0)
+  // Copies from the mapping, failing if the range is not within the file.
+  const auto read = [&mapped_file](u64 offset, void* dest, size_t size) {
+    const std::span<const u8> data = mapped_file.GetSpan(offset, size);
+    if (data.size() != size)
+      return false;
+    std::memcpy(dest, data.data(), size);
+    return true;
+  };
+
+  if (mapped_file.GetSize() == 0)
   {
     CriticalAlertFmtT("DFF file size is 0; corrupt/incomplete file?");
     return nullptr;
   }
 
   FileHeader header;
-  if (!file.ReadBytes(&header, sizeof(header)))
+  if (!read(0, &header, sizeof(header)))
     return panic_failed_to_read();
-
   if (header.fileId != FILE_ID)
   {
     CriticalAlertFmtT("DFF file magic number is incorrect: got {0:08x}, expected {1:08x}",
@@ -285,72 +380,69 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   }
 
   u32 size = std::min<u32>(BP_MEM_SIZE, header.bpMemSize);
-  file.Seek(header.bpMemOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_BPMem.data(), size);
+  if (!read(header.bpMemOffset, dataFile->m_BPMem.data(), size * sizeof(u32)))
+    return panic_failed_to_read();
 
   size = std::min<u32>(CP_MEM_SIZE, header.cpMemSize);
-  file.Seek(header.cpMemOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_CPMem.data(), size);
+  if (!read(header.cpMemOffset, dataFile->m_CPMem.data(), size * sizeof(u32)))
+    return panic_failed_to_read();
 
   size = std::min<u32>(XF_MEM_SIZE, header.xfMemSize);
-  file.Seek(header.xfMemOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_XFMem.data(), size);
+  if (!read(header.xfMemOffset, dataFile->m_XFMem.data(), size * sizeof(u32)))
+    return panic_failed_to_read();
 
   size = std::min<u32>(XF_REGS_SIZE, header.xfRegsSize);
-  file.Seek(header.xfRegsOffset, File::SeekOrigin::Begin);
-  file.ReadArray(dataFile->m_XFRegs.data(), size);
+  if (!read(header.xfRegsOffset, dataFile->m_XFRegs.data(), size * sizeof(u32)))
+    return panic_failed_to_read();
 
   // Texture memory saving was added in version 4.
   dataFile->m_TexMem.fill(0);
   if (dataFile->m_Version >= 4)
   {
     size = std::min<u32>(TEX_MEM_SIZE, header.texMemSize);
-    file.Seek(header.texMemOffset, File::SeekOrigin::Begin);
-    file.ReadArray(&dataFile->m_TexMem);
+    if (!read(header.texMemOffset, dataFile->m_TexMem.data(), size))
+      return panic_failed_to_read();
   }
 
-  if (!file.IsGood())
-    return panic_failed_to_read();
-
   // idk what else these could be used for, but it'd be a shame to not make them available.
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
+  // Index the frames. Their data is only read when they are played or analyzed.
+  const bool compressed = dataFile->GetFlag(FLAG_IS_COMPRESSED);
+  dataFile->m_loaded_frames.reserve(header.frameCount);
   for (u32 i = 0; i < header.frameCount; ++i)
   {
     u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
     FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
+    if (!read(frameOffset, &srcFrame, sizeof(FileFrameInfo)))
       return panic_failed_to_read();
 
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
-
-    if (!file.IsGood())
+    const u64 updateListSize = u64(srcFrame.numMemoryUpdates) * sizeof(FileMemoryUpdate);
+    if (!IsDataInFile(mapped_file, srcFrame.fifoDataOffset, srcFrame.fifoDataSize, compressed) ||
+        mapped_file.GetSpan(srcFrame.memoryUpdatesOffset, updateListSize).size() != updateListSize)
+    {
       return panic_failed_to_read();
-
-    dataFile->AddFrame(dstFrame);
+    }
+
+    // A memory update that is out of bounds would be played back truncated.
+    for (u32 j = 0; j < srcFrame.numMemoryUpdates; ++j)
+    {
+      const FileMemoryUpdate update =
+          ReadMemoryUpdate(mapped_file, srcFrame.memoryUpdatesOffset, j);
+      if (!IsDataInFile(mapped_file, update.dataOffset, update.dataSize, compressed))
+        return panic_failed_to_read();
+    }
+
+    dataFile->m_loaded_frames.push_back({srcFrame.fifoDataOffset, srcFrame.fifoDataSize,
+                                         srcFrame.fifoStart, srcFrame.fifoEnd,
+                                         srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates});
   }
 
+  dataFile->m_mapped_file = std::move(mapped_file);
   return dataFile;
 }
 
-void FifoDataFile::PadFile(size_t numBytes, File::IOFile& file)
-{
-  for (size_t i = 0; i < numBytes; ++i)
-    fputc(0, file.GetHandle());
-}
-
 void FifoDataFile::SetFlag(u32 flag, bool set)
 {
   if (set)
@@ -364,56 +456,189 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+FifoDataFileWriter::FifoDataFileWriter() = default;
+
+FifoDataFileWriter::~FifoDataFileWriter()
 {
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
+  ZSTD_freeCCtx(m_compress_context);
+}
 
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
+bool FifoDataFileWriter::Open(const std::string& filename, bool compress)
+{
+  ZSTD_freeCCtx(m_compress_context);
+  m_compress_context = compress ? ZSTD_createCCtx() : nullptr;
+  m_frame_list.clear();
+  m_stored_data.clear();
+  m_memory_update_bytes = 0;
+  m_written_memory_update_bytes = 0;
+
+  if (!m_file.Open(filename, "wb"))
+    return false;
 
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+  // Add space for header, which is written once the frames are known
+  const FileHeader header{};
+  return m_file.WriteBytes(&header, sizeof(FileHeader));
+}
 
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = static_cast<u8>(srcUpdate.type);
+bool FifoDataFileWriter::WriteFrame(const FifoFrameInfo& frame)
+{
+  return WriteFrame(GetRecordedFrame(frame, true));
+}
 
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+bool FifoDataFileWriter::WriteFrame(const FifoFrameView& frame)
+{
+  u64 dataOffset;
+  u64 memoryUpdatesOffset;
+  if (!WriteData(frame.fifoData, &dataOffset) ||
+      !WriteMemoryUpdates(frame.memoryUpdates, &memoryUpdatesOffset))
+  {
+    return false;
   }
 
-  return updateListOffset;
+  FileFrameInfo dstFrame{};
+  dstFrame.fifoDataSize = static_cast<u32>(frame.fifoData.size());
+  dstFrame.fifoDataOffset = dataOffset;
+  dstFrame.fifoStart = frame.fifoStart;
+  dstFrame.fifoEnd = frame.fifoEnd;
+  dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
+  dstFrame.numMemoryUpdates = static_cast<u32>(frame.memoryUpdates.size());
+
+  const u8* const frameBytes = reinterpret_cast<const u8*>(&dstFrame);
+  m_frame_list.insert(m_frame_list.end(), frameBytes, frameBytes + sizeof(FileFrameInfo));
+  return true;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+u32 FifoDataFileWriter::GetFrameCount() const
 {
-  memUpdates.resize(numUpdates);
+  return static_cast<u32>(m_frame_list.size() / sizeof(FileFrameInfo));
+}
+
+bool FifoDataFileWriter::Close(const FifoDataFile& file)
+{
+  u64 bpMemOffset = m_file.Tell();
+  m_file.WriteArray(file.m_BPMem);
+
+  u64 cpMemOffset = m_file.Tell();
+  m_file.WriteArray(file.m_CPMem);
 
-  for (u32 i = 0; i < numUpdates; ++i)
+  u64 xfMemOffset = m_file.Tell();
+  m_file.WriteArray(file.m_XFMem);
+
+  u64 xfRegsOffset = m_file.Tell();
+  m_file.WriteArray(file.m_XFRegs);
+
+  u64 texMemOffset = m_file.Tell();
+  m_file.WriteArray(file.m_TexMem);
+
+  u64 frameListOffset = m_file.Tell();
+  m_file.WriteBytes(m_frame_list.data(), m_frame_list.size());
+
+  // Write header
+  FileHeader header{};
+  header.fileId = FILE_ID;
+  header.file_version = VERSION_NUMBER;
+  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
+  if (m_compress_context)
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_COMPRESSION;
+  else if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
+  else
+    header.min_loader_version = MIN_LOADER_VERSION;
+
+  header.bpMemOffset = bpMemOffset;
+  header.bpMemSize = FifoDataFile::BP_MEM_SIZE;
+
+  header.cpMemOffset = cpMemOffset;
+  header.cpMemSize = FifoDataFile::CP_MEM_SIZE;
+
+  header.xfMemOffset = xfMemOffset;
+  header.xfMemSize = FifoDataFile::XF_MEM_SIZE;
+
+  header.xfRegsOffset = xfRegsOffset;
+  header.xfRegsSize = FifoDataFile::XF_REGS_SIZE;
+
+  header.texMemOffset = texMemOffset;
+  header.texMemSize = FifoDataFile::TEX_MEM_SIZE;
+
+  header.frameListOffset = frameListOffset;
+  header.frameCount = GetFrameCount();
+
+  header.flags = file.m_Flags & ~FifoDataFile::FLAG_IS_COMPRESSED;
+  if (m_compress_context)
+    header.flags |= FifoDataFile::FLAG_IS_COMPRESSED;
+
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  header.mem1_size = memory.GetRamSizeReal();
+  header.mem2_size = memory.GetExRamSizeReal();
+
+  m_file.Seek(0, File::SeekOrigin::Begin);
+  m_file.WriteBytes(&header, sizeof(FileHeader));
+
+  return m_file.Close();
+}
+
+bool FifoDataFileWriter::WriteData(std::span<const u8> data, u64* offset)
+{
+  *offset = m_file.Tell();
+
+  if (!m_compress_context)
+    return m_file.WriteBytes(data.data(), data.size());
+
+  m_buffer.resize(ZSTD_compressBound(data.size()));
+  const size_t compressed_size =
+      ZSTD_compressCCtx(m_compress_context, m_buffer.data(), m_buffer.size(), data.data(),
+                        data.size(), ZSTD_CLEVEL_DEFAULT);
+  if (ZSTD_isError(compressed_size))
   {
-    u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    ERROR_LOG_FMT(FIFOPLAYER, "Failed to compress FIFO log data: {}",
+                  ZSTD_getErrorName(compressed_size));
+    return false;
+  }
 
-    MemoryUpdate& dstUpdate = memUpdates[i];
+  return m_file.WriteBytes(m_buffer.data(), compressed_size);
+}
+
+bool FifoDataFileWriter::WriteMemoryUpdates(const std::vector<MemoryUpdateView>& memUpdates,
+                                            u64* updateListOffset)
+{
+  std::vector<FileMemoryUpdate> updateList(memUpdates.size());
+
+  for (size_t i = 0; i < memUpdates.size(); ++i)
+  {
+    const MemoryUpdateView& srcUpdate = memUpdates[i];
+    const u32 dataSize = static_cast<u32>(srcUpdate.data.size());
+    m_memory_update_bytes += dataSize;
+
+    // Games often load the same data again, e.g. when switching between two textures. Such data
+    // is only written once. The CRC makes an undetected collision of the hash practically
+    // impossible.
+    const u64 hash = Common::HashXXH3(srcUpdate.data.data(), srcUpdate.data.size());
+    const u32 crc = Common::ComputeCRC32(srcUpdate.data.data(), srcUpdate.data.size());
+    u64 dataOffset;
+    const auto stored = m_stored_data.find(hash);
+    if (stored != m_stored_data.end() && stored->second.size == dataSize &&
+        stored->second.crc == crc)
+    {
+      dataOffset = stored->second.offset;
+    }
+    else
+    {
+      if (!WriteData(srcUpdate.data, &dataOffset))
+        return false;
+
+      m_stored_data.insert_or_assign(hash, StoredData{dataOffset, dataSize, crc});
+      m_written_memory_update_bytes += dataSize;
+    }
+
+    FileMemoryUpdate& dstUpdate = updateList[i];
+    dstUpdate.dataOffset = dataOffset;
     dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataSize = dataSize;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
-    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
-
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    dstUpdate.type = static_cast<u8>(srcUpdate.type);
   }
+
+  *updateListOffset = m_file.Tell();
+  return m_file.WriteArray(updateList.data(), updateList.size());
 }
@@ -5,16 +5,18 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "VideoCommon/XFMemory.h"
 
-namespace File
-{
-class IOFile;
-}
+struct ZSTD_CCtx_s;
 
 struct MemoryUpdate
 {
@@ -43,6 +45,29 @@ struct FifoFrameInfo
   std::vector<MemoryUpdate> memoryUpdates;
 };
 
+struct MemoryUpdateView
+{
+  u32 fifoPosition = 0;
+  u32 address = 0;
+  std::span<const u8> data;
+  MemoryUpdate::Type type{};
+};
+
+// A frame as returned by FifoDataFile::GetFrame. For uncompressed files, the data points directly
+// into the mapped file; for compressed ones, it points into storage that is kept alive by the view.
+struct FifoFrameView
+{
+  std::span<const u8> fifoData;
+
+  u32 fifoStart = 0;
+  u32 fifoEnd = 0;
+
+  // Sorted by fifoPosition
+  std::vector<MemoryUpdateView> memoryUpdates;
+
+  std::shared_ptr<const std::vector<u8>> storage;
+};
+
 class FifoDataFile
 {
 public:
@@ -73,26 +98,44 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Frames of loaded files are read when they are requested. The memory updates can be skipped
+  // when only the FIFO data is needed, which avoids decompressing them.
+  FifoFrameView GetFrame(u32 frame, bool include_memory_updates = true) const;
+  u32 GetFrameCount() const;
+  // Compresses the FIFO data and memory updates if MAIN_FIFOPLAYER_COMPRESS_RECORDINGS is set.
+  // Uses FifoDataFileWriter, so identical memory updates are only stored once.
   bool Save(const std::string& filename);
 
+  // Maps the file into memory, and only reads the list of frames and checks that their data is
+  // within the file. The file must not be modified while it is loaded.
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
+  friend class FifoDataFileWriter;
+
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    // Each frame's FIFO data and each memory update is stored as a separate zstd frame, so that any
+    // frame can be read without decompressing the ones before it.
+    FLAG_IS_COMPRESSED = 2,
   };
 
-  void PadFile(size_t numBytes, File::IOFile& file);
+  struct LoadedFrame
+  {
+    u64 fifoDataOffset;
+    u32 fifoDataSize;
+    u32 fifoStart;
+    u32 fifoEnd;
+    u64 memoryUpdatesOffset;
+    u32 numMemoryUpdates;
+  };
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  FifoFrameView GetLoadedFrame(const LoadedFrame& frame, bool include_memory_updates) const;
+  FifoFrameView DecompressFrame(const LoadedFrame& frame, bool include_memory_updates) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +148,64 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
+  // Frames added with AddFrame, when recording.
   std::vector<FifoFrameInfo> m_Frames;
+
+  // Frames of a loaded file, which are read from the mapping when they are requested.
+  Common::MappedFile m_mapped_file;
+  std::vector<LoadedFrame> m_loaded_frames;
+
+  // The most recently decompressed frame, as the player and the analyzer request the same frame
+  // several times.
+  mutable std::mutex m_frame_cache_mutex;
+  mutable const LoadedFrame* m_cached_frame = nullptr;
+  mutable FifoFrameView m_cached_frame_view;
+};
+
+// Writes a FIFO log one frame at a time, so that the frames don't need to be kept in memory.
+// Memory updates whose data was already written are stored as references to the earlier copy.
+class FifoDataFileWriter
+{
+public:
+  FifoDataFileWriter();
+  ~FifoDataFileWriter();
+
+  FifoDataFileWriter(const FifoDataFileWriter&) = delete;
+  FifoDataFileWriter& operator=(const FifoDataFileWriter&) = delete;
+
+  bool Open(const std::string& filename, bool compress);
+  bool WriteFrame(const FifoFrameInfo& frame);
+  bool WriteFrame(const FifoFrameView& frame);
+  // Writes the video memory and the flags of the file, followed by the list of frames.
+  bool Close(const FifoDataFile& file);
+
+  u32 GetFrameCount() const;
+  // The size of the data of all memory updates, and of the part of it which had to be written.
+  u64 GetMemoryUpdateBytes() const { return m_memory_update_bytes; }
+  u64 GetWrittenMemoryUpdateBytes() const { return m_written_memory_update_bytes; }
+
+private:
+  struct StoredData
+  {
+    u64 offset;
+    u32 size;
+    u32 crc;
+  };
+
+  bool WriteData(std::span<const u8> data, u64* offset);
+  bool WriteMemoryUpdates(const std::vector<MemoryUpdateView>& memUpdates,
+                          u64* updateListOffset);
+
+  File::IOFile m_file;
+  ZSTD_CCtx_s* m_compress_context = nullptr;
+  std::vector<u8> m_buffer;
+
+  // The FileFrameInfo of each frame, which are written by Close.
+  std::vector<u8> m_frame_list;
+
+  // Memory update data in the file, by its XXH3 hash.
+  std::unordered_map<u64, StoredData> m_stored_data;
+
+  u64 m_memory_update_bytes = 0;
+  u64 m_written_memory_update_bytes = 0;
 };
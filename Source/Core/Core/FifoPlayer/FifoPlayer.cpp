@@ -82,7 +82,7 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
+    const FifoFrameView frame = file->GetFrame(frame_no, false);
     AnalyzedFrameInfo& analyzed = frame_info[frame_no];
 
     u32 offset = 0;
@@ -399,7 +399,7 @@ void FifoPlayer::SetFrameRangeEnd(u32 end)
   }
 }
 
-void FifoPlayer::WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo& info)
+void FifoPlayer::WriteFrame(const FifoFrameView& frame, const AnalyzedFrameInfo& info)
 {
   // Core timing information
   auto& vi = m_system.GetVideoInterface();
@@ -442,7 +442,7 @@ void FifoPlayer::WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo&
 }
 
 void FifoPlayer::WriteFramePart(const FramePart& part, u32* next_mem_update,
-                                const FifoFrameInfo& frame)
+                                const FifoFrameView& frame)
 {
   const u8* const data = frame.fifoData.data();
 
@@ -451,7 +451,7 @@ void FifoPlayer::WriteFramePart(const FramePart& part, u32* next_mem_update,
 
   while (*next_mem_update < frame.memoryUpdates.size() && data_start < data_end)
   {
-    const MemoryUpdate& memUpdate = frame.memoryUpdates[*next_mem_update];
+    const MemoryUpdateView& memUpdate = frame.memoryUpdates[*next_mem_update];
 
     if (memUpdate.fifoPosition < data_end)
     {
@@ -482,7 +482,7 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
+    const FifoFrameView frame = m_File->GetFrame(frameNum);
     for (auto& update : frame.memoryUpdates)
     {
       WriteMemory(update);
@@ -490,17 +490,25 @@ void FifoPlayer::WriteAllMemoryUpdates()
   }
 }
 
-void FifoPlayer::WriteMemory(const MemoryUpdate& memUpdate)
+void FifoPlayer::WriteMemory(const MemoryUpdateView& memUpdate)
 {
   auto& memory = m_system.GetMemory();
   u8* mem = nullptr;
+  u32 address;
 
   if (memUpdate.address & 0x10000000)
+  {
+    address = 0x10000000 | (memUpdate.address & memory.GetExRamMask());
     mem = &memory.GetEXRAM()[memUpdate.address & memory.GetExRamMask()];
+  }
   else
+  {
+    address = memUpdate.address & memory.GetRamMask();
     mem = &memory.GetRAM()[memUpdate.address & memory.GetRamMask()];
+  }
 
   std::copy(memUpdate.data.begin(), memUpdate.data.end(), mem);
+  memory.MarkWritten(address, memUpdate.data.size());
 }
 
 void FifoPlayer::WriteFifo(const u8* data, u32 start, u32 end)
@@ -547,7 +555,7 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameView frame = m_File->GetFrame(m_CurrentFrame);
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
@@ -17,7 +17,7 @@
 #include "VideoCommon/OpcodeDecoding.h"
 
 class FifoDataFile;
-struct MemoryUpdate;
+struct MemoryUpdateView;
 
 namespace Core
 {
@@ -145,11 +145,11 @@ private:
 
   CPU::State AdvanceFrame();
 
-  void WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo& info);
-  void WriteFramePart(const FramePart& part, u32* next_mem_update, const FifoFrameInfo& frame);
+  void WriteFrame(const FifoFrameView& frame, const AnalyzedFrameInfo& info);
+  void WriteFramePart(const FramePart& part, u32* next_mem_update, const FifoFrameView& frame);
 
   void WriteAllMemoryUpdates();
-  void WriteMemory(const MemoryUpdate& memUpdate);
+  void WriteMemory(const MemoryUpdateView& memUpdate);
 
   // writes a range of data to the fifo
   // start and end must be relative to frame's fifo data so elapsed cycles are figured correctly
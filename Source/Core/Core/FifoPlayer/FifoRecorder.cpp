@@ -6,10 +6,15 @@
 #include <algorithm>
 #include <cstring>
 
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Random.h"
 #include "Common/Thread.h"
 
+#include "Core/Core.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
@@ -68,7 +73,7 @@ void FifoRecorder::FifoRecordAnalyzer::OnIndexedLoad(CPArray array, u32 index, u
 {
   const u32 load_address = m_cpmem.array_bases[array] + m_cpmem.array_strides[array] * index;
 
-  m_owner->UseMemory(load_address, size * sizeof(u32), MemoryUpdate::Type::XFData);
+  m_owner->RecordMemory(load_address, size * sizeof(u32), MemoryUpdate::Type::XFData, false);
 }
 
 // TODO: The following code is copied with modifications from VertexLoaderBase.
@@ -209,20 +214,50 @@ void FifoRecorder::FifoRecordAnalyzer::ProcessVertexComponent(
   const u32 array_start = m_cpmem.array_bases[array_index] + byte_offset;
   const u32 array_size = m_cpmem.array_strides[array_index] * max_index + component_size;
 
-  m_owner->UseMemory(array_start, array_size, MemoryUpdate::Type::VertexStream);
+  m_owner->RecordMemory(array_start, array_size, MemoryUpdate::Type::VertexStream, false);
 }
 
 FifoRecorder::FifoRecorder(Core::System& system) : m_system(system)
 {
 }
 
-FifoRecorder::~FifoRecorder() = default;
+FifoRecorder::~FifoRecorder()
+{
+  m_write_thread.Shutdown(true);
+
+  // The file is only needed until it is saved.
+  if (!m_recording_path.empty())
+  {
+    m_File.reset();
+    File::Delete(m_recording_path, File::IfAbsentBehavior::NoConsoleWarning);
+  }
+}
 
 void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 {
+  // Finishes writing an earlier recording. This must not hold the lock, as writing does too.
+  m_write_thread.Reset("FIFO Recorder", [this](std::optional<FifoFrameInfo> frame) {
+    WriteFrame(std::move(frame));
+  });
+
   std::lock_guard lk(m_mutex);
 
+  // The file of the previous recording is mapped by m_File, so it is closed before deleting it.
   m_File = std::make_unique<FifoDataFile>();
+  if (!m_recording_path.empty())
+    File::Delete(m_recording_path, File::IfAbsentBehavior::NoConsoleWarning);
+
+  m_file_written = false;
+  m_finish_queued = false;
+  m_statistics = {};
+  m_frame_overhead = {};
+
+  // Each recording gets its own file, so that several instances of Dolphin can record at once.
+  m_recording_path = fmt::format("{}FifoRecording-{:016x}.dff", File::GetUserPath(D_CACHE_IDX),
+                                 Common::Random::GenerateValue<u64>());
+  m_write_failed = !m_writer.Open(m_recording_path, false);
+  if (m_write_failed)
+    PanicAlertFmtT("Failed to open \"{0}\" for recording the FIFO log.", m_recording_path);
 
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
@@ -298,11 +333,19 @@ void FifoRecorder::StopRecording()
 {
   std::lock_guard lk(m_mutex);
   m_RequestedRecordingEnd = true;
+
+  // Without emulation, no more frames will end, so finish with the frames recorded so far.
+  if (m_WasRecording && !m_finish_queued && !Core::IsRunning(m_system))
+  {
+    m_IsRecording = false;
+    m_finish_queued = true;
+    m_write_thread.Push(std::nullopt);
+  }
 }
 
 bool FifoRecorder::IsRecordingDone() const
 {
-  return m_WasRecording && m_File != nullptr;
+  return m_WasRecording && m_file_written && !m_write_failed;
 }
 
 FifoDataFile* FifoRecorder::GetRecordedFile() const
@@ -310,8 +353,66 @@ FifoDataFile* FifoRecorder::GetRecordedFile() const
   return m_File.get();
 }
 
+FifoRecorder::Statistics FifoRecorder::GetStatistics() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_statistics;
+}
+
+void FifoRecorder::WriteFrame(std::optional<FifoFrameInfo> frame)
+{
+  if (frame)
+  {
+    if (!m_write_failed && !m_writer.WriteFrame(*frame))
+    {
+      PanicAlertFmtT("Failed to write the FIFO log to \"{0}\".", m_recording_path);
+      m_write_failed = true;
+    }
+
+    std::lock_guard lk(m_mutex);
+    m_statistics.written_memory_update_bytes = m_writer.GetWrittenMemoryUpdateBytes();
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_mutex);
+    if (!m_write_failed && !m_writer.Close(*m_File))
+    {
+      PanicAlertFmtT("Failed to write the FIFO log to \"{0}\".", m_recording_path);
+      m_write_failed = true;
+    }
+
+    INFO_LOG_FMT(FIFOPLAYER,
+                 "FifoRecorder: Recorded {} frames, {} FIFO bytes, {} of {} memory update bytes "
+                 "written, {} us recording overhead per frame (max {} us)",
+                 m_statistics.frames, m_statistics.fifo_bytes,
+                 m_statistics.written_memory_update_bytes, m_statistics.memory_update_bytes,
+                 m_statistics.total_overhead.count() / std::max<u32>(m_statistics.frames, 1),
+                 m_statistics.max_frame_overhead.count());
+  }
+
+  // The frames are read from the file from now on.
+  std::unique_ptr<FifoDataFile> file;
+  if (!m_write_failed)
+    file = FifoDataFile::Load(m_recording_path, false);
+
+  // Every failure was already reported to the user. The recorded frames are lost then, as they
+  // were only kept in the file.
+  std::lock_guard lk(m_mutex);
+  if (file)
+    m_File = std::move(file);
+  else
+    m_write_failed = true;
+  m_file_written = true;
+
+  if (m_FinishedCb)
+    m_FinishedCb();
+}
+
 void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 {
+  const auto start = std::chrono::steady_clock::now();
+
   if (!m_SkipNextData)
   {
     // Assumes data contains all information for the command
@@ -333,28 +434,57 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 
   if (m_FrameEnded && !m_FifoData.empty())
   {
-    m_CurrentFrame.fifoData = m_FifoData;
+    const size_t fifo_size = m_FifoData.size();
+    u64 memory_update_bytes = 0;
+    for (const MemoryUpdate& update : m_CurrentFrame.memoryUpdates)
+      memory_update_bytes += update.data.size();
+
+    // The frame is handed to the write thread without copying it.
+    m_CurrentFrame.fifoData = std::move(m_FifoData);
+    m_FifoData = {};
+    m_FifoData.reserve(fifo_size);
 
     {
       std::lock_guard lk(m_mutex);
 
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
+      m_write_thread.Push(std::move(m_CurrentFrame));
+      if (m_RequestedRecordingEnd && !m_finish_queued)
+      {
+        m_finish_queued = true;
+        m_write_thread.Push(std::nullopt);
+      }
 
-      if (m_FinishedCb && m_RequestedRecordingEnd)
-        m_FinishedCb();
+      m_frame_overhead += std::chrono::steady_clock::now() - start;
+      const auto overhead = std::chrono::duration_cast<std::chrono::microseconds>(m_frame_overhead);
+      m_statistics.frames++;
+      m_statistics.fifo_bytes += fifo_size;
+      m_statistics.memory_update_bytes += memory_update_bytes;
+      m_statistics.last_frame_overhead = overhead;
+      m_statistics.max_frame_overhead = std::max(m_statistics.max_frame_overhead, overhead);
+      m_statistics.total_overhead += overhead;
     }
 
-    m_CurrentFrame.memoryUpdates.clear();
-    m_FifoData.clear();
+    m_CurrentFrame = {};
+    m_frame_overhead = {};
     m_FrameEnded = false;
   }
+  else
+  {
+    m_frame_overhead += std::chrono::steady_clock::now() - start;
+  }
 
   m_SkipNextData = m_SkipFutureData;
 }
 
 void FifoRecorder::UseMemory(u32 address, u32 size, MemoryUpdate::Type type, bool dynamicUpdate)
+{
+  const auto start = std::chrono::steady_clock::now();
+  RecordMemory(address, size, type, dynamicUpdate);
+  m_frame_overhead += std::chrono::steady_clock::now() - start;
+}
+
+void FifoRecorder::RecordMemory(u32 address, u32 size, MemoryUpdate::Type type,
+                                bool dynamicUpdate)
 {
   auto& memory = m_system.GetMemory();
 
@@ -3,13 +3,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/HookableEvent.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 namespace Core
@@ -22,6 +27,19 @@ class FifoRecorder
 public:
   using CallbackFunc = std::function<void()>;
 
+  struct Statistics
+  {
+    u32 frames = 0;
+    u64 fifo_bytes = 0;
+    u64 memory_update_bytes = 0;
+    // The part of the memory update data which wasn't a copy of data that was already recorded.
+    u64 written_memory_update_bytes = 0;
+    // Time the video thread spent on recording, as opposed to emulating.
+    std::chrono::microseconds last_frame_overhead{};
+    std::chrono::microseconds max_frame_overhead{};
+    std::chrono::microseconds total_overhead{};
+  };
+
   explicit FifoRecorder(Core::System& system);
   FifoRecorder(const FifoRecorder&) = delete;
   FifoRecorder(FifoRecorder&&) = delete;
@@ -29,12 +47,17 @@ public:
   FifoRecorder& operator=(FifoRecorder&&) = delete;
   ~FifoRecorder();
 
+  // finishedCb is called on the thread that writes the frames, once the file was written or
+  // writing it failed. It must not call back into the recorder, and should hand its work over to
+  // the thread which started the recording.
   void StartRecording(s32 numFrames, CallbackFunc finishedCb);
   void StopRecording();
 
+  // True once all frames were written and the file can be saved. Stays false if writing failed.
   bool IsRecordingDone() const;
 
   FifoDataFile* GetRecordedFile() const;
+  Statistics GetStatistics() const;
   // Called from video thread
 
   // Must write one full GP command at a time
@@ -61,10 +84,14 @@ private:
   class FifoRecordAnalyzer;
 
   void RecordInitialVideoMemory();
+  void RecordMemory(u32 address, u32 size, MemoryUpdate::Type type, bool dynamicUpdate);
+
+  // Called on the write thread. Writes the frame, or finishes the file if there is none.
+  void WriteFrame(std::optional<FifoFrameInfo> frame);
 
   // Accessed from both GUI and video threads
 
-  std::recursive_mutex m_mutex;
+  mutable std::recursive_mutex m_mutex;
   // True if video thread should send data
   bool m_IsRecording = false;
   // True if m_IsRecording was true during last frame
@@ -72,7 +99,12 @@ private:
   bool m_RequestedRecordingEnd = false;
   s32 m_RecordFramesRemaining = 0;
   CallbackFunc m_FinishedCb;
+  // Holds the video memory while recording. Replaced by the written file once it is done.
   std::unique_ptr<FifoDataFile> m_File;
+  // Set by the write thread once it is done with the recording, whether or not that succeeded.
+  std::atomic<bool> m_file_written = false;
+  bool m_finish_queued = false;
+  Statistics m_statistics;
 
   // Accessed only from video thread
 
@@ -84,8 +116,20 @@ private:
   std::vector<u8> m_FifoData;
   std::vector<u8> m_Ram;
   std::vector<u8> m_ExRam;
+  std::chrono::steady_clock::duration m_frame_overhead{};
 
   Common::EventHook m_end_of_frame_event;
 
   Core::System& m_system;
+
+  // Accessed from the write thread, and by StartRecording while it is idle. m_write_failed is also
+  // read by IsRecordingDone once the write thread is done.
+
+  // Frames are written to this file as they are recorded, instead of being kept in memory.
+  std::string m_recording_path;
+  FifoDataFileWriter m_writer;
+  bool m_write_failed = false;
+
+  // Declared last, so that it is shut down before the members it uses are destroyed.
+  Common::WorkQueueThread<std::optional<FifoFrameInfo>> m_write_thread;
 };
@@ -527,27 +527,29 @@ void DSPManager::Do_ARAM_DMA()
 
     if (m_aram_dma.ARAddr < m_aram.size)
     {
+      const auto write_aram = [this, &memory](u32 address) {
+        *(u64*)&m_aram.ptr[address & m_aram.mask] =
+            Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
+        // On Wii, ARAM is EXRAM, which the texture cache may be watching for writes.
+        if (m_aram.wii_mode)
+          memory.MarkWritten(0x10000000 | (address & m_aram.mask), sizeof(u64));
+      };
+
       while (m_aram_dma.Cnt.count)
       {
         if ((m_aram_info.Hex & 0xf) == 3)
         {
-          *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
-              Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
+          write_aram(m_aram_dma.ARAddr);
         }
         else if ((m_aram_info.Hex & 0xf) == 4)
         {
           if (m_aram_dma.ARAddr < 0x400000)
-          {
-            *(u64*)&m_aram.ptr[(m_aram_dma.ARAddr + 0x400000) & m_aram.mask] =
-                Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
-          }
-          *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
-              Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
+            write_aram(m_aram_dma.ARAddr + 0x400000);
+          write_aram(m_aram_dma.ARAddr);
         }
         else
         {
-          *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
-              Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
+          write_aram(m_aram_dma.ARAddr);
         }
 
         m_aram_dma.MMAddr += 8;
@@ -596,6 +598,8 @@ void DSPManager::WriteARAM(u8 value, u32 address)
 {
   // TODO: verify this on Wii
   m_aram.ptr[address & m_aram.mask] = value;
+  if (m_aram.wii_mode)
+    m_system.GetMemory().MarkWritten(0x10000000 | (address & m_aram.mask), sizeof(u8));
 }
 
 u8* DSPManager::GetARAMPtr() const
@@ -477,6 +477,7 @@ void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
     for (auto& buffer : buffers)
       for (u32 j = 0; j < 5 * 32; ++j)
         *ptr++ = Common::swap32(buffer[j]);
+    HLEMemory_MarkWritten(memory, write_addr, 3 * 5 * 32 * sizeof(int));
   }
 
   // Then, we read the new temp from the CPU and add to our current
@@ -500,8 +501,9 @@ void AXUCode::UploadLRS(u32 dst_addr)
     buffers[1][i] = Common::swap32(m_samples_main_right[i]);
     buffers[2][i] = Common::swap32(m_samples_main_surround[i]);
   }
-  memcpy(HLEMemory_Get_Pointer(m_dsphle->GetSystem().GetMemory(), dst_addr), buffers,
-         sizeof(buffers));
+  auto& memory = m_dsphle->GetSystem().GetMemory();
+  memcpy(HLEMemory_Get_Pointer(memory, dst_addr), buffers, sizeof(buffers));
+  HLEMemory_MarkWritten(memory, dst_addr, sizeof(buffers));
 }
 
 void AXUCode::SetMainLR(u32 src_addr)
@@ -571,6 +573,7 @@ void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
     surround_buffer[i] = Common::swap32(m_samples_main_surround[i]);
   auto& memory = m_dsphle->GetSystem().GetMemory();
   memcpy(HLEMemory_Get_Pointer(memory, surround_addr), surround_buffer, sizeof(surround_buffer));
+  HLEMemory_MarkWritten(memory, surround_addr, sizeof(surround_buffer));
 
   // 32 samples per ms, 5 ms, 2 channels
   short buffer[5 * 32 * 2];
@@ -586,6 +589,7 @@ void AXUCode::OutputSamples(u32 lr_addr, u32 surround_addr)
   }
 
   memcpy(HLEMemory_Get_Pointer(memory, lr_addr), buffer, sizeof(buffer));
+  HLEMemory_MarkWritten(memory, lr_addr, sizeof(buffer));
 }
 
 void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
@@ -597,6 +601,7 @@ void AXUCode::MixAUXBLR(u32 ul_addr, u32 dl_addr)
     *ptr++ = Common::swap32(sample);
   for (auto& sample : m_samples_auxB_right)
     *ptr++ = Common::swap32(sample);
+  HLEMemory_MarkWritten(memory, ul_addr, 2 * 5 * 32 * sizeof(int));
 
   // Mix AUXB L/R to MAIN L/R, and replace AUXB L/R
   ptr = (int*)HLEMemory_Get_Pointer(memory, dl_addr);
@@ -645,11 +650,13 @@ void AXUCode::SendAUXAndMix(u32 auxa_lrs_up, u32 auxb_s_up, u32 main_l_dl, u32 m
     for (u32 j = 0; j < 32 * 5; ++j)
       *ptr++ = Common::swap32(up_buffer[j]);
   }
+  HLEMemory_MarkWritten(memory, auxa_lrs_up, 3 * 32 * 5 * sizeof(int));
 
   // Upload AUXB S
   ptr = (int*)HLEMemory_Get_Pointer(memory, auxb_s_up);
   for (auto& sample : m_samples_auxB_surround)
     *ptr++ = Common::swap32(sample);
+  HLEMemory_MarkWritten(memory, auxb_s_up, sizeof(m_samples_auxB_surround));
 
   // Download buffers and addresses
   const std::array<int*, 4> dl_buffers{
@@ -520,6 +520,7 @@ void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 vo
       for (u32 j = 0; j < 3 * 32; ++j)
         *ptr++ = Common::swap32(buffer[j]);
     }
+    HLEMemory_MarkWritten(memory, write_addr, 3 * 3 * 32 * sizeof(int));
   }
 
   // Then read the buffers from the CPU and add to our main buffers.
@@ -550,10 +551,12 @@ void AXWiiUCode::UploadAUXMixLRSC(int aux_id, u32* addresses, u16 volume)
     *upload_ptr++ = Common::swap32(aux_right[i]);
   for (u32 i = 0; i < 96; ++i)
     *upload_ptr++ = Common::swap32(aux_surround[i]);
+  HLEMemory_MarkWritten(memory, addresses[0], 3 * 96 * sizeof(int));
 
   upload_ptr = (int*)HLEMemory_Get_Pointer(memory, addresses[1]);
   for (u32 i = 0; i < 96; ++i)
     *upload_ptr++ = Common::swap32(auxc_buffer[i]);
+  HLEMemory_MarkWritten(memory, addresses[1], 96 * sizeof(int));
 
   u16 volume_ramp[96];
   GenerateVolumeRamp(volume_ramp, m_last_aux_volumes[aux_id], volume, 96);
@@ -588,6 +591,7 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
     upload_buffer[i] = Common::swap32(m_samples_main_surround[i]);
   auto& memory = m_dsphle->GetSystem().GetMemory();
   memcpy(HLEMemory_Get_Pointer(memory, surround_addr), upload_buffer.data(), sizeof(upload_buffer));
+  HLEMemory_MarkWritten(memory, surround_addr, sizeof(upload_buffer));
 
   if (upload_auxc)
   {
@@ -596,6 +600,7 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
       upload_buffer[i] = Common::swap32(m_samples_auxC_left[i]);
     memcpy(HLEMemory_Get_Pointer(memory, surround_addr), upload_buffer.data(),
            sizeof(upload_buffer));
+    HLEMemory_MarkWritten(memory, surround_addr, sizeof(upload_buffer));
   }
 
   // Clamp internal buffers to 16 bits.
@@ -620,6 +625,7 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
   }
 
   memcpy(HLEMemory_Get_Pointer(memory, lr_addr), buffer.data(), sizeof(buffer));
+  HLEMemory_MarkWritten(memory, lr_addr, sizeof(buffer));
   m_mail_handler.PushMail(DSP_SYNC, true);
 }
 
@@ -637,6 +643,7 @@ void AXWiiUCode::OutputWMSamples(u32* addresses)
       int sample = std::clamp(in[j], -32767, 32767);
       out[j] = Common::swap16((u16)sample);
     }
+    HLEMemory_MarkWritten(memory, addresses[i], 3 * 6 * sizeof(u16));
   }
 }
 
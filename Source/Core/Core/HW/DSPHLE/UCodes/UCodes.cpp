@@ -39,6 +39,14 @@ constexpr bool ExramRead(u32 address)
   return (address & 0x10000000) != 0;
 }
 
+void HLEMemory_MarkWritten(Memory::MemoryManager& memory, u32 address, u32 size)
+{
+  if (ExramRead(address))
+    memory.MarkWritten(0x10000000 | (address & memory.GetExRamMask()), size);
+  else
+    memory.MarkWritten(address & memory.GetRamMask(), size);
+}
+
 u8 HLEMemory_Read_U8(Memory::MemoryManager& memory, u32 address)
 {
   if (ExramRead(address))
@@ -53,6 +61,7 @@ void HLEMemory_Write_U8(Memory::MemoryManager& memory, u32 address, u8 value)
     memory.GetEXRAM()[address & memory.GetExRamMask()] = value;
   else
     memory.GetRAM()[address & memory.GetRamMask()] = value;
+  HLEMemory_MarkWritten(memory, address, sizeof(u8));
 }
 
 u16 HLEMemory_Read_U16LE(Memory::MemoryManager& memory, u32 address)
@@ -78,6 +87,7 @@ void HLEMemory_Write_U16LE(Memory::MemoryManager& memory, u32 address, u16 value
     std::memcpy(&memory.GetEXRAM()[address & memory.GetExRamMask()], &value, sizeof(u16));
   else
     std::memcpy(&memory.GetRAM()[address & memory.GetRamMask()], &value, sizeof(u16));
+  HLEMemory_MarkWritten(memory, address, sizeof(u16));
 }
 
 void HLEMemory_Write_U16(Memory::MemoryManager& memory, u32 address, u16 value)
@@ -108,6 +118,7 @@ void HLEMemory_Write_U32LE(Memory::MemoryManager& memory, u32 address, u32 value
     std::memcpy(&memory.GetEXRAM()[address & memory.GetExRamMask()], &value, sizeof(u32));
   else
     std::memcpy(&memory.GetRAM()[address & memory.GetRamMask()], &value, sizeof(u32));
+  HLEMemory_MarkWritten(memory, address, sizeof(u32));
 }
 
 void HLEMemory_Write_U32(Memory::MemoryManager& memory, u32 address, u32 value)
@@ -39,6 +39,8 @@ void HLEMemory_Write_U32LE(Memory::MemoryManager& memory, u32 address, u32 value
 void HLEMemory_Write_U32(Memory::MemoryManager& memory, u32 address, u32 value);
 
 void* HLEMemory_Get_Pointer(Memory::MemoryManager& memory, u32 address);
+// Must be called after writing to memory through HLEMemory_Get_Pointer.
+void HLEMemory_MarkWritten(Memory::MemoryManager& memory, u32 address, u32 size);
 
 class UCodeInterface
 {
@@ -15,6 +15,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/TraceRecorder.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -66,6 +67,7 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
       std::unique_lock dsp_thread_lock(dsp_lle->m_dsp_thread_mutex, std::try_to_lock);
       if (dsp_thread_lock)
       {
+        TRACE_ZONE("DSPLLE::RunCycles");
         if (dsp_lle->m_dsp_core.IsJITCreated())
         {
           dsp_lle->m_dsp_core.RunCycles(cycles);
@@ -196,6 +196,7 @@ void CEXIModem::DMARead(u32 addr, u32 size)
   {
     auto& memory = m_system.GetMemory();
     HandleReadModemTransfer(memory.GetPointerForRange(addr, size), size);
+    memory.MarkWritten(addr, size);
   }
 }
 
@@ -19,6 +19,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -152,6 +153,7 @@ void MemoryManager::Init()
   m_logical_page_mappings_base = reinterpret_cast<u8*>(m_logical_page_mappings.data());
 
   InitMMIO(wii);
+  InitWriteTracking();
 
   Clear();
 
@@ -201,6 +203,8 @@ bool MemoryManager::InitFastmemArena()
   constexpr size_t guard_size = 0x8000'0000;
   constexpr size_t memory_size = ppc_view_size * 2 + guard_size * 3;
 
+  std::lock_guard lk(m_write_tracking_lock);
+
   m_fastmem_arena = m_arena.ReserveMemoryRegion(memory_size);
   if (!m_fastmem_arena)
   {
@@ -230,11 +234,17 @@ bool MemoryManager::InitFastmemArena()
 
   m_is_fastmem_arena_initialized = true;
   m_fastmem_arena_size = memory_size;
+
+  // The new mappings aren't write-protected.
+  InvalidateWriteTracking();
+
   return true;
 }
 
 void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  std::lock_guard lk(m_write_tracking_lock);
+
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -279,7 +289,7 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                   intersection_start, mapped_size, logical_address);
               exit(0);
             }
-            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
           }
 
           m_logical_page_mappings[i] =
@@ -288,6 +298,10 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
       }
     }
   }
+
+  // Carry the write protection of tracked pages over to the new logical mappings.
+  ForEachProtectedRun(
+      [this](u32 first_page, u32 last_page) { SetWriteProtection(first_page, last_page, true); });
 }
 
 void MemoryManager::DoState(PointerWrap& p)
@@ -337,6 +351,12 @@ void MemoryManager::DoState(PointerWrap& p)
   if (current_have_exram)
     p.DoArray(m_exram, current_exram_size);
   p.DoMarker("Memory EXRAM");
+
+  if (p.IsReadMode())
+  {
+    std::lock_guard lk(m_write_tracking_lock);
+    InvalidateWriteTracking();
+  }
 }
 
 void MemoryManager::Shutdown()
@@ -359,9 +379,13 @@ void MemoryManager::Shutdown()
 
 void MemoryManager::ShutdownFastmemArena()
 {
+  std::lock_guard lk(m_write_tracking_lock);
+
   if (!m_is_fastmem_arena_initialized)
     return;
 
+  InvalidateWriteTracking();
+
   for (const PhysicalMemoryRegion& region : m_physical_regions)
   {
     if (!region.active)
@@ -397,6 +421,9 @@ void MemoryManager::Clear()
     memset(m_fake_vmem, 0, GetFakeVMemSize());
   if (m_exram)
     memset(m_exram, 0, GetExRamSize());
+
+  std::lock_guard lk(m_write_tracking_lock);
+  InvalidateWriteTracking();
 }
 
 u8* MemoryManager::GetPointerForRange(u32 address, size_t size) const
@@ -446,6 +473,7 @@ void MemoryManager::CopyToEmu(u32 address, const void* data, size_t size)
     return;
   }
   memcpy(pointer, data, size);
+  MarkWritten(address, size);
 }
 
 void MemoryManager::Memset(u32 address, u8 value, size_t size)
@@ -460,6 +488,7 @@ void MemoryManager::Memset(u32 address, u8 value, size_t size)
     return;
   }
   memset(pointer, value, size);
+  MarkWritten(address, size);
 }
 
 std::string MemoryManager::GetString(u32 em_address, size_t size)
@@ -573,4 +602,274 @@ void MemoryManager::Write_U64_Swap(u64 value, u32 address)
   CopyToEmu(address, &value, sizeof(value));
 }
 
+void MemoryManager::InitWriteTracking()
+{
+  m_write_tracking_enabled = false;
+  m_write_tracking_page_shift = std::max(12, MathUtil::IntLog2(Common::GetPageSize()));
+  m_write_tracking_mem1_pages = GetRamSize() >> m_write_tracking_page_shift;
+  m_write_tracking_pages = m_write_tracking_mem1_pages;
+  if (m_exram)
+    m_write_tracking_pages += GetExRamSize() >> m_write_tracking_page_shift;
+
+  m_page_last_write = std::make_unique<std::atomic<u64>[]>(m_write_tracking_pages);
+  m_page_protection = std::make_unique<std::atomic<PageProtection>[]>(m_write_tracking_pages);
+  m_write_count = 0;
+  m_all_written_count = 0;
+}
+
+std::optional<u32> MemoryManager::GetWriteTrackingPage(u32 physical_address) const
+{
+  if (!m_page_last_write)
+    return std::nullopt;
+
+  if (physical_address < GetRamSize())
+    return physical_address >> m_write_tracking_page_shift;
+
+  if (m_exram && physical_address >= 0x10000000 && physical_address - 0x10000000 < GetExRamSize())
+  {
+    return m_write_tracking_mem1_pages +
+           ((physical_address - 0x10000000) >> m_write_tracking_page_shift);
+  }
+
+  return std::nullopt;
+}
+
+u32 MemoryManager::GetWriteTrackingPageAddress(u32 page) const
+{
+  if (page < m_write_tracking_mem1_pages)
+    return page << m_write_tracking_page_shift;
+
+  return 0x10000000 + ((page - m_write_tracking_mem1_pages) << m_write_tracking_page_shift);
+}
+
+void MemoryManager::SetWriteProtection(u32 first_page, u32 last_page, bool write_protected)
+{
+  // Without the fastmem arena, all CPU stores go through MMU.cpp, which calls MarkWritten.
+  if (!m_is_fastmem_arena_initialized)
+    return;
+
+  const auto set_protection = [write_protected](u8* pointer, u32 size) {
+    if (write_protected)
+      Common::WriteProtectMemory(pointer, size);
+    else
+      Common::UnWriteProtectMemory(pointer, size);
+  };
+
+  const u32 start = GetWriteTrackingPageAddress(first_page);
+  const u32 end = GetWriteTrackingPageAddress(last_page) + (1u << m_write_tracking_page_shift);
+  set_protection(m_physical_base + start, end - start);
+
+  for (const LogicalMemoryView& view : m_logical_mapped_entries)
+  {
+    const u32 view_start = std::max(start, view.physical_address);
+    const u32 view_end = std::min(end, view.physical_address + view.mapped_size);
+    if (view_start < view_end)
+    {
+      set_protection(static_cast<u8*>(view.mapped_pointer) + (view_start - view.physical_address),
+                     view_end - view_start);
+    }
+  }
+}
+
+void MemoryManager::ForEachProtectedRun(const std::function<void(u32, u32)>& function) const
+{
+  const auto is_protected = [this](u32 page) {
+    return m_page_protection[page].load(std::memory_order_acquire) == PageProtection::Protected;
+  };
+
+  for (u32 first_page = 0; first_page < m_write_tracking_pages;)
+  {
+    if (!is_protected(first_page))
+    {
+      first_page++;
+      continue;
+    }
+
+    // MEM1 and EXRAM aren't contiguous, so runs must not cross from one into the other.
+    const u32 region_end = first_page < m_write_tracking_mem1_pages ? m_write_tracking_mem1_pages :
+                                                                      m_write_tracking_pages;
+    u32 last_page = first_page;
+    while (last_page + 1 < region_end && is_protected(last_page + 1))
+      last_page++;
+    function(first_page, last_page);
+    first_page = last_page + 1;
+  }
+}
+
+void MemoryManager::UnprotectAllPages()
+{
+  const auto try_take = [this](u32 page) {
+    PageProtection expected = PageProtection::Protected;
+    return m_page_protection[page].compare_exchange_strong(expected, PageProtection::Unprotecting,
+                                                           std::memory_order_acq_rel);
+  };
+
+  for (u32 first_page = 0; first_page < m_write_tracking_pages;)
+  {
+    // Pages which the fault handler is unprotecting right now are left to it.
+    if (!try_take(first_page))
+    {
+      first_page++;
+      continue;
+    }
+
+    const u32 region_end = first_page < m_write_tracking_mem1_pages ? m_write_tracking_mem1_pages :
+                                                                      m_write_tracking_pages;
+    u32 last_page = first_page;
+    while (last_page + 1 < region_end && try_take(last_page + 1))
+      last_page++;
+    SetWriteProtection(first_page, last_page, false);
+    for (u32 page = first_page; page <= last_page; page++)
+      m_page_protection[page].store(PageProtection::Unprotected, std::memory_order_release);
+    first_page = last_page + 1;
+  }
+}
+
+void MemoryManager::InvalidateWriteTracking()
+{
+  UnprotectAllPages();
+  m_all_written_count = ++m_write_count;
+}
+
+void MemoryManager::SetWriteTrackingEnabled(bool enabled)
+{
+  std::lock_guard lk(m_write_tracking_lock);
+  if (enabled == m_write_tracking_enabled)
+    return;
+
+  // Nothing was recorded while tracking was disabled, so treat everything as written.
+  InvalidateWriteTracking();
+  m_write_tracking_enabled = enabled;
+}
+
+u64 MemoryManager::TrackWrites(u32 address, u32 size)
+{
+  address &= 0x3FFFFFFF;
+  const std::optional<u32> first_page = GetWriteTrackingPage(address);
+  const std::optional<u32> last_page = GetWriteTrackingPage(address + std::max(size, 1u) - 1);
+
+  std::lock_guard lk(m_write_tracking_lock);
+
+  // Taken before protecting anything. A store which the fault handler let through before the
+  // pages are protected again is either seen by the caller, or has counted as a write after it.
+  const u64 token = m_write_count.load();
+
+  if (first_page && last_page)
+  {
+    const auto is_unprotected = [this](u32 page) {
+      // The fault handler finishes unprotecting the page without waiting on anything.
+      PageProtection state;
+      while ((state = m_page_protection[page].load(std::memory_order_acquire)) ==
+             PageProtection::Unprotecting)
+      {
+      }
+      return state == PageProtection::Unprotected;
+    };
+
+    // Protect the pages that aren't protected yet, batching neighbouring ones. The fault handler
+    // leaves unprotected pages alone, so nothing else can change their state here.
+    for (u32 page = *first_page; page <= *last_page;)
+    {
+      if (!is_unprotected(page))
+      {
+        page++;
+        continue;
+      }
+
+      const u32 run_start = page;
+      while (page <= *last_page && is_unprotected(page))
+        m_page_protection[page++].store(PageProtection::Protecting, std::memory_order_relaxed);
+      SetWriteProtection(run_start, page - 1, true);
+      for (u32 i = run_start; i < page; i++)
+        m_page_protection[i].store(PageProtection::Protected, std::memory_order_release);
+    }
+  }
+
+  return token;
+}
+
+bool MemoryManager::WasWrittenSince(u32 address, u32 size, u64 token) const
+{
+  if (!IsWriteTrackingEnabled() || token < m_all_written_count.load())
+    return true;
+
+  address &= 0x3FFFFFFF;
+  const std::optional<u32> first_page = GetWriteTrackingPage(address);
+  const std::optional<u32> last_page = GetWriteTrackingPage(address + std::max(size, 1u) - 1);
+  if (!first_page || !last_page)
+    return true;
+
+  for (u32 page = *first_page; page <= *last_page; page++)
+  {
+    if (m_page_last_write[page].load(std::memory_order_acquire) > token)
+      return true;
+  }
+  return false;
+}
+
+void MemoryManager::MarkWritten(u32 address, size_t size)
+{
+  if (!IsWriteTrackingEnabled() || size == 0)
+    return;
+
+  address &= 0x3FFFFFFF;
+  const std::optional<u32> first_page = GetWriteTrackingPage(address);
+  const std::optional<u32> last_page =
+      GetWriteTrackingPage(address + static_cast<u32>(size - 1));
+  if (!first_page || !last_page)
+    return;
+
+  // The data must already be written at this point, see TrackWrites.
+  const u64 write_count = ++m_write_count;
+  for (u32 page = *first_page; page <= *last_page; page++)
+    m_page_last_write[page].store(write_count, std::memory_order_release);
+}
+
+bool MemoryManager::HandleWriteTrackingFault(uintptr_t fault_address)
+{
+  // The fastmem mappings only change on the CPU thread, which is the one that faulted.
+  if (!m_page_protection || !m_is_fastmem_arena_initialized)
+    return false;
+
+  const u8* const pointer = reinterpret_cast<const u8*>(fault_address);
+  std::optional<u32> physical_address;
+  if (pointer >= m_physical_base && pointer < m_physical_base + 0x1'0000'0000)
+  {
+    physical_address = static_cast<u32>(pointer - m_physical_base);
+  }
+  else
+  {
+    for (const LogicalMemoryView& view : m_logical_mapped_entries)
+    {
+      const u8* const view_pointer = static_cast<const u8*>(view.mapped_pointer);
+      if (pointer >= view_pointer && pointer < view_pointer + view.mapped_size)
+      {
+        physical_address = view.physical_address + static_cast<u32>(pointer - view_pointer);
+        break;
+      }
+    }
+  }
+  if (!physical_address)
+    return false;
+
+  const std::optional<u32> page = GetWriteTrackingPage(*physical_address);
+  if (!page)
+    return false;
+
+  PageProtection state = PageProtection::Protected;
+  if (m_page_protection[*page].compare_exchange_strong(state, PageProtection::Unprotecting,
+                                                       std::memory_order_acq_rel))
+  {
+    SetWriteProtection(*page, *page, false);
+    m_page_last_write[*page].store(++m_write_count, std::memory_order_release);
+    m_page_protection[*page].store(PageProtection::Unprotected, std::memory_order_release);
+    return true;
+  }
+
+  // Another thread is in the middle of changing the protection of the page, so retry the access
+  // until it's done. RAM is always mapped as writable otherwise, so faults on unprotected pages
+  // aren't ours.
+  return state != PageProtection::Unprotected;
+}
+
 }  // namespace Memory
@@ -4,7 +4,11 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
@@ -54,6 +58,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 class MemoryManager
@@ -103,6 +108,27 @@ public:
 
   void Clear();
 
+  // Write tracking lets the video backend skip rehashing guest memory that hasn't changed.
+  // Tracked pages are write-protected in the fastmem arena, so the first CPU store to each of them
+  // faults and gets recorded. Everything else that writes to RAM reports it through MarkWritten.
+  bool IsWriteTrackingEnabled() const
+  {
+    return m_write_tracking_enabled.load(std::memory_order_relaxed);
+  }
+  void SetWriteTrackingEnabled(bool enabled);
+
+  // Starts tracking writes to the given range and returns a token for WasWrittenSince.
+  // Only writes that happen after this call are reported.
+  u64 TrackWrites(u32 address, u32 size);
+  // Returns true if the range may have been written since the TrackWrites call returning token.
+  bool WasWrittenSince(u32 address, u32 size, u64 token) const;
+  void MarkWritten(u32 address, size_t size);
+
+  // Called for access violations in the fastmem arena. Returns true if the fault was caused by
+  // write tracking, in which case the access can be retried. Doesn't block, as it runs in the fault
+  // handler of the CPU thread.
+  bool HandleWriteTrackingFault(uintptr_t fault_address);
+
   // Routines to access physically addressed memory, designed for use by
   // emulated hardware outside the CPU. Use "Device_" prefix.
   std::string GetString(u32 em_address, size_t size = 0);
@@ -153,6 +179,8 @@ public:
 
     for (size_t i = 0; i < size / sizeof(T); i++)
       dest[i] = Common::FromBigEndian(data[i]);
+
+    MarkWritten(address, size);
   }
 
 private:
@@ -252,8 +280,41 @@ private:
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings{};
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings{};
 
+  // Write protection state of a tracked page. The fault handler can't take locks, so it and the
+  // threads that protect pages hand pages over to each other through the transient states.
+  enum class PageProtection : u8
+  {
+    Unprotected,
+    Protecting,
+    Protected,
+    Unprotecting,
+  };
+
+  // Write tracking state. Pages cover m_write_tracking_page_shift bits of MEM1 followed by MEM2.
+  // Each page remembers the value of m_write_count from its last write, and tokens handed out by
+  // TrackWrites are values of m_write_count as well. Except for the fault handler, everything that
+  // changes the protection of pages or the fastmem mappings holds m_write_tracking_lock.
+  std::atomic<bool> m_write_tracking_enabled = false;
+  u32 m_write_tracking_page_shift = 0;
+  u32 m_write_tracking_mem1_pages = 0;
+  u32 m_write_tracking_pages = 0;
+  std::unique_ptr<std::atomic<u64>[]> m_page_last_write;
+  std::unique_ptr<std::atomic<PageProtection>[]> m_page_protection;
+  std::atomic<u64> m_write_count = 0;
+  // Everything counts as written up to this value, e.g. after loading a savestate.
+  std::atomic<u64> m_all_written_count = 0;
+  mutable std::mutex m_write_tracking_lock;
+
   Core::System& m_system;
 
   void InitMMIO(bool is_wii);
+
+  void InitWriteTracking();
+  std::optional<u32> GetWriteTrackingPage(u32 physical_address) const;
+  u32 GetWriteTrackingPageAddress(u32 page) const;
+  void SetWriteProtection(u32 first_page, u32 last_page, bool write_protected);
+  void ForEachProtectedRun(const std::function<void(u32, u32)>& function) const;
+  void UnprotectAllPages();
+  void InvalidateWriteTracking();
 };
 }  // namespace Memory
@@ -788,12 +788,48 @@ void EmulationKernel::EnqueueIPCRequest(u32 address)
                                             address | ENQUEUE_REQUEST_FLAG);
 }
 
+// IOS devices write their output through raw pointers, which the write tracking of the texture
+// cache can't see. Mark every buffer the request could have written to as a whole instead.
+static void MarkRequestOutputsWritten(Core::System& system, const Request& request)
+{
+  auto& memory = system.GetMemory();
+  switch (request.command)
+  {
+  case IPC_CMD_READ:
+  {
+    const ReadWriteRequest read_request{system, request.address};
+    memory.MarkWritten(read_request.buffer, read_request.size);
+    break;
+  }
+  case IPC_CMD_IOCTL:
+  {
+    const IOCtlRequest ioctl_request{system, request.address};
+    memory.MarkWritten(ioctl_request.buffer_out, ioctl_request.buffer_out_size);
+    break;
+  }
+  case IPC_CMD_IOCTLV:
+  {
+    const IOCtlVRequest ioctlv_request{system, request.address};
+    for (const auto& vector : ioctlv_request.in_vectors)
+      memory.MarkWritten(vector.address, vector.size);
+    for (const auto& vector : ioctlv_request.io_vectors)
+      memory.MarkWritten(vector.address, vector.size);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
 // Called to send a reply to an IOS syscall
 void EmulationKernel::EnqueueIPCReply(const Request& request, const s32 return_value,
                                       s64 cycles_in_future, CoreTiming::FromThread from)
 {
   auto& system = GetSystem();
   auto& memory = system.GetMemory();
+  if (memory.IsWriteTrackingEnabled())
+    MarkRequestOutputsWritten(system, request);
+
   memory.Write_U32(static_cast<u32>(return_value), request.address + 4);
   // IOS writes back the command that was responded to in the FD field.
   memory.Write_U32(request.command, request.address + 8);
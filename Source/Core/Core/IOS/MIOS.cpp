@@ -37,6 +37,7 @@ static void ReinitHardware(Core::System& system)
   // IOS clears mem2 and overwrites it with pseudo-random data (for security).
   auto& memory = system.GetMemory();
   std::memset(memory.GetEXRAM(), 0, memory.GetExRamSizeReal());
+  memory.MarkWritten(0x10000000, memory.GetExRamSizeReal());
   // MIOS appears to only reset the DI and the PPC.
   // HACK However, resetting DI will reset the DTK config, which is set by the system menu
   // (and not by MIOS), causing games that use DTK to break.  Perhaps MIOS doesn't actually
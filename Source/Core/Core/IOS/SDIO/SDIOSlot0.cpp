@@ -287,7 +287,9 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       if (!m_card.Seek(address, File::SeekOrigin::Begin))
         ERROR_LOG_FMT(IOS_SD, "Seek failed");
 
-      if (m_card.ReadBytes(memory.GetPointerForRange(req.addr, size), size))
+      const bool success = m_card.ReadBytes(memory.GetPointerForRange(req.addr, size), size);
+      memory.MarkWritten(req.addr, size);
+      if (success)
       {
         DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, size);
       }
@@ -298,6 +298,7 @@ std::optional<IPCReply> WFSSRVDevice::IOCtl(const IOCtlRequest& request)
     }
     size_t read_bytes;
     fd_obj->file.ReadArray(memory.GetPointerForRange(addr, size), size, &read_bytes);
+    memory.MarkWritten(addr, size);
     // TODO(wfs): Handle read errors.
     if (absolute)
     {
@@ -15,6 +15,7 @@
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -232,6 +233,11 @@ bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
     return false;
   }
 
+  // Stores to RAM pages that the texture cache watches for writes. These have to be handled
+  // before the JIT gets to backpatch the faulting store.
+  if (m_system.GetMemory().HandleWriteTrackingFault(access_address))
+    return true;
+
   return m_jit->HandleFault(access_address, ctx);
 }
 
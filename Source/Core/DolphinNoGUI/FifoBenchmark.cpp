@@ -0,0 +1,257 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/Config/Config.h"
+#include "Common/JsonUtil.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/System.h"
+#include "VideoCommon/VideoEvents.h"
+
+namespace
+{
+// The per-frame counters of g_stats which are reported.
+constexpr std::pair<const char*, int Statistics::ThisFrame::*> FRAME_COUNTERS[] = {
+    {"prims", &Statistics::ThisFrame::num_prims},
+    {"dl_prims", &Statistics::ThisFrame::num_dl_prims},
+    {"draw_calls", &Statistics::ThisFrame::num_draw_calls},
+    {"primitive_joins", &Statistics::ThisFrame::num_primitive_joins},
+    {"shader_changes", &Statistics::ThisFrame::num_shader_changes},
+    {"redundant_state_writes", &Statistics::ThisFrame::num_redundant_state_writes},
+    {"merged_state_changes", &Statistics::ThisFrame::num_merged_state_changes},
+    {"bp_loads", &Statistics::ThisFrame::num_bp_loads},
+    {"cp_loads", &Statistics::ThisFrame::num_cp_loads},
+    {"xf_loads", &Statistics::ThisFrame::num_xf_loads},
+    {"vertices_loaded", &Statistics::ThisFrame::num_vertices_loaded},
+    {"bytes_vertex_streamed", &Statistics::ThisFrame::bytes_vertex_streamed},
+    {"bytes_index_streamed", &Statistics::ThisFrame::bytes_index_streamed},
+    {"bytes_uniform_streamed", &Statistics::ThisFrame::bytes_uniform_streamed},
+    {"triangles_in", &Statistics::ThisFrame::num_triangles_in},
+    {"triangles_culled", &Statistics::ThisFrame::num_triangles_culled},
+    {"textures_decoded", &Statistics::ThisFrame::num_textures_decoded},
+    {"texture_lookups", &Statistics::ThisFrame::num_texture_lookups},
+    {"texture_rehashes", &Statistics::ThisFrame::num_texture_rehashes},
+    {"efb_peeks", &Statistics::ThisFrame::num_efb_peeks},
+    {"efb_pokes", &Statistics::ThisFrame::num_efb_pokes},
+};
+
+std::chrono::nanoseconds GetCurrentThreadCPUTime()
+{
+#ifdef _WIN32
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+    return {};
+
+  const auto to_u64 = [](FILETIME time) {
+    return u64(time.dwHighDateTime) << 32 | time.dwLowDateTime;
+  };
+  // In units of 100 ns.
+  return std::chrono::nanoseconds((to_u64(kernel_time) + to_u64(user_time)) * 100);
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    return {};
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+}
+
+double ToMilliseconds(std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Nearest-rank percentile of sorted values.
+double GetPercentile(const std::vector<double>& sorted, double percentile)
+{
+  const size_t rank = static_cast<size_t>(std::ceil(percentile / 100 * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+picojson::object Summarize(std::vector<double> values)
+{
+  picojson::object result;
+  if (values.empty())
+    return result;
+
+  std::sort(values.begin(), values.end());
+  double sum = 0;
+  for (double value : values)
+    sum += value;
+
+  result["mean"] = picojson::value(sum / values.size());
+  result["min"] = picojson::value(values.front());
+  result["max"] = picojson::value(values.back());
+  for (double percentile : {50.0, 90.0, 95.0, 99.0})
+  {
+    result["p" + std::to_string(static_cast<int>(percentile))] =
+        picojson::value(GetPercentile(values, percentile));
+  }
+  return result;
+}
+}  // namespace
+
+FifoBenchmark::FifoBenchmark(Core::System& system, Options options,
+                             std::function<void()> finished_callback)
+    : m_system(system), m_options(std::move(options)),
+      m_finished_callback(std::move(finished_callback))
+{
+  m_system.GetFifoPlayer().SetFileLoadedCallback([this] { OnFileLoaded(); });
+  m_frame_end_event =
+      AfterFrameEvent::Register([this](Core::System&) { OnFrameEnd(); }, "FifoBenchmark");
+}
+
+FifoBenchmark::~FifoBenchmark()
+{
+  m_system.GetFifoPlayer().SetFileLoadedCallback(nullptr);
+}
+
+void FifoBenchmark::SetConfig(bool set_video_backend)
+{
+  // The measured frames may span more than one playback of the frame range.
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::GFX_VSYNC, false);
+  if (set_video_backend)
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string("Null"));
+}
+
+void FifoBenchmark::OnFileLoaded()
+{
+  FifoPlayer& player = m_system.GetFifoPlayer();
+  const FifoDataFile* file = player.GetFile();
+  if (!file || file->GetFrameCount() == 0 || m_options.first_frame >= file->GetFrameCount())
+  {
+    // There is nothing to measure, so the benchmark is stopped with an incomplete report.
+    fmt::print(stderr, "FIFO benchmark: first frame {} is not in the log, which has {} frames\n",
+               m_options.first_frame, file ? file->GetFrameCount() : 0);
+    m_finished_callback();
+    return;
+  }
+
+  const u32 last_frame = m_options.last_frame.value_or(file->GetFrameCount() - 1);
+  player.SetFrameRangeStart(m_options.first_frame);
+  player.SetFrameRangeEnd(last_frame);
+  m_frames_per_loop = player.GetFrameRangeEnd() - player.GetFrameRangeStart() + 1;
+  m_frames.reserve(size_t(m_frames_per_loop) * m_options.loops);
+}
+
+void FifoBenchmark::OnFrameEnd()
+{
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::nanoseconds gpu_thread_time = GetCurrentThreadCPUTime();
+
+  const size_t num_frames = size_t(m_frames_per_loop) * m_options.loops;
+  if (m_frames.size() >= num_frames)
+    return;
+
+  const Totals totals{g_stats.num_pixel_shaders_created, g_stats.num_vertex_shaders_created,
+                      g_stats.num_textures_created, g_stats.num_textures_uploaded};
+  if (m_frames_played >= std::max(m_options.warmup_frames, 1u))
+  {
+    m_frames.push_back({now - m_frame_start, gpu_thread_time - m_frame_start_gpu_thread_time,
+                        g_stats.this_frame});
+    m_end_totals = totals;
+  }
+  else
+  {
+    m_start_totals = totals;
+  }
+
+  m_frames_played++;
+  m_frame_start = now;
+  m_frame_start_gpu_thread_time = gpu_thread_time;
+
+  if (m_frames.size() == num_frames)
+    m_finished_callback();
+}
+
+bool FifoBenchmark::WriteReport(const std::string& dff_path) const
+{
+  picojson::array frames;
+  frames.reserve(m_frames.size());
+  std::vector<double> times;
+  std::vector<double> gpu_thread_times;
+  std::vector<std::vector<double>> counters(std::size(FRAME_COUNTERS));
+  for (const Frame& frame : m_frames)
+  {
+    picojson::object json;
+    times.push_back(ToMilliseconds(frame.time));
+    gpu_thread_times.push_back(ToMilliseconds(frame.gpu_thread_time));
+    json["time_ms"] = picojson::value(times.back());
+    json["gpu_thread_time_ms"] = picojson::value(gpu_thread_times.back());
+    for (size_t i = 0; i < std::size(FRAME_COUNTERS); i++)
+    {
+      const int value = frame.stats.*FRAME_COUNTERS[i].second;
+      counters[i].push_back(value);
+      json[FRAME_COUNTERS[i].first] = picojson::value(static_cast<double>(value));
+    }
+    frames.emplace_back(std::move(json));
+  }
+
+  picojson::object stats;
+  for (size_t i = 0; i < std::size(FRAME_COUNTERS); i++)
+    stats[FRAME_COUNTERS[i].first] = picojson::value(Summarize(std::move(counters[i])));
+
+  // Shaders and textures which were created while measuring. These aren't reset every frame.
+  const auto created = [](int end, int start) {
+    return picojson::value(static_cast<double>(end - start));
+  };
+  stats["pixel_shaders_created"] =
+      created(m_end_totals.num_pixel_shaders_created, m_start_totals.num_pixel_shaders_created);
+  stats["vertex_shaders_created"] =
+      created(m_end_totals.num_vertex_shaders_created, m_start_totals.num_vertex_shaders_created);
+  stats["textures_created"] =
+      created(m_end_totals.num_textures_created, m_start_totals.num_textures_created);
+  stats["textures_uploaded"] =
+      created(m_end_totals.num_textures_uploaded, m_start_totals.num_textures_uploaded);
+
+  double total_time = 0;
+  for (double time : times)
+    total_time += time;
+
+  const size_t num_frames = size_t(m_frames_per_loop) * m_options.loops;
+  picojson::object report;
+  report["file"] = picojson::value(dff_path);
+  report["video_backend"] = picojson::value(Config::Get(Config::MAIN_GFX_BACKEND));
+  report["dual_core"] = picojson::value(Config::Get(Config::MAIN_CPU_THREAD));
+  report["first_frame"] = picojson::value(static_cast<double>(m_options.first_frame));
+  report["frames_per_loop"] = picojson::value(static_cast<double>(m_frames_per_loop));
+  report["loops"] = picojson::value(static_cast<double>(m_options.loops));
+  report["warmup_frames"] = picojson::value(static_cast<double>(m_options.warmup_frames));
+  report["complete"] = picojson::value(num_frames != 0 && m_frames.size() == num_frames);
+  report["measured_frames"] = picojson::value(static_cast<double>(m_frames.size()));
+  report["total_time_ms"] = picojson::value(total_time);
+  report["fps"] = picojson::value(total_time > 0 ? m_frames.size() * 1000 / total_time : 0.0);
+  report["time_ms"] = picojson::value(Summarize(times));
+  report["gpu_thread_time_ms"] = picojson::value(Summarize(gpu_thread_times));
+  report["stats"] = picojson::value(std::move(stats));
+  report["frames"] = picojson::value(std::move(frames));
+
+  if (!times.empty())
+  {
+    std::sort(times.begin(), times.end());
+    fmt::print("FIFO benchmark: {} frames, {:.3f} ms per frame (p50 {:.3f}, p99 {:.3f})\n",
+               m_frames.size(), total_time / m_frames.size(), GetPercentile(times, 50),
+               GetPercentile(times, 99));
+  }
+
+  return JsonToFile(m_options.report_path, picojson::value(std::move(report)), true);
+}
@@ -0,0 +1,88 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/HookableEvent.h"
+#include "VideoCommon/Statistics.h"
+
+namespace Core
+{
+class System;
+}
+
+// Plays a FIFO log for a fixed number of frames and writes a JSON report of how long the GPU thread
+// took for each of them, so that the performance of different builds can be compared.
+//
+// Frames are timed on the GPU thread, from the end of one frame to the end of the next. The report
+// has both the elapsed time, and the CPU time of the GPU thread, which excludes the time it spent
+// waiting for the FIFO player.
+class FifoBenchmark
+{
+public:
+  struct Options
+  {
+    std::string report_path;
+    u32 first_frame = 0;
+    std::optional<u32> last_frame;
+    // The frame range is played this many times.
+    u32 loops = 1;
+    // Frames which are played before the measured ones, to fill the shader and texture caches.
+    // The first frame is never measured, as it doesn't have a start.
+    u32 warmup_frames = 0;
+  };
+
+  FifoBenchmark(Core::System& system, Options options, std::function<void()> finished_callback);
+  ~FifoBenchmark();
+
+  FifoBenchmark(const FifoBenchmark&) = delete;
+  FifoBenchmark& operator=(const FifoBenchmark&) = delete;
+
+  // Sets the playback and video settings which the benchmark depends on. The backend is only
+  // changed if no other one was requested.
+  static void SetConfig(bool set_video_backend);
+
+  // Must be called after emulation has stopped.
+  bool WriteReport(const std::string& dff_path) const;
+
+private:
+  struct Frame
+  {
+    std::chrono::nanoseconds time;
+    std::chrono::nanoseconds gpu_thread_time;
+    Statistics::ThisFrame stats;
+  };
+
+  // Totals of g_stats which aren't reset every frame.
+  struct Totals
+  {
+    int num_pixel_shaders_created = 0;
+    int num_vertex_shaders_created = 0;
+    int num_textures_created = 0;
+    int num_textures_uploaded = 0;
+  };
+
+  void OnFileLoaded();
+  void OnFrameEnd();
+
+  Core::System& m_system;
+  Options m_options;
+  std::function<void()> m_finished_callback;
+  Common::EventHook m_frame_end_event;
+
+  // Accessed only from the GPU thread while emulation is running.
+  u32 m_frames_per_loop = 0;
+  u32 m_frames_played = 0;
+  std::chrono::steady_clock::time_point m_frame_start;
+  std::chrono::nanoseconds m_frame_start_gpu_thread_time{};
+  std::vector<Frame> m_frames;
+  Totals m_start_totals;
+  Totals m_end_totals;
+};
@@ -7,8 +7,11 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <optional>
 #include <signal.h>
 #include <string>
+#include <variant>
 #include <vector>
 
 #ifndef _WIN32
@@ -32,6 +35,8 @@
 #endif
 #include "UICommon/UICommon.h"
 
+#include "DolphinNoGUI/FifoBenchmark.h"
+
 #include "InputCommon/GCAdapter.h"
 
 #include "VideoCommon/VideoBackendBase.h"
@@ -160,6 +165,10 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
   std::string platform_name = static_cast<const char*>(options.get("platform"));
 
+  // Benchmarks are meant to run without a display.
+  if (platform_name.empty() && options.is_set("fifo_benchmark"))
+    platform_name = "headless";
+
 #if HAVE_X11
   if (platform_name == "x11" || platform_name.empty())
     return Platform::CreateX11Platform();
@@ -216,6 +225,27 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--fifo-benchmark")
+      .dest("fifo_benchmark")
+      .metavar("<report.json>")
+      .action("store")
+      .help("Play the given FIFO log as a benchmark, and write the frame times to a JSON report. "
+            "Uses the Null video backend unless another one is specified");
+  parser->add_option("--fifo-frames")
+      .dest("fifo_frames")
+      .metavar("<first>:<last>")
+      .action("store")
+      .help("Range of FIFO log frames to benchmark");
+  parser->add_option("--fifo-loops")
+      .dest("fifo_loops")
+      .type("int")
+      .set_default(1)
+      .help("Number of times to play the frame range when benchmarking");
+  parser->add_option("--fifo-warmup")
+      .dest("fifo_warmup")
+      .type("int")
+      .set_default(0)
+      .help("Number of frames to play before measuring when benchmarking");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -295,6 +325,48 @@ int main(int argc, char* argv[])
       s_platform->Stop();
   });
 
+  std::unique_ptr<FifoBenchmark> fifo_benchmark;
+  std::string fifo_benchmark_dff_path;
+  if (options.is_set("fifo_benchmark"))
+  {
+    if (!std::holds_alternative<BootParameters::DFF>(boot->parameters))
+    {
+      fprintf(stderr, "A FIFO log must be specified to run a benchmark.\n");
+      return 1;
+    }
+    fifo_benchmark_dff_path = std::get<BootParameters::DFF>(boot->parameters).dff_path;
+
+    FifoBenchmark::Options benchmark_options;
+    benchmark_options.report_path = static_cast<const char*>(options.get("fifo_benchmark"));
+    if (options.is_set("fifo_frames"))
+    {
+      u32 first_frame, last_frame;
+      const std::string range = static_cast<const char*>(options.get("fifo_frames"));
+      if (std::sscanf(range.c_str(), "%u:%u", &first_frame, &last_frame) != 2 ||
+          first_frame > last_frame)
+      {
+        fprintf(stderr, "Invalid FIFO frame range\n");
+        return 1;
+      }
+      benchmark_options.first_frame = first_frame;
+      benchmark_options.last_frame = last_frame;
+    }
+    const int loops = options.get("fifo_loops");
+    const int warmup_frames = options.get("fifo_warmup");
+    if (loops < 1 || warmup_frames < 0)
+    {
+      fprintf(stderr, "Invalid number of FIFO benchmark loops or warmup frames\n");
+      return 1;
+    }
+    benchmark_options.loops = static_cast<u32>(loops);
+    benchmark_options.warmup_frames = static_cast<u32>(warmup_frames);
+
+    FifoBenchmark::SetConfig(!options.is_set("video_backend"));
+    fifo_benchmark = std::make_unique<FifoBenchmark>(Core::System::GetInstance(),
+                                                     std::move(benchmark_options),
+                                                     [] { s_platform->Stop(); });
+  }
+
 #ifdef _WIN32
   signal(SIGINT, signal_handler);
   signal(SIGTERM, signal_handler);
@@ -326,6 +398,15 @@ int main(int argc, char* argv[])
   Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
+  if (fifo_benchmark)
+  {
+    if (!fifo_benchmark->WriteReport(fifo_benchmark_dff_path))
+    {
+      fprintf(stderr, "Failed to write the FIFO benchmark report\n");
+      return 1;
+    }
+  }
+
   return 0;
 }
 
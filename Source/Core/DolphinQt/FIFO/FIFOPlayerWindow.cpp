@@ -87,7 +87,7 @@ void FIFOPlayerWindow::CreateWidgets()
   info_layout->addWidget(m_info_label);
   info_group->setLayout(info_layout);
 
-  m_info_label->setFixedHeight(QFontMetrics(font()).lineSpacing() * 3);
+  m_info_label->setFixedHeight(QFontMetrics(font()).lineSpacing() * 4);
 
   // Object Range
   auto* object_range_group = new QGroupBox(tr("Object Range"));
@@ -141,8 +141,11 @@ void FIFOPlayerWindow::CreateWidgets()
   m_frame_record_count->setMaximum(3600);
   m_frame_record_count->setValue(3);
 
+  m_compress = new ToolTipCheckBox(tr("Compress"));
+
   recording_layout->addWidget(m_frame_record_count_label);
   recording_layout->addWidget(m_frame_record_count);
+  recording_layout->addWidget(m_compress);
   recording_group->setLayout(recording_layout);
 
   m_button_box = new QDialogButtonBox(QDialogButtonBox::Close);
@@ -178,6 +181,7 @@ void FIFOPlayerWindow::LoadSettings()
 {
   m_early_memory_updates->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES));
   m_loop->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_LOOP_REPLAY));
+  m_compress->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS));
 }
 
 void FIFOPlayerWindow::ConnectWidgets()
@@ -189,6 +193,7 @@ void FIFOPlayerWindow::ConnectWidgets()
   connect(m_button_box, &QDialogButtonBox::rejected, this, &FIFOPlayerWindow::hide);
   connect(m_early_memory_updates, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
   connect(m_loop, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
+  connect(m_compress, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
 
   connect(m_frame_range_from, &QSpinBox::valueChanged, this, &FIFOPlayerWindow::OnLimitsChanged);
   connect(m_frame_range_to, &QSpinBox::valueChanged, this, &FIFOPlayerWindow::OnLimitsChanged);
@@ -207,9 +212,15 @@ void FIFOPlayerWindow::AddDescriptions()
       QT_TR_NOOP("If unchecked, then playback of the fifolog stops after the final frame.<br><br>"
                  "This is generally only useful when a frame-dumping option is enabled.<br><br>"
                  "<dolphin_emphasis>If unsure, leave this checked.</dolphin_emphasis>");
+  static const char TR_COMPRESS_DESCRIPTION[] =
+      QT_TR_NOOP("If checked, saved fifologs are compressed with Zstandard. Compressed fifologs "
+                 "are much smaller, but can't be played by versions of Dolphin without support "
+                 "for them.<br><br>"
+                 "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
 
   m_early_memory_updates->SetDescription(tr(TR_MEMORY_UPDATES_DESCRIPTION));
   m_loop->SetDescription(tr(TR_LOOP_DESCRIPTION));
+  m_compress->SetDescription(tr(TR_COMPRESS_DESCRIPTION));
 }
 
 void FIFOPlayerWindow::LoadRecording()
@@ -300,20 +311,16 @@ void FIFOPlayerWindow::UpdateInfo()
 
   if (m_fifo_recorder.IsRecordingDone())
   {
-    FifoDataFile* file = m_fifo_recorder.GetRecordedFile();
-    size_t fifo_bytes = 0;
-    size_t mem_bytes = 0;
-
-    for (u32 i = 0; i < file->GetFrameCount(); ++i)
-    {
-      fifo_bytes += file->GetFrame(i).fifoData.size();
-      for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
-        mem_bytes += mem_update.data.size();
-    }
-
-    m_info_label->setText(tr("%1 FIFO bytes\n%2 memory bytes\n%3 frames")
-                              .arg(QString::number(fifo_bytes), QString::number(mem_bytes),
-                                   QString::number(file->GetFrameCount())));
+    const FifoRecorder::Statistics stats = m_fifo_recorder.GetStatistics();
+    const double average_overhead =
+        stats.total_overhead.count() / 1000.0 / std::max<u32>(stats.frames, 1);
+    m_info_label->setText(
+        tr("%1 FIFO bytes\n%2 memory bytes (%3 after deduplication)\n%4 frames\n"
+           "%5 ms recording overhead per frame (max %6 ms)")
+            .arg(QString::number(stats.fifo_bytes), QString::number(stats.memory_update_bytes),
+                 QString::number(stats.written_memory_update_bytes),
+                 QString::number(stats.frames), QString::number(average_overhead, 'f', 2),
+                 QString::number(stats.max_frame_overhead.count() / 1000.0, 'f', 2)));
     return;
   }
 
@@ -353,6 +360,7 @@ void FIFOPlayerWindow::OnConfigChanged()
   Config::SetBase(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES,
                   m_early_memory_updates->isChecked());
   Config::SetBase(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, m_loop->isChecked());
+  Config::SetBase(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS, m_compress->isChecked());
 }
 
 void FIFOPlayerWindow::OnLimitsChanged()
@@ -0,0 +1,207 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <zstd.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
+#include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+#include "VideoCommon/Assets/TexturePackFile.h"
+
+namespace DolphinTool
+{
+namespace
+{
+// Textures are loaded and encoded in batches, so that the whole pack isn't held in memory
+constexpr std::size_t BATCH_SIZE = 256;
+
+struct SourceTexture
+{
+  std::string name;
+  bool has_arbitrary_mipmaps;
+};
+
+// Additional mip levels are stored in "<name>_mip<N>" files next to the texture
+bool IsMipLevelFile(const std::string& filename)
+{
+  const std::size_t mip_index = filename.rfind("_mip");
+  if (mip_index == std::string::npos || mip_index + 4 == filename.size())
+    return false;
+  return std::all_of(filename.begin() + mip_index + 4, filename.end(),
+                     [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Adds the textures to the pack and closes it, counting those which couldn't be loaded
+bool WriteTextures(VideoCommon::TexturePackWriter& writer, const std::string& output_path,
+                   VideoCommon::DirectFilesystemAssetLibrary& library,
+                   const std::vector<SourceTexture>& textures, int compression_level,
+                   std::size_t* num_failed)
+{
+  const u32 num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  Common::ThreadPool thread_pool("Texture Pack Encoder", num_threads - 1);
+  for (std::size_t batch_start = 0; batch_start < textures.size(); batch_start += BATCH_SIZE)
+  {
+    const std::size_t batch_size = std::min(BATCH_SIZE, textures.size() - batch_start);
+    std::vector<std::optional<VideoCommon::TexturePackWriter::EncodedTexture>> encoded(batch_size);
+    thread_pool.ParallelFor(batch_size, [&](std::size_t i) {
+      const SourceTexture& texture = textures[batch_start + i];
+      VideoCommon::TextureData data;
+      if (library.LoadGameTexture(texture.name, &data).m_bytes_loaded == 0)
+        return;
+      encoded[i] = VideoCommon::TexturePackWriter::Encode(
+          texture.name, texture.has_arbitrary_mipmaps, data.m_texture, compression_level);
+    });
+
+    for (std::size_t i = 0; i < batch_size; i++)
+    {
+      if (!encoded[i] || encoded[i]->levels.empty())
+      {
+        fmt::println(std::cerr, "Warning: Unable to load texture '{}'",
+                     textures[batch_start + i].name);
+        (*num_failed)++;
+        continue;
+      }
+
+      if (!writer.AddTexture(std::move(*encoded[i])))
+      {
+        fmt::println(std::cerr, "Error: Unable to write to '{}'", output_path);
+        return false;
+      }
+    }
+
+    fmt::print(std::cerr, "Packing textures... {}/{}\r", batch_start + batch_size,
+               textures.size());
+  }
+
+  if (!writer.Close())
+  {
+    fmt::println(std::cerr, "Error: Unable to write to '{}'", output_path);
+    return false;
+  }
+
+  return true;
+}
+}  // namespace
+
+int TexturePackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: texturepack [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a directory of custom textures.")
+      .metavar("DIR");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack FILE to create.")
+      .metavar("FILE");
+
+  parser.add_option("-l", "--compression_level")
+      .type("int")
+      .action("store")
+      .help(fmt::format("Optional. zstd level used for textures which aren't block compressed, "
+                        "from {} to {}. [default: %default]",
+                        ZSTD_minCLevel(), ZSTD_maxCLevel()))
+      .set_default(9)
+      .metavar("LEVEL");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string& input_path = options["input"];
+  if (input_path.empty() || !File::IsDirectory(input_path))
+  {
+    fmt::println(std::cerr, "Error: No input directory set");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& output_path = options["output"];
+  if (output_path.empty())
+  {
+    fmt::println(std::cerr, "Error: No output set");
+    return EXIT_FAILURE;
+  }
+
+  const int compression_level = static_cast<int>(options.get("compression_level"));
+  if (compression_level < ZSTD_minCLevel() || compression_level > ZSTD_maxCLevel())
+  {
+    fmt::println(std::cerr, "Error: Compression level must be between {} and {}",
+                 ZSTD_minCLevel(), ZSTD_maxCLevel());
+    return EXIT_FAILURE;
+  }
+
+  // Find the textures the same way the emulator does for a directory of custom textures
+  VideoCommon::DirectFilesystemAssetLibrary library;
+  std::vector<SourceTexture> textures;
+  std::set<std::string> names;
+  for (const std::string& path : Common::DoFileSearch({input_path}, {".png", ".dds"}, true))
+  {
+    std::string filename;
+    SplitPath(path, nullptr, &filename, nullptr);
+    if (!filename.starts_with("tex1_") || IsMipLevelFile(filename))
+      continue;
+
+    const std::size_t arb_index = filename.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      filename.erase(arb_index, 4);
+
+    if (!names.insert(filename).second)
+    {
+      fmt::println(std::cerr, "Warning: Skipping '{}', a texture with the same name was found",
+                   path);
+      continue;
+    }
+
+    library.SetAssetIDMapData(filename, std::map<std::string, std::filesystem::path>{
+                                            {"texture", StringToPath(path)}});
+    textures.push_back({std::move(filename), has_arbitrary_mipmaps});
+  }
+
+  std::size_t num_failed = 0;
+  bool success;
+  // The writer is destroyed before a failed pack is deleted, so that the file is closed
+  {
+    VideoCommon::TexturePackWriter writer;
+    if (!writer.Open(output_path))
+    {
+      fmt::println(std::cerr, "Error: Unable to create '{}'", output_path);
+      return EXIT_FAILURE;
+    }
+    success = WriteTextures(writer, output_path, library, textures, compression_level, &num_failed);
+  }
+  if (!success)
+  {
+    // Don't leave a pack without an index behind
+    File::Delete(output_path, File::IfAbsentBehavior::NoConsoleWarning);
+    return EXIT_FAILURE;
+  }
+
+  fmt::println(std::cerr, "\nPacked {} textures into '{}' ({} could not be loaded)",
+               textures.size() - num_failed, output_path, num_failed);
+  return num_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/Assets/CustomAsset.h"
 
+#include <utility>
+
 namespace VideoCommon
 {
 CustomAsset::CustomAsset(std::shared_ptr<CustomAssetLibrary> library,
@@ -23,11 +25,23 @@ bool CustomAsset::Load()
   return load_information.m_bytes_loaded != 0;
 }
 
+std::size_t CustomAsset::Unload()
+{
+  UnloadImpl();
+  std::lock_guard lk(m_info_lock);
+  return std::exchange(m_bytes_loaded, 0);
+}
+
 CustomAssetLibrary::TimeType CustomAsset::GetLastWriteTime() const
 {
   return m_owning_library->GetLastAssetWriteTime(m_asset_id);
 }
 
+std::vector<std::filesystem::path> CustomAsset::GetFiles() const
+{
+  return m_owning_library->GetAssetFiles(m_asset_id);
+}
+
 const CustomAssetLibrary::TimeType& CustomAsset::GetLastLoadedTime() const
 {
   std::lock_guard lk(m_info_lock);
@@ -3,12 +3,24 @@
 
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 
+#include <algorithm>
+
+#ifdef __linux__
+#include <array>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 #include "Common/MemoryUtil.h"
+#include "Common/Thread.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
 namespace VideoCommon
 {
-void CustomAssetLoader::Init()
+void CustomAssetLoader::Init(int num_load_threads)
 {
   m_asset_monitor_thread_shutdown.Clear();
 
@@ -18,91 +30,446 @@ void CustomAssetLoader::Init()
   m_max_memory_available =
       (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
 
-  m_asset_monitor_thread = std::thread([this]() {
-    Common::SetCurrentThreadName("Asset monitor");
-    while (true)
-    {
-      if (m_asset_monitor_thread_shutdown.IsSet())
-      {
-        break;
-      }
-
-      std::this_thread::sleep_for(TIME_BETWEEN_ASSET_MONITOR_CHECKS);
+#ifdef __linux__
+  m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  m_monitor_wakeup_eventfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  m_poll_for_changes = m_inotify_fd == -1 || m_monitor_wakeup_eventfd == -1;
+  if (m_poll_for_changes)
+    WARN_LOG_FMT(VIDEO, "Couldn't watch custom assets for changes, polling them instead.");
+#endif
 
-      std::lock_guard lk(m_asset_load_lock);
-      for (auto& [asset_id, asset_to_monitor] : m_assets_to_monitor)
-      {
-        if (auto ptr = asset_to_monitor.lock())
-        {
-          const auto write_time = ptr->GetLastWriteTime();
-          if (write_time > ptr->GetLastLoadedTime())
-          {
-            (void)ptr->Load();
-          }
-        }
-      }
-    }
-  });
-
-  m_asset_load_thread.Reset("Custom Asset Loader", [this](std::weak_ptr<CustomAsset> asset) {
-    if (auto ptr = asset.lock())
-    {
-      if (m_memory_exceeded)
-        return;
+  m_asset_monitor_thread = std::thread(&CustomAssetLoader::MonitorAssets, this);
 
-      if (ptr->Load())
-      {
-        std::lock_guard lk(m_asset_load_lock);
-        const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
-        m_total_bytes_loaded += asset_memory_size;
-        m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
-        if (m_total_bytes_loaded > m_max_memory_available)
-        {
-          ERROR_LOG_FMT(VIDEO,
-                        "Asset memory exceeded with asset '{}', future assets won't load until "
-                        "memory is available.",
-                        ptr->GetAssetId());
-          m_memory_exceeded = true;
-        }
-      }
-    }
-  });
+  // Decoding is mostly CPU bound, but leave most of the cores to the emulation threads
+  if (num_load_threads < 0)
+    num_load_threads = std::clamp(static_cast<int>(std::thread::hardware_concurrency() / 2), 1, 4);
+  m_load_threads_shutdown = false;
+  for (int i = 0; i < std::max(num_load_threads, 1); i++)
+    m_load_threads.emplace_back(&CustomAssetLoader::LoadWorker, this);
 }
 
 void CustomAssetLoader ::Shutdown()
 {
-  m_asset_load_thread.Shutdown(true);
+  {
+    std::lock_guard lk(m_load_queue_lock);
+    m_load_threads_shutdown = true;
+    m_load_queue = {};
+  }
+  m_load_queue_cv.notify_all();
+  for (std::thread& thread : m_load_threads)
+    thread.join();
+  m_load_threads.clear();
 
   m_asset_monitor_thread_shutdown.Set();
+#ifdef __linux__
+  if (m_monitor_wakeup_eventfd != -1)
+  {
+    const u64 value = 1;
+    static_cast<void>(!write(m_monitor_wakeup_eventfd, &value, sizeof(value)));
+  }
+#endif
   m_asset_monitor_thread.join();
+#ifdef __linux__
+  for (int* fd : {&m_inotify_fd, &m_monitor_wakeup_eventfd})
+  {
+    if (*fd != -1)
+      close(*fd);
+    *fd = -1;
+  }
+  m_watched_directories.clear();
+#endif
   m_assets_to_monitor.clear();
   m_total_bytes_loaded = 0;
+  m_loaded_game_textures.clear();
+  m_game_texture_residency.clear();
+  m_game_texture_bytes_loaded = 0;
+  m_load_statistics = {};
 }
 
 std::shared_ptr<GameTextureAsset>
 CustomAssetLoader::LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
-                                   std::shared_ptr<CustomAssetLibrary> library)
+                                   std::shared_ptr<CustomAssetLibrary> library,
+                                   LoadPriority priority)
 {
-  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library));
+  std::lock_guard lk(m_asset_load_lock);
+  auto asset = LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library),
+                                                   priority);
+  const auto [it, inserted] = m_game_texture_residency.try_emplace(asset.get());
+  if (inserted)
+  {
+    // New assets are queued to load when they are created
+    it->second.lru_position = m_loaded_game_textures.end();
+    it->second.load_queued = true;
+    it->second.queued_priority = priority;
+  }
+  return asset;
 }
 
 std::shared_ptr<PixelShaderAsset>
 CustomAssetLoader::LoadPixelShader(const CustomAssetLibrary::AssetID& asset_id,
                                    std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<PixelShaderAsset>(asset_id, m_pixel_shaders, std::move(library));
+  return LoadOrCreateAsset<PixelShaderAsset>(asset_id, m_pixel_shaders, std::move(library),
+                                             LoadPriority::Normal);
 }
 
 std::shared_ptr<MaterialAsset>
 CustomAssetLoader::LoadMaterial(const CustomAssetLibrary::AssetID& asset_id,
                                 std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<MaterialAsset>(asset_id, m_materials, std::move(library));
+  return LoadOrCreateAsset<MaterialAsset>(asset_id, m_materials, std::move(library),
+                                          LoadPriority::Normal);
 }
 
 std::shared_ptr<MeshAsset> CustomAssetLoader::LoadMesh(const CustomAssetLibrary::AssetID& asset_id,
                                                        std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<MeshAsset>(asset_id, m_meshes, std::move(library));
+  return LoadOrCreateAsset<MeshAsset>(asset_id, m_meshes, std::move(library),
+                                      LoadPriority::Normal);
+}
+
+void CustomAssetLoader::SetGameTextureMemoryBudget(std::size_t budget)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  m_game_texture_memory_budget = budget;
+  EvictGameTextures(nullptr);
+}
+
+bool CustomAssetLoader::UseGameTexture(const std::shared_ptr<GameTextureAsset>& asset,
+                                       LoadPriority priority)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  const auto it = m_game_texture_residency.find(asset.get());
+  if (it == m_game_texture_residency.end())
+    return asset->GetByteSizeInMemory() != 0;
+
+  GameTextureResidency& residency = it->second;
+  if (residency.lru_position != m_loaded_game_textures.end())
+  {
+    m_loaded_game_textures.splice(m_loaded_game_textures.begin(), m_loaded_game_textures,
+                                  residency.lru_position);
+    return true;
+  }
+
+  if (residency.loading || residency.load_failed)
+    return false;
+
+  // The load is queued again rather than moved, the earlier request is skipped when it comes up
+  if (!residency.load_queued || residency.queued_priority < priority)
+    QueueGameTextureLoad(asset, residency, priority);
+  return false;
+}
+
+CustomAssetLoader::GameTextureStatistics CustomAssetLoader::GetGameTextureStatistics()
+{
+  std::lock_guard lk(m_asset_load_lock);
+  return {m_loaded_game_textures.size(), m_game_texture_bytes_loaded, m_num_game_textures_evicted};
+}
+
+CustomAssetLoader::LoadStatistics CustomAssetLoader::GetLoadStatistics()
+{
+  std::lock_guard lk(m_asset_load_lock);
+  return m_load_statistics;
+}
+
+void CustomAssetLoader::QueueLoad(std::weak_ptr<CustomAsset> asset, LoadPriority priority)
+{
+  {
+    std::lock_guard lk(m_load_queue_lock);
+    m_load_queue.push({priority, m_next_load_sequence++, Clock::now(), std::move(asset)});
+  }
+  m_load_queue_cv.notify_one();
+}
+
+void CustomAssetLoader::LoadWorker()
+{
+  Common::SetCurrentThreadName("Custom Asset Loader");
+  while (true)
+  {
+    QueuedLoad load;
+    {
+      std::unique_lock lk(m_load_queue_lock);
+      m_load_queue_cv.wait(lk, [this] { return m_load_threads_shutdown || !m_load_queue.empty(); });
+      if (m_load_threads_shutdown)
+        return;
+      load = m_load_queue.top();
+      m_load_queue.pop();
+    }
+
+    if (auto ptr = load.asset.lock())
+    {
+      if (!BeginLoad(ptr.get()))
+        continue;
+
+      const Clock::time_point load_start_time = Clock::now();
+      OnAssetLoaded(ptr, ptr->Load(), load.queue_time, load_start_time);
+    }
+  }
+}
+
+bool CustomAssetLoader::BeginLoad(const CustomAsset* asset)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  const auto residency = m_game_texture_residency.find(asset);
+  if (residency != m_game_texture_residency.end())
+  {
+    // Already loaded through another request for it
+    if (!residency->second.load_queued)
+      return false;
+    residency->second.load_queued = false;
+  }
+
+  // Not a failure, the asset can be requested again once memory is available
+  if (m_memory_exceeded)
+    return false;
+
+  if (residency != m_game_texture_residency.end())
+    residency->second.loading = true;
+  return true;
+}
+
+void CustomAssetLoader::OnAssetLoaded(const std::shared_ptr<CustomAsset>& asset, bool loaded,
+                                      Clock::time_point queue_time,
+                                      Clock::time_point load_start_time)
+{
+  const Clock::time_point load_end_time = Clock::now();
+
+  std::lock_guard lk(m_asset_load_lock);
+  const auto residency = m_game_texture_residency.find(asset.get());
+  if (residency != m_game_texture_residency.end())
+  {
+    residency->second.loading = false;
+    residency->second.load_failed = !loaded;
+  }
+  if (!loaded)
+    return;
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  const auto latency = duration_cast<microseconds>(load_end_time - queue_time);
+  const auto load_time = duration_cast<microseconds>(load_end_time - load_start_time);
+  m_load_statistics.num_loads++;
+  m_load_statistics.total_latency += latency;
+  m_load_statistics.max_latency = std::max(m_load_statistics.max_latency, latency);
+  m_load_statistics.total_load_time += load_time;
+  m_load_statistics.max_load_time = std::max(m_load_statistics.max_load_time, load_time);
+
+  const std::size_t asset_memory_size = asset->GetByteSizeInMemory();
+  m_total_bytes_loaded += asset_memory_size;
+  if (m_assets_to_monitor.try_emplace(asset->GetAssetId(), asset).second)
+    WatchAssetFiles(*asset);
+  if (residency != m_game_texture_residency.end())
+  {
+    m_loaded_game_textures.push_front(asset.get());
+    residency->second.lru_position = m_loaded_game_textures.begin();
+    m_game_texture_bytes_loaded += asset_memory_size;
+    EvictGameTextures(asset.get());
+  }
+
+  if (m_total_bytes_loaded > m_max_memory_available)
+  {
+    ERROR_LOG_FMT(VIDEO,
+                  "Asset memory exceeded with asset '{}', future assets won't load until "
+                  "memory is available.",
+                  asset->GetAssetId());
+    m_memory_exceeded = true;
+  }
+}
+
+void CustomAssetLoader::QueueGameTextureLoad(const std::shared_ptr<GameTextureAsset>& asset,
+                                             GameTextureResidency& residency,
+                                             LoadPriority priority)
+{
+  residency.load_queued = true;
+  residency.queued_priority = priority;
+  QueueLoad(asset, priority);
+}
+
+void CustomAssetLoader::RemoveGameTexture(const CustomAsset* asset)
+{
+  const auto it = m_game_texture_residency.find(asset);
+  if (it == m_game_texture_residency.end())
+    return;
+
+  if (it->second.lru_position != m_loaded_game_textures.end())
+  {
+    m_game_texture_bytes_loaded -= asset->GetByteSizeInMemory();
+    m_loaded_game_textures.erase(it->second.lru_position);
+  }
+  m_game_texture_residency.erase(it);
+}
+
+void CustomAssetLoader::EvictGameTextures(const CustomAsset* keep)
+{
+  const std::size_t budget =
+      m_game_texture_memory_budget != 0 ? m_game_texture_memory_budget : m_max_memory_available;
+  auto it = m_loaded_game_textures.end();
+  while ((m_game_texture_bytes_loaded > budget || m_total_bytes_loaded > m_max_memory_available) &&
+         it != m_loaded_game_textures.begin())
+  {
+    --it;
+    CustomAsset* const asset = *it;
+    // Textures which are being reloaded are evicted once they're done
+    if (asset == keep || m_game_texture_residency[asset].loading)
+      continue;
+
+    const std::size_t bytes_freed = asset->Unload();
+    m_game_texture_bytes_loaded -= bytes_freed;
+    m_total_bytes_loaded -= bytes_freed;
+    m_assets_to_monitor.erase(asset->GetAssetId());
+    m_game_texture_residency[asset].lru_position = m_loaded_game_textures.end();
+    it = m_loaded_game_textures.erase(it);
+    m_num_game_textures_evicted++;
+  }
+
+  if (m_memory_exceeded && m_max_memory_available >= m_total_bytes_loaded)
+  {
+    INFO_LOG_FMT(VIDEO, "Asset memory went below limit, new assets can begin loading.");
+    m_memory_exceeded = false;
+  }
+}
+
+void CustomAssetLoader::MonitorAssets()
+{
+  Common::SetCurrentThreadName("Asset monitor");
+  while (!m_asset_monitor_thread_shutdown.IsSet())
+  {
+    if (WaitForAssetChanges())
+      ReloadChangedAssets();
+  }
+}
+
+bool CustomAssetLoader::WaitForAssetChanges()
+{
+#ifdef __linux__
+  if (m_monitor_wakeup_eventfd != -1)
+  {
+    // poll ignores the inotify fd if it couldn't be created
+    std::array<pollfd, 2> fds{{{m_monitor_wakeup_eventfd, POLLIN, 0}, {m_inotify_fd, POLLIN, 0}}};
+    const int timeout =
+        m_poll_for_changes ? static_cast<int>(TIME_BETWEEN_ASSET_MONITOR_CHECKS.count()) : -1;
+    const int result = poll(fds.data(), fds.size(), timeout);
+    if (result == 0)
+      return true;
+    if (result < 0 || fds[0].revents != 0)
+    {
+      u64 value;
+      static_cast<void>(!read(m_monitor_wakeup_eventfd, &value, sizeof(value)));
+      return false;
+    }
+
+    std::this_thread::sleep_for(TIME_TO_SETTLE_ASSET_CHANGES);
+    alignas(inotify_event) char events[4096];
+    while (read(m_inotify_fd, events, sizeof(events)) > 0)
+    {
+    }
+    return true;
+  }
+#endif
+
+  std::this_thread::sleep_for(TIME_BETWEEN_ASSET_MONITOR_CHECKS);
+  return true;
+}
+
+void CustomAssetLoader::ReloadChangedAssets()
+{
+  // The write times are checked and the assets are loaded without holding the lock, so that
+  // requests for other assets don't wait on the filesystem. The assets are kept alive meanwhile,
+  // so that they aren't removed from the map while it's being iterated.
+  std::vector<std::shared_ptr<CustomAsset>> assets;
+  {
+    std::lock_guard lk(m_asset_load_lock);
+    assets.reserve(m_assets_to_monitor.size());
+    for (auto& [asset_id, asset_to_monitor] : m_assets_to_monitor)
+    {
+      if (auto ptr = asset_to_monitor.lock())
+        assets.push_back(std::move(ptr));
+    }
+  }
+
+  std::erase_if(assets, [](const std::shared_ptr<CustomAsset>& asset) {
+    return asset->GetLastWriteTime() <= asset->GetLastLoadedTime();
+  });
+  if (assets.empty())
+    return;
+
+  struct ChangedAsset
+  {
+    std::shared_ptr<CustomAsset> asset;
+    std::size_t previous_size;
+  };
+  std::vector<ChangedAsset> changed_assets;
+  {
+    std::lock_guard lk(m_asset_load_lock);
+    for (auto& ptr : assets)
+    {
+      // Evicted assets pick up the change when they're loaded again
+      if (!m_assets_to_monitor.contains(ptr->GetAssetId()))
+        continue;
+
+      // Keeps the texture from being evicted until its memory use is updated below
+      if (const auto it = m_game_texture_residency.find(ptr.get());
+          it != m_game_texture_residency.end())
+      {
+        it->second.loading = true;
+      }
+      const std::size_t previous_size = ptr->GetByteSizeInMemory();
+      changed_assets.push_back({std::move(ptr), previous_size});
+    }
+  }
+
+  std::vector<bool> loaded(changed_assets.size());
+  for (std::size_t i = 0; i < changed_assets.size(); i++)
+    loaded[i] = changed_assets[i].asset->Load();
+
+  std::lock_guard lk(m_asset_load_lock);
+  for (std::size_t i = 0; i < changed_assets.size(); i++)
+  {
+    const auto& [ptr, previous_size] = changed_assets[i];
+    const auto it = m_game_texture_residency.find(ptr.get());
+    if (it != m_game_texture_residency.end())
+      it->second.loading = false;
+    if (!loaded[i])
+      continue;
+
+    const std::size_t size = ptr->GetByteSizeInMemory();
+    m_total_bytes_loaded = m_total_bytes_loaded - previous_size + size;
+    if (it != m_game_texture_residency.end() &&
+        it->second.lru_position != m_loaded_game_textures.end())
+    {
+      m_game_texture_bytes_loaded = m_game_texture_bytes_loaded - previous_size + size;
+    }
+  }
+  EvictGameTextures(nullptr);
+}
+
+void CustomAssetLoader::WatchAssetFiles(const CustomAsset& asset)
+{
+#ifdef __linux__
+  if (m_inotify_fd == -1)
+    return;
+
+  // Editors often replace a file rather than writing to it, so watch the directories instead
+  constexpr u32 mask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO;
+  for (const std::filesystem::path& file : asset.GetFiles())
+  {
+    std::filesystem::path directory = file.parent_path();
+    if (m_watched_directories.contains(directory))
+      continue;
+
+    if (inotify_add_watch(m_inotify_fd, directory.c_str(), mask) == -1)
+    {
+      if (!m_poll_for_changes.exchange(true))
+      {
+        WARN_LOG_FMT(VIDEO, "Couldn't watch '{}' for changes, polling custom assets instead.",
+                     directory.string());
+        const u64 value = 1;
+        static_cast<void>(!write(m_monitor_wakeup_eventfd, &value, sizeof(value)));
+      }
+      continue;
+    }
+    m_watched_directories.insert(std::move(directory));
+  }
+#endif
 }
 }  // namespace VideoCommon
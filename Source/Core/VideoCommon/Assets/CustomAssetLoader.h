@@ -3,15 +3,23 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <queue>
+#include <set>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
-#include "Common/WorkQueueThread.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/MaterialAsset.h"
 #include "VideoCommon/Assets/MeshAsset.h"
@@ -32,16 +40,30 @@ public:
   CustomAssetLoader& operator=(const CustomAssetLoader&) = delete;
   CustomAssetLoader& operator=(CustomAssetLoader&&) = delete;
 
-  void Init();
+  // A negative number of load threads picks one from the number of cores, at least one is used
+  void Init(int num_load_threads = -1);
   void Shutdown();
 
+  // Queued loads are started highest priority first, and in the order they were requested
+  // within a priority
+  enum class LoadPriority : u8
+  {
+    // Assets which are expected to be needed soon
+    Low,
+    Normal,
+    // Assets which the current frame is waiting for
+    High,
+  };
+
   // The following Load* functions will load or create an asset associated
   // with the given asset id
   // Loads happen asynchronously where the data will be set now or in the future
   // Callees are expected to query the underlying data with 'GetData()'
   // from the 'CustomLoadableAsset' class to determine if the data is ready for use
-  std::shared_ptr<GameTextureAsset> LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
-                                                    std::shared_ptr<CustomAssetLibrary> library);
+  std::shared_ptr<GameTextureAsset>
+  LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
+                  std::shared_ptr<CustomAssetLibrary> library,
+                  LoadPriority priority = LoadPriority::Normal);
 
   std::shared_ptr<PixelShaderAsset> LoadPixelShader(const CustomAssetLibrary::AssetID& asset_id,
                                                     std::shared_ptr<CustomAssetLibrary> library);
@@ -52,13 +74,45 @@ public:
   std::shared_ptr<MeshAsset> LoadMesh(const CustomAssetLibrary::AssetID& asset_id,
                                       std::shared_ptr<CustomAssetLibrary> library);
 
+  // Game textures are unloaded, least recently used first, when their data takes more memory
+  // than the budget, and are loaded again the next time they are used
+  // A budget of zero only limits them to the memory available for all assets
+  void SetGameTextureMemoryBudget(std::size_t budget);
+
+  // Marks the texture as used, queuing it to be loaded again if it was unloaded, or moving its
+  // load ahead if it was queued with a lower priority
+  // Returns whether its data is loaded
+  bool UseGameTexture(const std::shared_ptr<GameTextureAsset>& asset,
+                      LoadPriority priority = LoadPriority::High);
+
+  struct GameTextureStatistics
+  {
+    std::size_t num_loaded = 0;
+    std::size_t bytes_loaded = 0;
+    u64 num_evicted = 0;
+  };
+  GameTextureStatistics GetGameTextureStatistics();
+
+  // Covers the loads of all assets from the queue, not reloads of changed assets
+  struct LoadStatistics
+  {
+    u64 num_loads = 0;
+    // From when the load was requested until its data was available
+    std::chrono::microseconds total_latency{};
+    std::chrono::microseconds max_latency{};
+    // Spent reading and decoding the data
+    std::chrono::microseconds total_load_time{};
+    std::chrono::microseconds max_load_time{};
+  };
+  LoadStatistics GetLoadStatistics();
+
 private:
   // TODO C++20: use a 'derived_from' concept against 'CustomAsset' when available
   template <typename AssetType>
   std::shared_ptr<AssetType>
   LoadOrCreateAsset(const CustomAssetLibrary::AssetID& asset_id,
                     std::map<CustomAssetLibrary::AssetID, std::weak_ptr<AssetType>>& asset_map,
-                    std::shared_ptr<CustomAssetLibrary> library)
+                    std::shared_ptr<CustomAssetLibrary> library, LoadPriority priority)
   {
     auto [it, inserted] = asset_map.try_emplace(asset_id);
     if (!inserted)
@@ -72,6 +126,7 @@ private:
         std::lock_guard lk(m_asset_load_lock);
         m_total_bytes_loaded -= a->GetByteSizeInMemory();
         m_assets_to_monitor.erase(a->GetAssetId());
+        RemoveGameTexture(a);
         if (m_max_memory_available >= m_total_bytes_loaded && m_memory_exceeded)
         {
           INFO_LOG_FMT(VIDEO, "Asset memory went below limit, new assets can begin loading.");
@@ -81,11 +136,61 @@ private:
       delete a;
     });
     it->second = ptr;
-    m_asset_load_thread.Push(it->second);
+    QueueLoad(it->second, priority);
     return ptr;
   }
 
+  // The state of a game texture which is tracked for its memory budget
+  struct GameTextureResidency
+  {
+    // Where the texture is in 'm_loaded_game_textures', or its end if it isn't loaded
+    std::list<CustomAsset*>::iterator lru_position;
+    bool load_queued = false;
+    // The highest priority that the queued load was requested with
+    LoadPriority queued_priority = LoadPriority::Low;
+    bool loading = false;
+    bool load_failed = false;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedLoad
+  {
+    LoadPriority priority = LoadPriority::Normal;
+    u64 sequence = 0;
+    Clock::time_point queue_time;
+    std::weak_ptr<CustomAsset> asset;
+
+    // The queue takes the greatest load first
+    bool operator<(const QueuedLoad& other) const
+    {
+      if (priority != other.priority)
+        return priority < other.priority;
+      return sequence > other.sequence;
+    }
+  };
+
+  void QueueLoad(std::weak_ptr<CustomAsset> asset, LoadPriority priority);
+  void LoadWorker();
+  // Returns false if the asset shouldn't be loaded after all
+  bool BeginLoad(const CustomAsset* asset);
+  void OnAssetLoaded(const std::shared_ptr<CustomAsset>& asset, bool loaded,
+                     Clock::time_point queue_time, Clock::time_point load_start_time);
+  void QueueGameTextureLoad(const std::shared_ptr<GameTextureAsset>& asset,
+                            GameTextureResidency& residency, LoadPriority priority);
+  void RemoveGameTexture(const CustomAsset* asset);
+  // Unloads the least recently used game textures other than 'keep' until they fit in the budget
+  void EvictGameTextures(const CustomAsset* keep);
+
+  void MonitorAssets();
+  // Returns whether the monitored assets may have changed
+  bool WaitForAssetChanges();
+  void ReloadChangedAssets();
+  void WatchAssetFiles(const CustomAsset& asset);
+
   static constexpr auto TIME_BETWEEN_ASSET_MONITOR_CHECKS = std::chrono::milliseconds{500};
+  // Editors often write a file in several steps, so wait for them to finish before reloading it
+  static constexpr auto TIME_TO_SETTLE_ASSET_CHANGES = std::chrono::milliseconds{50};
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<GameTextureAsset>> m_game_textures;
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<PixelShaderAsset>> m_pixel_shaders;
@@ -94,15 +199,39 @@ private:
   std::thread m_asset_monitor_thread;
   Common::Flag m_asset_monitor_thread_shutdown;
 
+#ifdef __linux__
+  // The assets are only polled for changes when their files can't be watched
+  std::atomic_bool m_poll_for_changes = true;
+  int m_inotify_fd = -1;
+  int m_monitor_wakeup_eventfd = -1;
+  std::set<std::filesystem::path> m_watched_directories;
+#endif
+
   std::size_t m_total_bytes_loaded = 0;
   std::size_t m_max_memory_available = 0;
   std::atomic_bool m_memory_exceeded = false;
 
+  // Loaded game textures, most recently used first
+  std::list<CustomAsset*> m_loaded_game_textures;
+  std::unordered_map<const CustomAsset*, GameTextureResidency> m_game_texture_residency;
+  std::size_t m_game_texture_bytes_loaded = 0;
+  std::size_t m_game_texture_memory_budget = 0;
+  u64 m_num_game_textures_evicted = 0;
+
+  LoadStatistics m_load_statistics;
+
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<CustomAsset>> m_assets_to_monitor;
 
   // Use a recursive mutex to handle the scenario where an asset goes out of scope while
   // iterating over the assets to monitor which calls the lock above in 'LoadOrCreateAsset'
   std::recursive_mutex m_asset_load_lock;
-  Common::WorkQueueThread<std::weak_ptr<CustomAsset>> m_asset_load_thread;
+
+  // Assets are decoded by several threads, so that a large texture doesn't hold up the others
+  std::vector<std::thread> m_load_threads;
+  std::priority_queue<QueuedLoad> m_load_queue;
+  u64 m_next_load_sequence = 0;
+  std::mutex m_load_queue_lock;
+  std::condition_variable m_load_queue_cv;
+  bool m_load_threads_shutdown = false;
 };
 }  // namespace VideoCommon
@@ -75,6 +75,20 @@ DirectFilesystemAssetLibrary::GetLastAssetWriteTime(const AssetID& asset_id) con
   return {};
 }
 
+std::vector<std::filesystem::path>
+DirectFilesystemAssetLibrary::GetAssetFiles(const AssetID& asset_id) const
+{
+  std::vector<std::filesystem::path> files;
+  std::lock_guard lk(m_lock);
+  if (auto iter = m_assetid_to_asset_map_path.find(asset_id);
+      iter != m_assetid_to_asset_map_path.end())
+  {
+    for (const auto& [key, value] : iter->second)
+      files.push_back(value);
+  }
+  return files;
+}
+
 CustomAssetLibrary::LoadInfo DirectFilesystemAssetLibrary::LoadPixelShader(const AssetID& asset_id,
                                                                            PixelShaderData* data)
 {
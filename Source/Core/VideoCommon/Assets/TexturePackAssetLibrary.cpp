@@ -0,0 +1,81 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
+
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+#include "VideoCommon/RenderState.h"
+
+namespace VideoCommon
+{
+bool TexturePackAssetLibrary::Open(const std::string& path)
+{
+  if (!m_file.Open(path))
+    return false;
+
+  std::error_code ec;
+  const auto file_time = std::filesystem::last_write_time(StringToPath(path), ec);
+  if (!ec)
+  {
+    m_write_time = std::chrono::time_point_cast<TimeType::duration>(
+        file_time - decltype(file_time)::clock::now() + std::chrono::system_clock::now());
+  }
+  return true;
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                  TextureData* data)
+{
+  const auto index = m_file.FindTexture(asset_id);
+  if (!index)
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in texture pack!", asset_id);
+    return {};
+  }
+
+  data->m_sampler = RenderState::GetLinearSamplerState();
+  data->m_type = TextureData::Type::Type_Texture2D;
+  if (!m_file.LoadTexture(*index, &data->m_texture))
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture pack data is corrupted!", asset_id);
+    return {};
+  }
+
+  std::size_t size = 0;
+  for (const auto& level : data->m_texture.m_slices[0].m_levels)
+    size += level.data.size();
+  return LoadInfo{size, m_write_time};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadPixelShader(const AssetID& asset_id,
+                                                                      PixelShaderData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                   MaterialData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMesh(const AssetID& asset_id, MeshData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs only contain textures!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::TimeType
+TexturePackAssetLibrary::GetLastAssetWriteTime(const AssetID&) const
+{
+  return m_write_time;
+}
+}  // namespace VideoCommon
@@ -0,0 +1,34 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePackFile.h"
+
+namespace VideoCommon
+{
+// This class implements 'CustomAssetLibrary' and loads textures out of a
+// single texture pack file, using the texture names as asset ids
+class TexturePackAssetLibrary final : public CustomAssetLibrary
+{
+public:
+  bool Open(const std::string& path);
+
+  LoadInfo LoadTexture(const AssetID& asset_id, TextureData* data) override;
+  LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+  LoadInfo LoadMesh(const AssetID& asset_id, MeshData* data) override;
+
+  // The time the pack was written when it was opened, a pack that is being used isn't reloaded
+  TimeType GetLastAssetWriteTime(const AssetID& asset_id) const override;
+
+  const TexturePackFile& GetFile() const { return m_file; }
+
+private:
+  TexturePackFile m_file;
+  TimeType m_write_time = {};
+};
+}  // namespace VideoCommon
@@ -0,0 +1,388 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+
+#include <zstd.h>
+
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/AbstractTexture.h"
+
+namespace VideoCommon
+{
+namespace
+{
+constexpr u32 FILE_ID = 0x4B505444;  // "DTPK" in little endian
+constexpr u32 VERSION_NUMBER = 1;
+
+enum class LevelCompression : u8
+{
+  None = 0,
+  Zstd = 1,
+};
+
+#pragma pack(push, 1)
+
+struct FileHeader
+{
+  u32 file_id;
+  u32 version;
+  u32 num_textures;
+  u32 num_levels;
+  // FileTexture[num_textures], sorted by name hash
+  u64 textures_offset;
+  // FileLevel[num_levels]
+  u64 levels_offset;
+  u64 names_offset;
+  u64 names_size;
+  u8 reserved[16];
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader should be 64 bytes");
+
+struct FileTexture
+{
+  u64 name_hash;
+  u32 name_offset;
+  u32 name_length;
+  u32 first_level;
+  u16 num_levels;
+  u8 has_arbitrary_mipmaps;
+  u8 reserved;
+};
+static_assert(sizeof(FileTexture) == 24, "FileTexture should be 24 bytes");
+
+struct FileLevel
+{
+  u64 offset;
+  u64 stored_size;
+  u64 size;
+  u32 width;
+  u32 height;
+  u32 row_length;
+  u8 format;
+  LevelCompression compression;
+  u8 reserved[2];
+};
+static_assert(sizeof(FileLevel) == 40, "FileLevel should be 40 bytes");
+
+#pragma pack(pop)
+
+// Far larger than any GPU supports, it keeps the level sizes from overflowing
+constexpr u32 MAX_LEVEL_DIMENSION = 65536;
+
+template <typename T>
+T ReadStruct(std::span<const u8> data, std::size_t index)
+{
+  T result;
+  std::memcpy(&result, data.data() + index * sizeof(T), sizeof(T));
+  return result;
+}
+}  // namespace
+
+u64 TexturePackFile::GetNameHash(std::string_view name)
+{
+  return Common::HashXXH3(reinterpret_cast<const u8*>(name.data()), name.size());
+}
+
+u64 TexturePackFile::GetLevelSize(AbstractTextureFormat format, u32 width, u32 height,
+                                  u32 row_length)
+{
+  if (format >= AbstractTextureFormat::Undefined || width == 0 || height == 0 ||
+      row_length < width || row_length > MAX_LEVEL_DIMENSION || height > MAX_LEVEL_DIMENSION)
+  {
+    return 0;
+  }
+
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(format);
+  const u32 block_rows = (height + block_size - 1) / block_size;
+  return u64(AbstractTexture::CalculateStrideForFormat(format, row_length)) * block_rows;
+}
+
+bool TexturePackFile::Open(const std::string& path)
+{
+  m_textures.clear();
+  m_levels.clear();
+  m_names = {};
+  if (!m_file.Open(path))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open texture pack '{}'", path);
+    return false;
+  }
+
+  const auto fail = [&](std::string_view reason) {
+    ERROR_LOG_FMT(VIDEO, "Texture pack '{}' is invalid: {}", path, reason);
+    m_textures.clear();
+    m_levels.clear();
+    m_names = {};
+    m_file.Close();
+    return false;
+  };
+
+  const std::span<const u8> header_data = m_file.GetSpan(0, sizeof(FileHeader));
+  if (header_data.empty())
+    return fail("too small");
+  const FileHeader header = ReadStruct<FileHeader>(header_data, 0);
+  if (header.file_id != FILE_ID)
+    return fail("not a texture pack");
+  if (header.version != VERSION_NUMBER)
+    return fail("unsupported version");
+
+  const std::span<const u8> textures =
+      m_file.GetSpan(header.textures_offset, u64(header.num_textures) * sizeof(FileTexture));
+  const std::span<const u8> levels =
+      m_file.GetSpan(header.levels_offset, u64(header.num_levels) * sizeof(FileLevel));
+  const std::span<const u8> names = m_file.GetSpan(header.names_offset, header.names_size);
+  if ((textures.empty() && header.num_textures != 0) ||
+      (levels.empty() && header.num_levels != 0) || (names.empty() && header.names_size != 0))
+  {
+    return fail("truncated index");
+  }
+  m_names = std::string_view(reinterpret_cast<const char*>(names.data()), names.size());
+
+  m_levels.reserve(header.num_levels);
+  for (u32 i = 0; i < header.num_levels; i++)
+  {
+    const FileLevel level = ReadStruct<FileLevel>(levels, i);
+    if (level.format >= static_cast<u8>(AbstractTextureFormat::Undefined) ||
+        level.compression > LevelCompression::Zstd)
+    {
+      return fail("unknown level format");
+    }
+    // Loading a level decompresses or copies exactly this many bytes, so it can't be made to
+    // allocate more than the texture needs
+    if (level.size != GetLevelSize(static_cast<AbstractTextureFormat>(level.format), level.width,
+                                   level.height, level.row_length))
+    {
+      return fail("level size doesn't match its dimensions");
+    }
+    m_levels.push_back({level.offset, level.stored_size, level.size,
+                        static_cast<AbstractTextureFormat>(level.format), level.width, level.height,
+                        level.row_length, level.compression == LevelCompression::Zstd});
+  }
+
+  m_textures.reserve(header.num_textures);
+  for (u32 i = 0; i < header.num_textures; i++)
+  {
+    const FileTexture texture = ReadStruct<FileTexture>(textures, i);
+    if (u64(texture.name_offset) + texture.name_length > m_names.size() ||
+        texture.num_levels == 0 || u64(texture.first_level) + texture.num_levels > m_levels.size())
+    {
+      return fail("texture out of range");
+    }
+    m_textures.push_back({texture.name_hash,
+                          m_names.substr(texture.name_offset, texture.name_length),
+                          texture.first_level, texture.num_levels,
+                          texture.has_arbitrary_mipmaps != 0});
+  }
+
+  if (!std::is_sorted(m_textures.begin(), m_textures.end(),
+                      [](const Texture& a, const Texture& b) { return a.name_hash < b.name_hash; }))
+  {
+    return fail("index isn't sorted");
+  }
+
+  return true;
+}
+
+std::string_view TexturePackFile::GetTextureName(std::size_t index) const
+{
+  return m_textures[index].name;
+}
+
+bool TexturePackFile::HasArbitraryMipmaps(std::size_t index) const
+{
+  return m_textures[index].has_arbitrary_mipmaps;
+}
+
+std::optional<std::size_t> TexturePackFile::FindTexture(std::string_view name) const
+{
+  const u64 hash = GetNameHash(name);
+  auto it = std::lower_bound(
+      m_textures.begin(), m_textures.end(), hash,
+      [](const Texture& texture, u64 value) { return texture.name_hash < value; });
+  for (; it != m_textures.end() && it->name_hash == hash; ++it)
+  {
+    if (it->name == name)
+      return static_cast<std::size_t>(it - m_textures.begin());
+  }
+  return std::nullopt;
+}
+
+bool TexturePackFile::LoadTexture(std::size_t index, CustomTextureData* data) const
+{
+  const Texture& texture = m_textures[index];
+  data->m_slices.assign(1, {});
+  auto& slice = data->m_slices[0];
+  slice.m_levels.resize(texture.num_levels);
+  for (u32 i = 0; i < texture.num_levels; i++)
+  {
+    const Level& info = m_levels[texture.first_level + i];
+    const std::span<const u8> stored = m_file.GetSpan(info.offset, info.stored_size);
+    if (stored.size() != info.stored_size)
+      return false;
+
+    auto& level = slice.m_levels[i];
+    level.format = info.format;
+    level.width = info.width;
+    level.height = info.height;
+    level.row_length = info.row_length;
+    if (info.compressed)
+    {
+      if (ZSTD_getFrameContentSize(stored.data(), stored.size()) != info.size)
+        return false;
+      level.data.resize(info.size);
+      const std::size_t result =
+          ZSTD_decompress(level.data.data(), level.data.size(), stored.data(), stored.size());
+      if (ZSTD_isError(result) || result != info.size)
+        return false;
+    }
+    else
+    {
+      if (info.stored_size != info.size)
+        return false;
+      level.data.assign(stored.begin(), stored.end());
+    }
+  }
+  return true;
+}
+
+TexturePackWriter::EncodedTexture TexturePackWriter::Encode(std::string name,
+                                                            bool has_arbitrary_mipmaps,
+                                                            const CustomTextureData& data,
+                                                            int compression_level)
+{
+  EncodedTexture result{std::move(name), has_arbitrary_mipmaps, {}, {}};
+  if (data.m_slices.empty())
+    return result;
+
+  for (const auto& level : data.m_slices[0].m_levels)
+  {
+    // The pack wouldn't open with this level, so the texture is left out
+    if (level.data.size() !=
+        TexturePackFile::GetLevelSize(level.format, level.width, level.height, level.row_length))
+    {
+      result.levels.clear();
+      result.level_data.clear();
+      return result;
+    }
+
+    TexturePackFile::Level info{0,           0,            level.data.size(), level.format,
+                                level.width, level.height, level.row_length,  false};
+    std::vector<u8> stored;
+    // Block compressed data is uploaded as it is, and doesn't compress well anyway
+    if (!AbstractTexture::IsCompressedFormat(level.format))
+    {
+      stored.resize(ZSTD_compressBound(level.data.size()));
+      const std::size_t compressed_size =
+          ZSTD_compress(stored.data(), stored.size(), level.data.data(), level.data.size(),
+                        compression_level);
+      info.compressed = !ZSTD_isError(compressed_size) && compressed_size < level.data.size();
+      stored.resize(info.compressed ? compressed_size : 0);
+    }
+    if (!info.compressed)
+      stored = level.data;
+
+    info.stored_size = stored.size();
+    result.levels.push_back(info);
+    result.level_data.push_back(std::move(stored));
+  }
+  return result;
+}
+
+bool TexturePackWriter::Open(const std::string& path)
+{
+  m_textures.clear();
+  m_levels.clear();
+  if (!m_file.Open(path, "wb"))
+    return false;
+
+  // The header is written last, so an incomplete file isn't mistaken for a pack
+  const FileHeader header{};
+  m_position = sizeof(header);
+  return m_file.WriteBytes(&header, sizeof(header));
+}
+
+bool TexturePackWriter::AddTexture(EncodedTexture texture)
+{
+  if (texture.levels.empty() || texture.levels.size() > UINT16_MAX)
+    return false;
+
+  TexturePackFile::Texture entry;
+  entry.name_hash = TexturePackFile::GetNameHash(texture.name);
+  entry.first_level = static_cast<u32>(m_levels.size());
+  entry.num_levels = static_cast<u32>(texture.levels.size());
+  entry.has_arbitrary_mipmaps = texture.has_arbitrary_mipmaps;
+  for (std::size_t i = 0; i < texture.levels.size(); i++)
+  {
+    TexturePackFile::Level& level = texture.levels[i];
+    level.offset = m_position;
+    if (!m_file.WriteBytes(texture.level_data[i].data(), texture.level_data[i].size()))
+      return false;
+    m_position += level.stored_size;
+    m_levels.push_back(level);
+  }
+  m_textures.emplace_back(std::move(texture.name), entry);
+  return true;
+}
+
+bool TexturePackWriter::Close()
+{
+  std::sort(m_textures.begin(), m_textures.end(), [](const auto& a, const auto& b) {
+    return a.second.name_hash < b.second.name_hash;
+  });
+
+  std::string names;
+  std::vector<FileTexture> textures;
+  textures.reserve(m_textures.size());
+  for (const auto& [name, texture] : m_textures)
+  {
+    FileTexture& file_texture = textures.emplace_back();
+    file_texture.name_hash = texture.name_hash;
+    file_texture.name_offset = static_cast<u32>(names.size());
+    file_texture.name_length = static_cast<u32>(name.size());
+    file_texture.first_level = texture.first_level;
+    file_texture.num_levels = static_cast<u16>(texture.num_levels);
+    file_texture.has_arbitrary_mipmaps = texture.has_arbitrary_mipmaps;
+    file_texture.reserved = 0;
+    names += name;
+  }
+
+  std::vector<FileLevel> levels;
+  levels.reserve(m_levels.size());
+  for (const TexturePackFile::Level& level : m_levels)
+  {
+    levels.push_back({level.offset,
+                      level.stored_size,
+                      level.size,
+                      level.width,
+                      level.height,
+                      level.row_length,
+                      static_cast<u8>(level.format),
+                      level.compressed ? LevelCompression::Zstd : LevelCompression::None,
+                      {}});
+  }
+
+  FileHeader header{};
+  header.file_id = FILE_ID;
+  header.version = VERSION_NUMBER;
+  header.num_textures = static_cast<u32>(textures.size());
+  header.num_levels = static_cast<u32>(levels.size());
+  header.textures_offset = m_position;
+  header.levels_offset = header.textures_offset + textures.size() * sizeof(FileTexture);
+  header.names_offset = header.levels_offset + levels.size() * sizeof(FileLevel);
+  header.names_size = names.size();
+
+  const bool success = m_file.WriteArray(textures.data(), textures.size()) &&
+                       m_file.WriteArray(levels.data(), levels.size()) &&
+                       m_file.WriteString(names) && m_file.Seek(0, File::SeekOrigin::Begin) &&
+                       m_file.WriteBytes(&header, sizeof(header));
+  m_textures.clear();
+  m_levels.clear();
+  return m_file.Close() && success;
+}
+}  // namespace VideoCommon
@@ -0,0 +1,107 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+// A texture pack in a single file, so that loading a game's textures doesn't have to search and
+// open thousands of files.
+//
+// The textures are found through an index sorted by the hash of their names. Their levels are
+// stored ready to upload: compressed formats as they are, and others wrapped in zstd, so loading a
+// texture only has to copy or decompress its data out of the mapped file.
+class TexturePackFile
+{
+public:
+  static constexpr std::string_view EXTENSION = ".dtp";
+
+  // Where a level is stored in the file
+  struct Level
+  {
+    u64 offset = 0;
+    u64 stored_size = 0;
+    u64 size = 0;
+    AbstractTextureFormat format = AbstractTextureFormat::RGBA8;
+    u32 width = 0;
+    u32 height = 0;
+    u32 row_length = 0;
+    bool compressed = false;
+  };
+
+  struct Texture
+  {
+    u64 name_hash = 0;
+    std::string_view name;
+    u32 first_level = 0;
+    u32 num_levels = 0;
+    bool has_arbitrary_mipmaps = false;
+  };
+
+  static u64 GetNameHash(std::string_view name);
+  // The size of a level's data, or 0 if its dimensions aren't valid for the format
+  static u64 GetLevelSize(AbstractTextureFormat format, u32 width, u32 height, u32 row_length);
+
+  bool Open(const std::string& path);
+
+  std::size_t GetTextureCount() const { return m_textures.size(); }
+  std::string_view GetTextureName(std::size_t index) const;
+  bool HasArbitraryMipmaps(std::size_t index) const;
+
+  std::optional<std::size_t> FindTexture(std::string_view name) const;
+
+  // Fills a single array slice with the levels of the texture
+  // Safe to call from several threads at once
+  bool LoadTexture(std::size_t index, CustomTextureData* data) const;
+
+private:
+  Common::MappedFile m_file;
+  std::vector<Texture> m_textures;
+  std::vector<Level> m_levels;
+  std::string_view m_names;
+};
+
+// Writes the file read by TexturePackFile. Textures are encoded separately from adding them, so
+// that several can be encoded at the same time.
+class TexturePackWriter
+{
+public:
+  struct EncodedTexture
+  {
+    std::string name;
+    bool has_arbitrary_mipmaps = false;
+    // The offsets of the levels are assigned when the texture is added
+    std::vector<TexturePackFile::Level> levels;
+    std::vector<std::vector<u8>> level_data;
+  };
+
+  // Only the first array slice is stored, as game textures only have one
+  // No levels are returned if the size of a level's data doesn't match its dimensions
+  // Safe to call from several threads at once
+  static EncodedTexture Encode(std::string name, bool has_arbitrary_mipmaps,
+                               const CustomTextureData& data, int compression_level);
+
+  bool Open(const std::string& path);
+  bool AddTexture(EncodedTexture texture);
+  // Writes the index, the file is incomplete until this succeeds
+  bool Close();
+
+private:
+  File::IOFile m_file;
+  u64 m_position = 0;
+  std::vector<std::pair<std::string, TexturePackFile::Texture>> m_textures;
+  std::vector<TexturePackFile::Level> m_levels;
+};
+}  // namespace VideoCommon
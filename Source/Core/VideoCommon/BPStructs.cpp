@@ -37,6 +37,7 @@
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -54,6 +55,38 @@ void BPInit()
   bpmem.bpMask = 0xFFFFFF;
 }
 
+// Registers which only hold parameters for EFB copies, clears, TMEM preloads and TLUT loads, or for
+// the next BP write. The commands which read them flush the pipeline themselves, so writing these
+// doesn't affect the pending draws.
+static bool IsCommandParameter(u8 address)
+{
+  switch (address)
+  {
+  case BPMEM_DISPLAYCOPYFILTER:
+  case BPMEM_DISPLAYCOPYFILTER + 1:
+  case BPMEM_DISPLAYCOPYFILTER + 2:
+  case BPMEM_DISPLAYCOPYFILTER + 3:
+  case BPMEM_EFB_TL:
+  case BPMEM_EFB_WH:
+  case BPMEM_EFB_ADDR:
+  case BPMEM_EFB_STRIDE:
+  case BPMEM_COPYYSCALE:
+  case BPMEM_CLEAR_AR:
+  case BPMEM_CLEAR_GB:
+  case BPMEM_CLEAR_Z:
+  case BPMEM_COPYFILTER0:
+  case BPMEM_COPYFILTER1:
+  case BPMEM_PRELOAD_ADDR:
+  case BPMEM_PRELOAD_TMEMEVEN:
+  case BPMEM_PRELOAD_TMEMODD:
+  case BPMEM_LOADTLUT0:
+  case BPMEM_BP_MASK:
+    return true;
+  default:
+    return false;
+  }
+}
+
 static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager& xf_state_manager,
                       GeometryShaderManager& geometry_shader_manager, const BPCmd& bp,
                       int cycles_into_future)
@@ -88,11 +121,16 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
           bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
           bp.address == BPMEM_CLEAR_PIXEL_PERF))
     {
+      if (g_vertex_manager->HasSendableVertices())
+        INCSTAT(g_stats.this_frame.num_redundant_state_writes);
       return;
     }
   }
 
-  FlushPipeline();
+  if (!IsCommandParameter(bp.address))
+    FlushPipeline();
+  else if (g_vertex_manager->HasSendableVertices())
+    INCSTAT(g_stats.this_frame.num_redundant_state_writes);
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
 
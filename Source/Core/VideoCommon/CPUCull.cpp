@@ -3,13 +3,18 @@
 
 #include "VideoCommon/CPUCull.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Timer.h"
 #include "Core/System.h"
 
 #include "VideoCommon/CPMemory.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -30,12 +35,15 @@
 #pragma GCC diagnostic pop
 #endif
 
+// The scalar functions are built on every platform, as the reference for the vector ones.
+#define NO_SIMD
+#include "VideoCommon/CPUCullImpl.h"
+#undef NO_SIMD
+
 #if defined(_M_X86) || defined(_M_X86_64)
 #define USE_SSE
 #elif defined(_M_ARM_64)
 #define USE_NEON
-#else
-#define NO_SIMD
 #endif
 
 #if defined(USE_SSE)
@@ -44,7 +52,9 @@
 #include <arm_neon.h>
 #endif
 
+#if defined(USE_SSE) || defined(USE_NEON)
 #include "VideoCommon/CPUCullImpl.h"
+#endif
 #ifdef USE_SSE
 #define USE_SSE3
 #include "VideoCommon/CPUCullImpl.h"
@@ -54,10 +64,14 @@
 #include "VideoCommon/CPUCullImpl.h"
 #define USE_FMA
 #include "VideoCommon/CPUCullImpl.h"
+#define USE_AVX512
+#include "VideoCommon/CPUCullImpl.h"
 #endif
 
 #if defined(USE_SSE)
-#if defined(__AVX__) && defined(__FMA__)
+#if defined(__AVX512F__) && defined(__FMA__)
+static constexpr int MIN_SSE = 60;
+#elif defined(__AVX__) && defined(__FMA__)
 static constexpr int MIN_SSE = 51;
 #elif defined(__AVX__)
 static constexpr int MIN_SSE = 50;
@@ -70,11 +84,23 @@ static constexpr int MIN_SSE = 0;
 #endif
 #endif
 
+// Large draws are split into chunks of this many vertices for the culling threads. A multiple of
+// 12, so that the chunks start on whole triangles and quads and the transformed vertices of each
+// chunk stay aligned for the vector stores.
+constexpr u32 PARALLEL_CHUNK_VERTICES = 1536;
+
+// Smaller draws are culled on the GPU thread alone, as waking up the workers would take longer.
+constexpr u32 PARALLEL_MIN_VERTICES = 4096;
+
 template <bool PositionHas3Elems, bool PerVertexPosMtx>
-static CPUCull::TransformFunction GetTransformFunction()
+static CPUCull::TransformFunction GetTransformFunction(bool scalar)
 {
+  if (scalar)
+    return CPUCull_Scalar::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
 #if defined(USE_SSE)
-  if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
+  if (!PerVertexPosMtx && (MIN_SSE >= 60 || (cpu_info.bAVX512F && cpu_info.bFMA)))
+    return CPUCull_AVX512::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+  else if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
     return CPUCull_FMA::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
   else if (MIN_SSE >= 50 || cpu_info.bAVX)
     return CPUCull_AVX::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
@@ -92,8 +118,10 @@ static CPUCull::TransformFunction GetTransformFunction()
 }
 
 template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
-static CPUCull::CullFunction GetCullFunction0()
+static CPUCull::CullFunction GetCullFunction0(bool scalar)
 {
+  if (scalar)
+    return CPUCull_Scalar::AreAllVerticesCulled<Primitive, Mode>;
 #if defined(USE_SSE)
   // Note: AVX version only actually AVX on compilers that support __attribute__((target))
   // Sorry, MSVC + Sandy Bridge.  (Ivy+ and AMD see very little benefit thanks to mov elimination)
@@ -111,13 +139,13 @@ static CPUCull::CullFunction GetCullFunction0()
 }
 
 template <OpcodeDecoder::Primitive Primitive>
-static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1()
+static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1(bool scalar)
 {
   return {
-      GetCullFunction0<Primitive, CullMode::None>(),
-      GetCullFunction0<Primitive, CullMode::Back>(),
-      GetCullFunction0<Primitive, CullMode::Front>(),
-      GetCullFunction0<Primitive, CullMode::All>(),
+      GetCullFunction0<Primitive, CullMode::None>(scalar),
+      GetCullFunction0<Primitive, CullMode::Back>(scalar),
+      GetCullFunction0<Primitive, CullMode::Front>(scalar),
+      GetCullFunction0<Primitive, CullMode::All>(scalar),
   };
 }
 
@@ -125,16 +153,33 @@ CPUCull::~CPUCull() = default;
 
 void CPUCull::Init()
 {
-  m_transform_table[false][false] = GetTransformFunction<false, false>();
-  m_transform_table[false][true] = GetTransformFunction<false, true>();
-  m_transform_table[true][false] = GetTransformFunction<true, false>();
-  m_transform_table[true][true] = GetTransformFunction<true, true>();
+  InitTables(false);
+}
+
+void CPUCull::InitScalar()
+{
+  InitTables(true);
+}
+
+void CPUCull::InitTables(bool scalar)
+{
+  m_transform_table[false][false] = GetTransformFunction<false, false>(scalar);
+  m_transform_table[false][true] = GetTransformFunction<false, true>(scalar);
+  m_transform_table[true][false] = GetTransformFunction<true, false>(scalar);
+  m_transform_table[true][true] = GetTransformFunction<true, true>(scalar);
   using Prim = OpcodeDecoder::Primitive;
-  m_cull_table[Prim::GX_DRAW_QUADS] = GetCullFunction1<Prim::GX_DRAW_QUADS>();
-  m_cull_table[Prim::GX_DRAW_QUADS_2] = GetCullFunction1<Prim::GX_DRAW_QUADS>();
-  m_cull_table[Prim::GX_DRAW_TRIANGLES] = GetCullFunction1<Prim::GX_DRAW_TRIANGLES>();
-  m_cull_table[Prim::GX_DRAW_TRIANGLE_STRIP] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
-  m_cull_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
+  m_cull_table[Prim::GX_DRAW_QUADS] = GetCullFunction1<Prim::GX_DRAW_QUADS>(scalar);
+  m_cull_table[Prim::GX_DRAW_QUADS_2] = GetCullFunction1<Prim::GX_DRAW_QUADS>(scalar);
+  m_cull_table[Prim::GX_DRAW_TRIANGLES] = GetCullFunction1<Prim::GX_DRAW_TRIANGLES>(scalar);
+  m_cull_table[Prim::GX_DRAW_TRIANGLE_STRIP] =
+      GetCullFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>(scalar);
+  m_cull_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_FAN>(scalar);
+}
+
+void CPUCull::SetNumThreads(u32 num_threads)
+{
+  if (num_threads != m_pool.GetNumWorkers())
+    m_pool.Reset("CPU Culling", num_threads);
 }
 
 bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
@@ -142,16 +187,6 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
 {
   ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
              "CPUCull should not be called on lines or points");
-  const u32 stride = loader->m_native_vtx_decl.stride;
-  const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
-  const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
-  if (m_transform_buffer_size < count) [[unlikely]]
-  {
-    u32 new_size = MathUtil::NextPowerOf2(count);
-    m_transform_buffer_size = new_size;
-    m_transform_buffer.reset(static_cast<TransformedVertex*>(
-        Common::AllocateAlignedMemory(new_size * sizeof(TransformedVertex), 32)));
-  }
 
   // transform functions need the projection matrix to tranform to clip space
   auto& system = Core::System::GetInstance();
@@ -163,12 +198,82 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
   CullMode cullmode = bpmem.genMode.cullmode;
   if (xfmem.viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
     cullmode = cullmode_invert[cullmode];
-  const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
-  transform(m_transform_buffer.get(), src, stride, count);
+
+  // Reading the clock costs more than culling a small draw, so only do it for the statistics.
+  const bool measure_time = g_ActiveConfig.bOverlayStats;
+  const u64 start_time = measure_time ? Common::Timer::NowUs() : 0;
+  const bool culled = TransformAndCull(primitive, cullmode,
+                                       loader->m_native_vtx_decl.position.components >= 3,
+                                       loader->m_native_vtx_decl.posmtx.enable, src,
+                                       loader->m_native_vtx_decl.stride, count);
+
+  INCSTAT(g_stats.this_frame.num_cpu_cull_draws);
+  if (culled)
+  {
+    INCSTAT(g_stats.this_frame.num_cpu_culled_draws);
+    ADDSTAT(g_stats.this_frame.num_cpu_culled_vertices, count);
+  }
+  if (measure_time)
+  {
+    ADDSTAT(g_stats.this_frame.cpu_cull_time_us,
+            static_cast<int>(Common::Timer::NowUs() - start_time));
+  }
+  return culled;
+}
+
+bool CPUCull::TransformAndCull(OpcodeDecoder::Primitive primitive, CullMode cullmode,
+                               bool pos_has_3_elems, bool per_vertex_posmtx, const u8* src,
+                               u32 stride, u32 count)
+{
+  if (m_transform_buffer_size < count) [[unlikely]]
+  {
+    u32 new_size = MathUtil::NextPowerOf2(count);
+    m_transform_buffer_size = new_size;
+    m_transform_buffer.reset(static_cast<TransformedVertex*>(
+        Common::AllocateAlignedMemory(new_size * sizeof(TransformedVertex), 64)));
+  }
+
+  const TransformFunction transform = m_transform_table[pos_has_3_elems][per_vertex_posmtx];
   const CullFunction cull = m_cull_table[primitive][cullmode];
+  if (count >= PARALLEL_MIN_VERTICES && m_pool.GetNumWorkers() != 0)
+    return AreAllVerticesCulledParallel(transform, cull, primitive, src, stride, count);
+
+  transform(m_transform_buffer.get(), src, stride, count);
   return cull(m_transform_buffer.get(), count);
 }
 
+bool CPUCull::AreAllVerticesCulledParallel(TransformFunction transform, CullFunction cull,
+                                           OpcodeDecoder::Primitive primitive, const u8* src,
+                                           u32 stride, u32 count)
+{
+  TransformedVertex* const transformed = m_transform_buffer.get();
+  const size_t num_chunks = (count + PARALLEL_CHUNK_VERTICES - 1) / PARALLEL_CHUNK_VERTICES;
+  m_pool.ParallelFor(num_chunks, [&](size_t chunk) {
+    const u32 first = static_cast<u32>(chunk) * PARALLEL_CHUNK_VERTICES;
+    const u32 chunk_count = std::min(count - first, PARALLEL_CHUNK_VERTICES);
+    transform(transformed + first, src + first * stride, stride, static_cast<int>(chunk_count));
+  });
+
+  // Every triangle of a fan uses the first vertex, so they can't be split.
+  if (primitive == OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN)
+    return cull(transformed, static_cast<int>(count));
+
+  // The triangles of a chunk of a strip also use the first two vertices of the next chunk. As the
+  // chunks start at even vertices, the winding of their first triangle matches the whole strip.
+  const u32 overlap = primitive == OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_STRIP ? 2 : 0;
+  std::atomic<bool> visible = false;
+  m_pool.ParallelFor(num_chunks, [&](size_t chunk) {
+    if (visible.load(std::memory_order_relaxed))
+      return;
+
+    const u32 first = static_cast<u32>(chunk) * PARALLEL_CHUNK_VERTICES;
+    const u32 chunk_count = std::min(count - first, PARALLEL_CHUNK_VERTICES + overlap);
+    if (!cull(transformed + first, static_cast<int>(chunk_count)))
+      visible.store(true, std::memory_order_relaxed);
+  });
+  return !visible.load(std::memory_order_relaxed);
+}
+
 template <typename T>
 void CPUCull::BufferDeleter<T>::operator()(T* ptr)
 {
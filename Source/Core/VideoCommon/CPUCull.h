@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "Common/ThreadPool.h"
+
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -11,10 +13,23 @@ class CPUCull
 {
 public:
   ~CPUCull();
+
+  // Picks the fastest transform and cull functions the CPU supports.
   void Init();
+  // Picks the scalar transform and cull functions, which the vector ones are checked against.
+  void InitScalar();
+
+  // Sets the number of worker threads which help the GPU thread with large draws.
+  void SetNumThreads(u32 num_threads);
+
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
 
+  // Transforms the positions with the current projection and position matrices, and checks whether
+  // all primitives are culled by cullmode.
+  bool TransformAndCull(OpcodeDecoder::Primitive primitive, CullMode cullmode, bool pos_has_3_elems,
+                        bool per_vertex_posmtx, const u8* src, u32 stride, u32 count);
+
   struct alignas(16) TransformedVertex
   {
     float x, y, z, w;
@@ -24,6 +39,13 @@ public:
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
 
 private:
+  void InitTables(bool scalar);
+
+  // Transforms and culls chunks of the draw on the worker threads.
+  bool AreAllVerticesCulledParallel(TransformFunction transform, CullFunction cull,
+                                    OpcodeDecoder::Primitive primitive, const u8* src, u32 stride,
+                                    u32 count);
+
   template <typename T>
   struct BufferDeleter
   {
@@ -35,4 +57,5 @@ private:
   Common::EnumMap<Common::EnumMap<CullFunction, CullMode::All>,
                   OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
       m_cull_table{};
+  Common::ThreadPool m_pool;
 };
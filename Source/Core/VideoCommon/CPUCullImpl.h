@@ -1,7 +1,9 @@
 // Copyright 2022 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#if defined(USE_FMA)
+#if defined(USE_AVX512)
+#define VECTOR_NAMESPACE CPUCull_AVX512
+#elif defined(USE_FMA)
 #define VECTOR_NAMESPACE CPUCull_FMA
 #elif defined(USE_AVX)
 #define VECTOR_NAMESPACE CPUCull_AVX
@@ -19,7 +21,9 @@
 #error This file is meant to be used by CPUCull.cpp only!
 #endif
 
-#if defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
+#if defined(__GNUC__) && defined(USE_AVX512) && !(defined(__AVX512F__) && defined(__FMA__))
+#define ATTR_TARGET __attribute__((target("avx512f,fma")))
+#elif defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
 #define ATTR_TARGET __attribute__((target("avx,fma")))
 #elif defined(__GNUC__) && defined(USE_AVX) && !defined(__AVX__)
 #define ATTR_TARGET __attribute__((target("avx")))
@@ -236,6 +240,76 @@ LoadTransform2Vertices(const u8* v0data, const u8* v1data,                  //
 
 #endif
 
+#ifdef USE_AVX512
+template <int i>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 vector_broadcast(__m512 v)
+{
+  return _mm512_permute_ps(v, _MM_SHUFFLE(i, i, i, i));
+}
+
+// Copies a YMM register to both halves of a ZMM register.
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 WidenYMM(__m256 v)
+{
+  return _mm512_castpd_ps(_mm512_broadcast_f64x4(_mm256_castps_pd(v)));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 Load4x128(const void* v0, const void* v1,
+                                                         const void* v2, const void* v3)
+{
+  __m512 output = _mm512_castps128_ps512(_mm_loadu_ps(static_cast<const float*>(v0)));
+  output = _mm512_insertf32x4(output, _mm_loadu_ps(static_cast<const float*>(v1)), 1);
+  output = _mm512_insertf32x4(output, _mm_loadu_ps(static_cast<const float*>(v2)), 2);
+  return _mm512_insertf32x4(output, _mm_loadu_ps(static_cast<const float*>(v3)), 3);
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 Load4x64(const void* v0, const void* v1,
+                                                        const void* v2, const void* v3)
+{
+  const auto load = [](const void* v) {
+    return _mm_castpd_ps(_mm_load_sd(static_cast<const double*>(v)));
+  };
+  __m512 output = _mm512_castps128_ps512(load(v0));
+  output = _mm512_insertf32x4(output, load(v1), 1);
+  output = _mm512_insertf32x4(output, load(v2), 2);
+  return _mm512_insertf32x4(output, load(v3), 3);
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 ApplyMatrixZMM(__m512 v, __m512 m0, __m512 m1,
+                                                              __m512 m2, __m512 m3)
+{
+  __m512 output = _mm512_mul_ps(vector_broadcast<0>(v), m0);
+  output = _mm512_fmadd_ps(vector_broadcast<1>(v), m1, output);
+  output = _mm512_fmadd_ps(vector_broadcast<2>(v), m2, output);
+  output = _mm512_fmadd_ps(vector_broadcast<3>(v), m3, output);
+  return output;
+}
+
+// Transforms four vertices without per-vertex position matrices, one per 128-bit lane. The
+// operations are the same as for the FMA version, so that the results are identical. With
+// per-vertex matrices, gathering the matrices takes longer than the transform itself, so those
+// are left to the FMA version.
+template <bool PositionHas3Elems>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512
+LoadTransform4Vertices(const u8* data, u32 stride,                          //
+                       __m512 pos0, __m512 pos1, __m512 pos2, __m512 pos3,  //
+                       __m512 proj0, __m512 proj1, __m512 proj2, __m512 proj3)
+{
+  __m512 vertices;
+  if constexpr (PositionHas3Elems)
+    vertices = Load4x128(data, data + stride, data + stride * 2, data + stride * 3);
+  else
+    vertices = Load4x64(data, data + stride, data + stride * 2, data + stride * 3);
+
+  __m512 output = pos3;  // vertex.w is always 1.0
+  output = _mm512_fmadd_ps(vector_broadcast<0>(vertices), pos0, output);
+  output = _mm512_fmadd_ps(vector_broadcast<1>(vertices), pos1, output);
+  if constexpr (PositionHas3Elems)
+    output = _mm512_fmadd_ps(vector_broadcast<2>(vertices), pos2, output);
+
+  return ApplyMatrixZMM(output, proj0, proj1, proj2, proj3);
+}
+#endif
+
 #ifndef USE_AVX
 // Note: Assumes 16-byte aligned source
 ATTR_TARGET DOLPHIN_FORCE_INLINE static void LoadTransposed(const void* source, Vector& o0,
@@ -517,7 +591,22 @@ ATTR_TARGET static void TransformVertices(void* output, const void* vertices, u3
   __m256 pos0, pos1, pos2, pos3;
   LoadTransposedYMM(vsmanager.constants.projection.data(), proj0, proj1, proj2, proj3);
   LoadTransposedPosYMM(&xfmem.posMatrices[idx * 4], pos0, pos1, pos2, pos3);
-  for (int i = 1; i < count; i += 2)
+  int i = 0;
+#ifdef USE_AVX512
+  const __m512 zproj0 = WidenYMM(proj0), zproj1 = WidenYMM(proj1);
+  const __m512 zproj2 = WidenYMM(proj2), zproj3 = WidenYMM(proj3);
+  const __m512 zpos0 = WidenYMM(pos0), zpos1 = WidenYMM(pos1);
+  const __m512 zpos2 = WidenYMM(pos2), zpos3 = WidenYMM(pos3);
+  for (; !PerVertexPosMtx && i + 4 <= count; i += 4)
+  {
+    __m512 v0123 = LoadTransform4Vertices<PositionHas3Elems>(
+        cvertices, stride, zpos0, zpos1, zpos2, zpos3, zproj0, zproj1, zproj2, zproj3);
+    _mm512_store_ps(reinterpret_cast<float*>(voutput), v0123);
+    cvertices += stride * 4;
+    voutput += 4;
+  }
+#endif
+  for (; i + 2 <= count; i += 2)
   {
     const u8* v0data = cvertices;
     const u8* v1data = cvertices + stride;
@@ -527,7 +616,7 @@ ATTR_TARGET static void TransformVertices(void* output, const void* vertices, u3
     cvertices += stride * 2;
     voutput += 2;
   }
-  if (count & 1)
+  if (i < count)
   {
     *voutput = LoadTransformVertex<PositionHas3Elems, PerVertexPosMtx>(
         cvertices,                                                     //
@@ -13,6 +13,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/TraceRecorder.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -28,6 +29,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -57,6 +59,8 @@ void FifoManager::DoState(PointerWrap& p)
   p.DoPointer(write_ptr, m_video_buffer);
   m_video_buffer_write_ptr = write_ptr;
   p.DoPointer(m_video_buffer_read_ptr, m_video_buffer);
+  if (p.IsReadMode())
+    m_incomplete_command_ptr = nullptr;
   if (p.IsReadMode() && m_use_deterministic_gpu_thread)
   {
     // We're good and paused, right?
@@ -111,6 +115,7 @@ void FifoManager::Shutdown()
   m_video_buffer_pp_read_ptr = nullptr;
   m_video_buffer_read_ptr = nullptr;
   m_video_buffer_seen_ptr = nullptr;
+  m_incomplete_command_ptr = nullptr;
   m_fifo_aux_write_ptr = nullptr;
   m_fifo_aux_read_ptr = nullptr;
 
@@ -179,6 +184,7 @@ void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
       m_video_buffer_write_ptr = write_ptr = m_video_buffer + size;
       m_video_buffer_pp_read_ptr = m_video_buffer;
       m_video_buffer_read_ptr = m_video_buffer;
+      m_incomplete_command_ptr = nullptr;
       m_video_buffer_seen_ptr = write_ptr;
     }
   }
@@ -228,6 +234,8 @@ void FifoManager::ReadDataFromFifo(u32 read_ptr)
     }
     memmove(m_video_buffer, m_video_buffer_read_ptr, existing_len);
     m_video_buffer_write_ptr = m_video_buffer + existing_len;
+    if (m_incomplete_command_ptr == m_video_buffer_read_ptr)
+      m_incomplete_command_ptr = m_video_buffer;
     m_video_buffer_read_ptr = m_video_buffer;
   }
   // Copy new video instructions to m_video_buffer for future use in rendering the new picture
@@ -236,6 +244,25 @@ void FifoManager::ReadDataFromFifo(u32 read_ptr)
   m_video_buffer_write_ptr += GPFifo::GATHER_PIPE_SIZE;
 }
 
+// Runs the commands between the read pointer and write_ptr. Large primitives span many FIFO
+// blocks, so if the command which stopped the last run still hasn't fully arrived, this returns
+// without scanning it again.
+u32 FifoManager::RunVideoBuffer(u8* write_ptr)
+{
+  if (m_video_buffer_read_ptr == m_incomplete_command_ptr &&
+      static_cast<u32>(write_ptr - m_video_buffer_read_ptr) < m_incomplete_command_size)
+  {
+    INCSTAT(g_stats.this_frame.num_fifo_runs_deferred);
+    return 0;
+  }
+
+  u32 cycles = 0;
+  m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr),
+                                                   &cycles, &m_incomplete_command_size);
+  m_incomplete_command_ptr = m_video_buffer_read_ptr;
+  return cycles;
+}
+
 // The deterministic_gpu_thread version.
 void FifoManager::ReadDataFromFifoOnCPU(u32 read_ptr)
 {
@@ -276,6 +303,7 @@ void FifoManager::ReadDataFromFifoOnCPU(u32 read_ptr)
 void FifoManager::ResetVideoBuffer()
 {
   m_video_buffer_read_ptr = m_video_buffer;
+  m_incomplete_command_ptr = nullptr;
   m_video_buffer_write_ptr = m_video_buffer;
   m_video_buffer_seen_ptr = m_video_buffer;
   m_video_buffer_pp_read_ptr = m_video_buffer;
@@ -299,6 +327,7 @@ void FifoManager::RunGpuLoop()
         if (!m_emu_running_state.IsSet())
           return;
 
+        TRACE_ZONE("Fifo::RunGpuLoop");
         if (m_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
@@ -307,6 +336,7 @@ void FifoManager::RunGpuLoop()
           // See comment in SyncGPU
           if (write_ptr > seen_ptr)
           {
+            INCSTAT(g_stats.this_frame.num_fifo_batches);
             m_video_buffer_read_ptr =
                 OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr), nullptr);
             m_video_buffer_seen_ptr = write_ptr;
@@ -319,6 +349,7 @@ void FifoManager::RunGpuLoop()
           command_processor.SetCPStatusFromGPU();
 
           // check if we are able to run this buffer
+          bool woke_for_data = false;
           while (!command_processor.IsInterruptWaiting() &&
                  fifo.bFF_GPReadEnable.load(std::memory_order_relaxed) &&
                  fifo.CPReadWriteDistance.load(std::memory_order_relaxed) &&
@@ -327,7 +358,12 @@ void FifoManager::RunGpuLoop()
             if (m_config_sync_gpu && m_sync_ticks.load() < m_config_sync_gpu_min_distance)
               break;
 
-            u32 cyclesExecuted = 0;
+            if (!woke_for_data)
+            {
+              woke_for_data = true;
+              INCSTAT(g_stats.this_frame.num_fifo_batches);
+            }
+
             u32 readPtr = fifo.CPReadPointer.load(std::memory_order_relaxed);
             ReadDataFromFifo(readPtr);
 
@@ -345,8 +381,7 @@ void FifoManager::RunGpuLoop()
                        distance);
 
             u8* write_ptr = m_video_buffer_write_ptr;
-            m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-                DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            u32 cyclesExecuted = RunVideoBuffer(write_ptr);
 
             fifo.CPReadPointer.store(readPtr, std::memory_order_relaxed);
             fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
@@ -446,6 +481,7 @@ int FifoManager::RunGpuOnCpu(int ticks)
   auto& fifo = command_processor.GetFifo();
   bool reset_simd_state = false;
   int available_ticks = int(ticks * m_config_sync_gpu_overclock) + m_sync_ticks.load();
+  bool ran_batch = false;
   while (fifo.bFF_GPReadEnable.load(std::memory_order_relaxed) &&
          fifo.CPReadWriteDistance.load(std::memory_order_relaxed) && !AtBreakpoint(m_system) &&
          available_ticks >= 0)
@@ -463,11 +499,13 @@ int FifoManager::RunGpuOnCpu(int ticks)
         Common::FPU::LoadDefaultSIMDState();
         reset_simd_state = true;
       }
+      if (!ran_batch)
+      {
+        ran_batch = true;
+        INCSTAT(g_stats.this_frame.num_fifo_batches);
+      }
       ReadDataFromFifo(fifo.CPReadPointer.load(std::memory_order_relaxed));
-      u32 cycles = 0;
-      m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-          DataReader(m_video_buffer_read_ptr, m_video_buffer_write_ptr), &cycles);
-      available_ticks -= cycles;
+      available_ticks -= RunVideoBuffer(m_video_buffer_write_ptr);
     }
 
     if (fifo.CPReadPointer.load(std::memory_order_relaxed) ==
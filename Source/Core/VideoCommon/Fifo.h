@@ -79,6 +79,7 @@ private:
   void RefreshConfig();
   void ReadDataFromFifo(u32 read_ptr);
   void ReadDataFromFifoOnCPU(u32 read_ptr);
+  u32 RunVideoBuffer(u8* write_ptr);
   int RunGpuOnCpu(int ticks);
   int WaitForGpuThread(int ticks);
   static void SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate);
@@ -118,6 +119,11 @@ private:
   // polls, it's just atomic.
   // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
+  // The size of the incomplete command at m_incomplete_command_ptr, which stopped the last run of
+  // the video buffer. Decoding isn't retried until all of it has been read from the FIFO.
+  u8* m_incomplete_command_ptr = nullptr;
+  u32 m_incomplete_command_size = 0;
+
   std::atomic<int> m_sync_ticks = 0;
   bool m_syncing_suspended = false;
   Common::Event m_sync_wakeup_event;
@@ -49,7 +49,8 @@ struct FrameDumpContext
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
   AVFrame* scaled_frame = nullptr;
-  SwsContext* sws = nullptr;
+  FrameDumpScaler scaler;
+  int num_scaler_threads = 1;
 
   s64 last_pts = AV_NOPTS_VALUE;
 
@@ -160,6 +161,74 @@ std::string AVErrorString(int error)
 
 }  // namespace
 
+FrameDumpScaler::~FrameDumpScaler()
+{
+  sws_freeContext(m_sws);
+}
+
+bool FrameDumpScaler::Convert(const FrameData& frame, AVFrame* src, AVFrame* dst, int num_threads)
+{
+  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
+
+  src->data[0] = const_cast<u8*>(frame.data);
+  src->linesize[0] = frame.stride;
+  src->format = pix_fmt;
+  src->width = frame.width;
+  src->height = frame.height;
+
+  if (m_sws && (m_src_width != frame.width || m_src_height != frame.height ||
+                m_dst_width != dst->width || m_dst_height != dst->height ||
+                m_dst_format != dst->format || m_num_threads != num_threads))
+  {
+    sws_freeContext(m_sws);
+    m_sws = nullptr;
+  }
+
+  if (!m_sws)
+  {
+    m_src_width = frame.width;
+    m_src_height = frame.height;
+    m_dst_width = dst->width;
+    m_dst_height = dst->height;
+    m_dst_format = dst->format;
+    m_num_threads = num_threads;
+
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+    m_sws = sws_alloc_context();
+    if (!m_sws)
+      return false;
+    if (av_opt_set_int(m_sws, "srcw", frame.width, 0) < 0 ||
+        av_opt_set_int(m_sws, "srch", frame.height, 0) < 0 ||
+        av_opt_set_int(m_sws, "src_format", pix_fmt, 0) < 0 ||
+        av_opt_set_int(m_sws, "dstw", dst->width, 0) < 0 ||
+        av_opt_set_int(m_sws, "dsth", dst->height, 0) < 0 ||
+        av_opt_set_int(m_sws, "dst_format", dst->format, 0) < 0 ||
+        av_opt_set_int(m_sws, "sws_flags", SWS_BICUBIC, 0) < 0 ||
+        av_opt_set_int(m_sws, "threads", num_threads, 0) < 0 ||
+        sws_init_context(m_sws, nullptr, nullptr) < 0)
+    {
+      sws_freeContext(m_sws);
+      m_sws = nullptr;
+      return false;
+    }
+#else
+    m_sws = sws_getContext(frame.width, frame.height, pix_fmt, dst->width, dst->height,
+                           static_cast<AVPixelFormat>(dst->format), SWS_BICUBIC, nullptr, nullptr,
+                           nullptr);
+    if (!m_sws)
+      return false;
+#endif
+  }
+
+  // Convert image from RGBA to desired pixel format.
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+  // Only sws_scale_frame splits the frame between the scaler's threads.
+  return sws_scale_frame(m_sws, dst, src) >= 0;
+#else
+  return sws_scale(m_sws, src->data, src->linesize, 0, frame.height, dst->data, dst->linesize) >= 0;
+#endif
+}
+
 bool FFMpegFrameDump::Start(int w, int h, u64 start_ticks)
 {
   if (IsStarted())
@@ -309,6 +378,8 @@ bool FFMpegFrameDump::CreateVideoFile()
   if (av_frame_get_buffer(m_context->scaled_frame, 1))
     return false;
 
+  m_context->num_scaler_threads = static_cast<int>(g_Config.GetFrameDumpConversionThreads());
+
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
       avcodec_parameters_from_context(m_context->stream->codecpar, m_context->codec) < 0)
@@ -343,17 +414,17 @@ bool FFMpegFrameDump::IsFirstFrameInCurrentFile() const
   return m_context->last_pts == AV_NOPTS_VALUE;
 }
 
-void FFMpegFrameDump::AddFrame(const FrameData& frame)
+bool FFMpegFrameDump::AddFrame(const FrameData& frame)
 {
   // Are we even dumping?
   if (!IsStarted())
-    return;
+    return false;
 
   CheckForConfigChange(frame);
 
   // Handle failure after a config change.
   if (!IsStarted())
-    return;
+    return false;
 
   // Calculate presentation timestamp from ticks since start.
   const s64 pts = av_rescale_q(
@@ -366,7 +437,7 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
     if (pts <= m_context->last_pts)
     {
       WARN_LOG_FMT(FRAMEDUMP, "PTS delta < 1. Current frame will not be dumped.");
-      return;
+      return false;
     }
     else if (pts > m_context->last_pts + 1 && !m_context->gave_vfr_warning)
     {
@@ -376,23 +447,7 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
     }
   }
 
-  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
-
-  m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
-  m_context->src_frame->linesize[0] = frame.stride;
-  m_context->src_frame->format = pix_fmt;
-  m_context->src_frame->width = m_context->width;
-  m_context->src_frame->height = m_context->height;
-
-  // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
-  {
-    sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
-  }
+  ConvertFrame(frame);
 
   m_context->last_pts = pts;
   m_context->scaled_frame->pts = pts;
@@ -400,10 +455,20 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
   if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
-    return;
+    return false;
   }
 
   ProcessPackets();
+  return true;
+}
+
+void FFMpegFrameDump::ConvertFrame(const FrameData& frame)
+{
+  if (!m_context->scaler.Convert(frame, m_context->src_frame, m_context->scaled_frame,
+                                 m_context->num_scaler_threads))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Failed to convert the frame");
+  }
 }
 
 void FFMpegFrameDump::ProcessPackets()
@@ -478,9 +543,6 @@ void FFMpegFrameDump::CloseVideoFile()
 
   avformat_free_context(m_context->format);
 
-  if (m_context->sws)
-    sws_freeContext(m_context->sws);
-
   m_context.reset();
 }
 
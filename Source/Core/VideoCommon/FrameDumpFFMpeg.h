@@ -31,6 +31,36 @@ struct FrameData
   FrameState state;
 };
 
+#if defined(HAVE_FFMPEG)
+struct AVFrame;
+struct SwsContext;
+
+// Converts RGBA frames to the pixel format of the encoder. The whole frame goes through one scaler,
+// which splits it between threads itself where swscale supports it, so that the rows around a split
+// are filtered like any others.
+class FrameDumpScaler
+{
+public:
+  FrameDumpScaler() = default;
+  ~FrameDumpScaler();
+  FrameDumpScaler(const FrameDumpScaler&) = delete;
+  FrameDumpScaler& operator=(const FrameDumpScaler&) = delete;
+
+  // src only has to be allocated, it is pointed at the frame's data. dst must have its size and
+  // pixel format set and its buffers allocated.
+  bool Convert(const FrameData& frame, AVFrame* src, AVFrame* dst, int num_threads);
+
+private:
+  SwsContext* m_sws = nullptr;
+  int m_src_width = 0;
+  int m_src_height = 0;
+  int m_dst_width = 0;
+  int m_dst_height = 0;
+  int m_dst_format = 0;
+  int m_num_threads = 0;
+};
+#endif
+
 class FFMpegFrameDump
 {
 public:
@@ -38,7 +68,8 @@ public:
   ~FFMpegFrameDump();
 
   bool Start(int w, int h, u64 start_ticks);
-  void AddFrame(const FrameData&);
+  // Returns whether the frame was written to the dump.
+  bool AddFrame(const FrameData&);
   void Stop();
   void DoState(PointerWrap&);
   bool IsStarted() const;
@@ -50,6 +81,7 @@ private:
   bool CreateVideoFile();
   void CloseVideoFile();
   void CheckForConfigChange(const FrameData&);
+  void ConvertFrame(const FrameData&);
   void ProcessPackets();
 
 #if defined(HAVE_FFMPEG)
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -16,6 +18,7 @@
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
 // The video encoder needs the image to be a multiple of x samples.
@@ -62,13 +65,23 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  if (!m_current_readback_buffer)
+  {
+    m_current_readback_buffer = AcquireReadbackBuffer();
+    if (!m_current_readback_buffer)
+      return;
+  }
+
+  ReadbackBuffer& buffer = m_readback_buffers[*m_current_readback_buffer];
+  if (!CheckFrameDumpReadbackTexture(buffer, target_width, target_height))
+  {
+    m_free_readback_buffers.push_back(*m_current_readback_buffer);
+    m_current_readback_buffer.reset();
     return;
+  }
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  buffer.texture->CopyFromTexture(src_texture, copy_rect, 0, 0, buffer.texture->GetRect());
+  buffer.state = m_ffmpeg_dump.FetchState(ticks, frame_number);
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -99,9 +112,10 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool FrameDumper::CheckFrameDumpReadbackTexture(ReadbackBuffer& buffer, u32 target_width,
+                                                u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = buffer.texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -116,85 +130,156 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
   return true;
 }
 
-void FrameDumper::FlushFrameDump()
+std::optional<size_t> FrameDumper::AcquireReadbackBuffer()
 {
-  if (!m_frame_dump_needs_flush)
-    return;
+  if (m_readback_buffers.empty())
+  {
+    // One buffer is being read back into while the others are pending or being encoded.
+    const size_t num_buffers = std::clamp(g_ActiveConfig.iFrameDumpReadbackBuffers, 2, 8);
+    m_readback_buffers.resize(num_buffers);
+    for (size_t i = 0; i < num_buffers; i++)
+      m_free_readback_buffers.push_back(num_buffers - 1 - i);
+  }
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  ReclaimReadbackBuffers();
+  if (m_free_readback_buffers.empty())
+  {
+    // Every buffer is in use, so the dump thread has fallen behind.
+    m_frames_waited++;
+    if (m_num_queued_frames == 0)
+      SubmitReadbacks(0);
+    while (m_free_readback_buffers.empty() && m_num_queued_frames != 0)
+    {
+      m_frame_dump_done.Wait();
+      ReclaimReadbackBuffers();
+    }
+    if (m_free_readback_buffers.empty())
+      return std::nullopt;
+  }
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  const size_t index = m_free_readback_buffers.back();
+  m_free_readback_buffers.pop_back();
+  return index;
+}
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
+void FrameDumper::ReclaimReadbackBuffers()
+{
+  size_t index;
+  while (m_finished_readback_buffers.Pop(index))
   {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
+    m_readback_buffers[index].texture->Unmap();
+    m_free_readback_buffers.push_back(index);
+    m_num_queued_frames--;
   }
-  else
+}
+
+void FrameDumper::SubmitReadbacks(size_t max_pending, bool take_screenshot)
+{
+  while (m_pending_readback_buffers.size() > max_pending)
   {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
+    const size_t index = m_pending_readback_buffers.front();
+    m_pending_readback_buffers.pop_front();
+
+    ReadbackBuffer& buffer = m_readback_buffers[index];
+    AbstractStagingTexture* const texture = buffer.texture.get();
+    texture->Flush();
+    const bool is_screenshot = take_screenshot && m_pending_readback_buffers.empty();
+    if (!texture->Map())
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+      m_frames_dropped++;
+      m_free_readback_buffers.push_back(index);
+      // Try again with the next frame.
+      if (is_screenshot)
+        m_screenshot_request.Set();
+      continue;
+    }
 
-  m_frame_dump_needs_flush = false;
+    if (!m_frame_dump_thread_running.IsSet())
+    {
+      if (m_frame_dump_thread.joinable())
+        m_frame_dump_thread.join();
+      m_frame_dump_thread_running.Set();
+      m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+    }
 
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
+    const FrameData frame{reinterpret_cast<const u8*>(texture->GetMappedPointer()),
+                          static_cast<int>(texture->GetConfig().width),
+                          static_cast<int>(texture->GetConfig().height),
+                          static_cast<int>(texture->GetMappedStride()), buffer.state};
+    m_queued_frames.Push(QueuedFrame{frame, index, is_screenshot});
+    m_num_queued_frames++;
+
+    // Wake worker thread up.
+    m_frame_dump_start.Set();
+  }
 }
 
-void FrameDumper::ShutdownFrameDumping()
+void FrameDumper::FlushFrameDump()
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  const bool dumping = IsFrameDumping();
 
-  if (!m_frame_dump_thread_running.IsSet())
-    return;
+  // A screenshot is taken of the frame which was just rendered, rather than of the older frames
+  // which are still pending. If no frame was rendered since the request, the next one is used.
+  bool take_screenshot = false;
+  if (m_current_readback_buffer)
+  {
+    m_pending_readback_buffers.push_back(*m_current_readback_buffer);
+    m_current_readback_buffer.reset();
+    take_screenshot = m_screenshot_request.TestAndClear();
+  }
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+  // Give the GPU a frame to finish copying before the data is needed, rather than waiting for it
+  // straight away. Screenshots are taken as soon as possible though.
+  SubmitReadbacks(dumping && !take_screenshot ? 1 : 0, take_screenshot);
+  ReclaimReadbackBuffers();
 
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
-  m_frame_dump_render_framebuffer.reset();
-  m_frame_dump_render_texture.reset();
+  const DumpStatistics statistics = GetStatistics();
+  SETSTAT(g_stats.num_frame_dump_frames, statistics.frames_dumped);
+  SETSTAT(g_stats.num_frame_dump_drops, statistics.frames_dropped);
+  SETSTAT(g_stats.num_frame_dump_waits, statistics.frames_waited);
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  // Shutdown frame dumping if it is no longer active.
+  if (!dumping && !m_readback_buffers.empty())
+    ShutdownFrameDumping();
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::ShutdownFrameDumping()
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
+  // Ensure the last readbacks have been sent to the encoder.
+  if (m_current_readback_buffer)
+  {
+    m_pending_readback_buffers.push_back(*m_current_readback_buffer);
+    m_current_readback_buffer.reset();
+  }
+  SubmitReadbacks(0);
 
-  if (!m_frame_dump_thread_running.IsSet())
+  if (m_frame_dump_thread_running.IsSet())
   {
+    // Wake thread up, and wait for it to encode the queued frames and exit.
+    m_frame_dump_thread_running.Clear();
+    m_frame_dump_start.Set();
     if (m_frame_dump_thread.joinable())
       m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
   }
+  ReclaimReadbackBuffers();
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
-}
-
-void FrameDumper::FinishFrameData()
-{
-  if (!m_frame_dump_frame_running)
-    return;
+  const DumpStatistics statistics = GetStatistics();
+  if (statistics.frames_dumped != 0 || statistics.frames_dropped != 0)
+  {
+    NOTICE_LOG_FMT(VIDEO, "Frame dump: {} frames dumped, {} dropped, {} waited for the encoder",
+                   statistics.frames_dumped, statistics.frames_dropped, statistics.frames_waited);
+  }
+  m_frames_dumped = 0;
+  m_frames_dropped = 0;
+  m_frames_waited = 0;
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  m_frame_dump_render_framebuffer.reset();
+  m_frame_dump_render_texture.reset();
 
-  m_frame_dump_output_texture->Unmap();
+  m_readback_buffers.clear();
+  m_free_readback_buffers.clear();
+  m_num_queued_frames = 0;
 }
 
 void FrameDumper::FrameDumpThreadFunc()
@@ -217,49 +302,62 @@ void FrameDumper::FrameDumpThreadFunc()
   while (true)
   {
     m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
-
-    auto frame = m_frame_dump_data;
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    // The queue is emptied before exiting, so that every frame read back is dumped.
+    QueuedFrame queued;
+    while (m_queued_frames.Pop(queued))
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
-
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+      const FrameData& frame = queued.frame;
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
-    {
-      if (!frame_dump_started)
+      // Save screenshot
+      if (queued.take_screenshot)
       {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
+        std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        if (DumpFrameToPNG(frame, m_screenshot_name))
+          OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+
+        // Reset settings
+        m_screenshot_name.clear();
+        m_screenshot_completed.Set();
       }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+      if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
       {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
+        if (!frame_dump_started)
+        {
+          if (dump_to_ffmpeg)
+            frame_dump_started = StartFrameDumpToFFMPEG(frame);
+          else
+            frame_dump_started = StartFrameDumpToImage(frame);
+
+          // Stop frame dumping if we fail to start.
+          if (!frame_dump_started)
+            Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        }
+
+        // If we failed to start frame dumping, don't write a frame.
+        if (frame_dump_started)
+        {
+          bool dumped = true;
+          if (dump_to_ffmpeg)
+            dumped = DumpFrameToFFMPEG(frame);
+          else
+            DumpFrameToImage(frame);
+
+          if (dumped)
+            m_frames_dumped++;
+          else
+            m_frames_dropped++;
+        }
       }
+
+      m_finished_readback_buffers.Push(queued.readback_buffer);
+      m_frame_dump_done.Set();
     }
 
-    m_frame_dump_done.Set();
+    if (!m_frame_dump_thread_running.IsSet())
+      break;
   }
 
   if (frame_dump_started)
@@ -281,9 +379,9 @@ bool FrameDumper::StartFrameDumpToFFMPEG(const FrameData& frame)
   return m_ffmpeg_dump.Start(frame.width, frame.height, start_ticks);
 }
 
-void FrameDumper::DumpFrameToFFMPEG(const FrameData& frame)
+bool FrameDumper::DumpFrameToFFMPEG(const FrameData& frame)
 {
-  m_ffmpeg_dump.AddFrame(frame);
+  return m_ffmpeg_dump.AddFrame(frame);
 }
 
 void FrameDumper::StopFrameDumpToFFMPEG()
@@ -298,8 +396,9 @@ bool FrameDumper::StartFrameDumpToFFMPEG(const FrameData&)
   return false;
 }
 
-void FrameDumper::DumpFrameToFFMPEG(const FrameData&)
+bool FrameDumper::DumpFrameToFFMPEG(const FrameData&)
 {
+  return false;
 }
 
 void FrameDumper::StopFrameDumpToFFMPEG()
@@ -357,6 +456,11 @@ bool FrameDumper::IsFrameDumping() const
   return false;
 }
 
+FrameDumper::DumpStatistics FrameDumper::GetStatistics() const
+{
+  return {m_frames_dumped, m_frames_dropped, m_frames_waited};
+}
+
 int FrameDumper::GetRequiredResolutionLeastCommonMultiple() const
 {
   if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
@@ -3,10 +3,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -25,7 +32,7 @@ public:
   // Ensures all rendered frames are queued for encoding.
   void FlushFrameDump();
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Starts reading back the current XFB texture into a frame dump staging texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
                         const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
@@ -37,11 +44,36 @@ public:
 
   void DoState(PointerWrap& p);
 
+  // Counted since frame dumping started.
+  struct DumpStatistics
+  {
+    u64 frames_dumped = 0;
+    // Frames which were rendered but not written to the dump.
+    u64 frames_dropped = 0;
+    // Frames for which the video thread had to wait for a free readback buffer.
+    u64 frames_waited = 0;
+  };
+  DumpStatistics GetStatistics() const;
+
 private:
+  // A frame which has been read back, on its way to the dump thread.
+  struct QueuedFrame
+  {
+    FrameData frame;
+    size_t readback_buffer = 0;
+    bool take_screenshot = false;
+  };
+
+  struct ReadbackBuffer
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameState state;
+  };
+
   // NOTE: The methods below are called on the framedumping thread.
   void FrameDumpThreadFunc();
   bool StartFrameDumpToFFMPEG(const FrameData&);
-  void DumpFrameToFFMPEG(const FrameData&);
+  bool DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
   std::string GetFrameDumpNextImageFileName() const;
   bool StartFrameDumpToImage(const FrameData&);
@@ -52,14 +84,19 @@ private:
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Checks that the readback buffer's texture exists and is the correct size.
+  bool CheckFrameDumpReadbackTexture(ReadbackBuffer& buffer, u32 target_width,
+                                     u32 target_height);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Returns a readback buffer which isn't in use, waiting for the dump thread if there are none.
+  std::optional<size_t> AcquireReadbackBuffer();
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Takes back the buffers of frames which the dump thread is done with.
+  void ReclaimReadbackBuffers();
+
+  // Maps the oldest pending readbacks and hands them to the dump thread, until at most
+  // max_pending are left. A screenshot can be taken of the newest of them when all are submitted.
+  void SubmitReadbacks(size_t max_pending, bool take_screenshot = false);
 
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
@@ -70,23 +107,27 @@ private:
   // Set by frame dump thread on frame completion.
   Common::Event m_frame_dump_done;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
-
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // A ring of readback buffers, so that the readback of a frame, and the conversion and encoding
+  // of the previous ones, overlap rather than wait for each other. Buffers are owned by the video
+  // thread, except while their frame is queued for or being processed by the dump thread.
+  std::vector<ReadbackBuffer> m_readback_buffers;
+  std::vector<size_t> m_free_readback_buffers;
+  // The buffer which the current frame is being read back into.
+  std::optional<size_t> m_current_readback_buffer;
+  // Buffers of earlier frames, which are mapped once the GPU has had time to copy them.
+  std::deque<size_t> m_pending_readback_buffers;
+  size_t m_num_queued_frames = 0;
+
+  Common::SPSCQueue<QueuedFrame, false> m_queued_frames;
+  Common::SPSCQueue<size_t, false> m_finished_readback_buffers;
+
+  std::atomic<u64> m_frames_dumped = 0;
+  std::atomic<u64> m_frames_dropped = 0;
+  u64 m_frames_waited = 0;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
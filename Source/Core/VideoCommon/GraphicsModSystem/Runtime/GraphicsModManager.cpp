@@ -7,6 +7,7 @@
 #include <string_view>
 #include <variant>
 
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/VariantUtil.h"
@@ -78,6 +79,45 @@ private:
   GraphicsModConfig m_mod;
 };
 
+void GraphicsModManager::TextureActions::Add(u64 texture_key, GraphicsModAction* action)
+{
+  // The keys are hashes, so different parts of them can be used as the two hashes of the filter.
+  m_filter.set(texture_key % FILTER_SIZE);
+  m_filter.set((texture_key >> 32) % FILTER_SIZE);
+  m_actions[texture_key].push_back(action);
+}
+
+const std::vector<GraphicsModAction*>&
+GraphicsModManager::TextureActions::Find(u64 texture_key) const
+{
+  const bool may_contain = m_filter.test(texture_key % FILTER_SIZE) &&
+                           m_filter.test((texture_key >> 32) % FILTER_SIZE);
+  if (!may_contain)
+    return m_default;
+
+  if (const auto it = m_actions.find(texture_key); it != m_actions.end())
+    return it->second;
+
+  return m_default;
+}
+
+void GraphicsModManager::TextureActions::Clear()
+{
+  m_filter.reset();
+  m_actions.clear();
+}
+
+u64 GraphicsModManager::GetTextureKey(std::string_view texture_name)
+{
+  return Common::HashXXH3(reinterpret_cast<const u8*>(texture_name.data()), texture_name.size());
+}
+
+u64 GraphicsModManager::GetProjectionTextureKey(ProjectionType projection_type, u64 texture_key)
+{
+  // Mixes the projection type into all bits of the key, which the filter relies on.
+  return texture_key ^ (static_cast<u64>(projection_type) + 1) * 0x9E3779B97F4A7C15;
+}
+
 bool GraphicsModManager::Initialize()
 {
   if (g_ActiveConfig.bGraphicMods)
@@ -116,52 +156,28 @@ GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
 
 const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
-                                                const std::string& texture_name) const
+                                                u64 texture_key) const
 {
-  const auto lookup = fmt::format("{}_{}", texture_name, static_cast<int>(projection_type));
-  if (const auto it = m_projection_texture_target_to_actions.find(lookup);
-      it != m_projection_texture_target_to_actions.end())
-  {
-    return it->second;
-  }
-
-  return m_default;
+  return m_projection_texture_target_to_actions.Find(
+      GetProjectionTextureKey(projection_type, texture_key));
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
+GraphicsModManager::GetDrawStartedActions(u64 texture_key) const
 {
-  if (const auto it = m_draw_started_target_to_actions.find(texture_name);
-      it != m_draw_started_target_to_actions.end())
-  {
-    return it->second;
-  }
-
-  return m_default;
+  return m_draw_started_target_to_actions.Find(texture_key);
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
+GraphicsModManager::GetTextureLoadActions(u64 texture_key) const
 {
-  if (const auto it = m_load_texture_target_to_actions.find(texture_name);
-      it != m_load_texture_target_to_actions.end())
-  {
-    return it->second;
-  }
-
-  return m_default;
+  return m_load_texture_target_to_actions.Find(texture_key);
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureCreateActions(const std::string& texture_name) const
+GraphicsModManager::GetTextureCreateActions(u64 texture_key) const
 {
-  if (const auto it = m_create_texture_target_to_actions.find(texture_name);
-      it != m_create_texture_target_to_actions.end())
-  {
-    return it->second;
-  }
-
-  return m_default;
+  return m_create_texture_target_to_actions.Find(texture_key);
 }
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const FBInfo& efb) const
@@ -261,16 +277,16 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
         std::visit(
             overloaded{
                 [&](const DrawStartedTextureTarget& the_target) {
-                  m_draw_started_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  m_draw_started_target_to_actions.Add(
+                      GetTextureKey(the_target.m_texture_info_string), m_actions.back().get());
                 },
                 [&](const LoadTextureTarget& the_target) {
-                  m_load_texture_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  m_load_texture_target_to_actions.Add(
+                      GetTextureKey(the_target.m_texture_info_string), m_actions.back().get());
                 },
                 [&](const CreateTextureTarget& the_target) {
-                  m_create_texture_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  m_create_texture_target_to_actions.Add(
+                      GetTextureKey(the_target.m_texture_info_string), m_actions.back().get());
                 },
                 [&](const EFBTarget& the_target) {
                   FBInfo info;
@@ -289,10 +305,10 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
                 [&](const ProjectionTarget& the_target) {
                   if (the_target.m_texture_info_string)
                   {
-                    const auto lookup = fmt::format("{}_{}", *the_target.m_texture_info_string,
-                                                    static_cast<int>(the_target.m_projection_type));
-                    m_projection_texture_target_to_actions[lookup].push_back(
-                        m_actions.back().get());
+                    const u64 key =
+                        GetProjectionTextureKey(the_target.m_projection_type,
+                                                GetTextureKey(*the_target.m_texture_info_string));
+                    m_projection_texture_target_to_actions.Add(key, m_actions.back().get());
                   }
                   else
                   {
@@ -361,10 +377,10 @@ void GraphicsModManager::Reset()
   m_actions.clear();
   m_groups.clear();
   m_projection_target_to_actions.clear();
-  m_projection_texture_target_to_actions.clear();
-  m_draw_started_target_to_actions.clear();
-  m_load_texture_target_to_actions.clear();
-  m_create_texture_target_to_actions.clear();
+  m_projection_texture_target_to_actions.Clear();
+  m_draw_started_target_to_actions.Clear();
+  m_load_texture_target_to_actions.Clear();
+  m_create_texture_target_to_actions.Clear();
   m_efb_target_to_actions.clear();
   m_xfb_target_to_actions.clear();
 }
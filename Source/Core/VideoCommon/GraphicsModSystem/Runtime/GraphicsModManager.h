@@ -3,13 +3,16 @@
 
 #pragma once
 
+#include <bitset>
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModAction.h"
 #include "VideoCommon/TextureInfo.h"
@@ -22,16 +25,16 @@ class GraphicsModManager
 public:
   bool Initialize();
 
+  // Textures are looked up by a hash of their name, so that the name doesn't need to be hashed
+  // again for every draw. It should be computed once, when the name is.
+  static u64 GetTextureKey(std::string_view texture_name);
+
   const std::vector<GraphicsModAction*>& GetProjectionActions(ProjectionType projection_type) const;
-  const std::vector<GraphicsModAction*>&
-  GetProjectionTextureActions(ProjectionType projection_type,
-                              const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetDrawStartedActions(const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetTextureLoadActions(const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetTextureCreateActions(const std::string& texture_name) const;
+  const std::vector<GraphicsModAction*>& GetProjectionTextureActions(ProjectionType projection_type,
+                                                                     u64 texture_key) const;
+  const std::vector<GraphicsModAction*>& GetDrawStartedActions(u64 texture_key) const;
+  const std::vector<GraphicsModAction*>& GetTextureLoadActions(u64 texture_key) const;
+  const std::vector<GraphicsModAction*>& GetTextureCreateActions(u64 texture_key) const;
   const std::vector<GraphicsModAction*>& GetEFBActions(const FBInfo& efb) const;
   const std::vector<GraphicsModAction*>& GetXFBActions(const FBInfo& xfb) const;
 
@@ -43,16 +46,32 @@ private:
 
   class DecoratedAction;
 
+  // The actions of each texture key. Most textures have no actions, so the keys are also added to
+  // a Bloom filter, which rules out most of the other keys without a lookup in the map.
+  class TextureActions
+  {
+  public:
+    void Add(u64 texture_key, GraphicsModAction* action);
+    const std::vector<GraphicsModAction*>& Find(u64 texture_key) const;
+    void Clear();
+
+  private:
+    static constexpr size_t FILTER_SIZE = 1 << 16;
+
+    std::bitset<FILTER_SIZE> m_filter;
+    std::unordered_map<u64, std::vector<GraphicsModAction*>> m_actions;
+  };
+
+  static u64 GetProjectionTextureKey(ProjectionType projection_type, u64 texture_key);
+
   static inline const std::vector<GraphicsModAction*> m_default = {};
   std::list<std::unique_ptr<GraphicsModAction>> m_actions;
   std::unordered_map<ProjectionType, std::vector<GraphicsModAction*>>
       m_projection_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
-      m_projection_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_load_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
-      m_create_texture_target_to_actions;
+  TextureActions m_projection_texture_target_to_actions;
+  TextureActions m_draw_started_target_to_actions;
+  TextureActions m_load_texture_target_to_actions;
+  TextureActions m_create_texture_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_efb_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_xfb_target_to_actions;
 
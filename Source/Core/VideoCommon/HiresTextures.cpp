@@ -4,6 +4,7 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -27,53 +28,116 @@
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePackFile.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
 constexpr std::string_view s_format_prefix{"tex1_"};
 
 static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_hires_texture_cache;
-static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
+namespace
+{
+struct HiresTextureSource
+{
+  bool has_arbitrary_mipmaps = false;
+  std::shared_ptr<VideoCommon::CustomAssetLibrary> library;
+};
+}  // namespace
+
+static std::unordered_map<std::string, HiresTextureSource> s_hires_texture_id_to_source;
+
+// Textures which were requested right after each texture, most recent first. Games tend to use
+// the same textures together, so these are loaded as soon as the texture is requested again.
+static std::unordered_map<std::string, std::vector<std::string>> s_hires_texture_successors;
+static std::string s_last_requested_hires_texture;
+// Keeps prefetched textures alive until they are requested, when they aren't cached anyway.
+static std::deque<std::shared_ptr<VideoCommon::GameTextureAsset>> s_prefetched_hires_textures;
+constexpr std::size_t MAX_HIRES_TEXTURE_SUCCESSORS = 4;
+constexpr std::size_t MAX_PREFETCHED_HIRES_TEXTURES = 64;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 
 namespace
 {
-std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
+std::pair<std::string, const HiresTextureSource*> GetNameSourcePair(const TextureInfo& texture_info)
 {
-  if (s_hires_texture_id_to_arbmipmap.empty())
-    return {"", false};
+  if (s_hires_texture_id_to_source.empty())
+    return {"", nullptr};
 
   const auto texture_name_details = texture_info.CalculateTextureName();
   // look for an exact match first
   const std::string full_name = texture_name_details.GetFullName();
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(full_name);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  if (auto iter = s_hires_texture_id_to_source.find(full_name);
+      iter != s_hires_texture_id_to_source.end())
   {
-    return {full_name, iter->second};
+    return {full_name, &iter->second};
   }
 
   // Single wildcard ignoring the tlut hash
   const std::string texture_name_single_wildcard_tlut =
       fmt::format("{}_{}_$_{}", texture_name_details.base_name, texture_name_details.texture_name,
                   texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tlut);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  if (auto iter = s_hires_texture_id_to_source.find(texture_name_single_wildcard_tlut);
+      iter != s_hires_texture_id_to_source.end())
   {
-    return {texture_name_single_wildcard_tlut, iter->second};
+    return {texture_name_single_wildcard_tlut, &iter->second};
   }
 
   // Single wildcard ignoring the texture hash
   const std::string texture_name_single_wildcard_tex =
       fmt::format("{}_${}_{}", texture_name_details.base_name, texture_name_details.tlut_name,
                   texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tex);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  if (auto iter = s_hires_texture_id_to_source.find(texture_name_single_wildcard_tex);
+      iter != s_hires_texture_id_to_source.end())
+  {
+    return {texture_name_single_wildcard_tex, &iter->second};
+  }
+
+  return {"", nullptr};
+}
+
+void PrefetchSuccessors(const std::string& texture_name)
+{
+  if (!s_last_requested_hires_texture.empty() && s_last_requested_hires_texture != texture_name)
   {
-    return {texture_name_single_wildcard_tex, iter->second};
+    auto& successors = s_hires_texture_successors[s_last_requested_hires_texture];
+    if (const auto it = std::find(successors.begin(), successors.end(), texture_name);
+        it != successors.end())
+    {
+      std::rotate(successors.begin(), it, it + 1);
+    }
+    else
+    {
+      successors.insert(successors.begin(), texture_name);
+      if (successors.size() > MAX_HIRES_TEXTURE_SUCCESSORS)
+        successors.pop_back();
+    }
   }
+  s_last_requested_hires_texture = texture_name;
 
-  return {"", false};
+  const auto it = s_hires_texture_successors.find(texture_name);
+  if (it == s_hires_texture_successors.end())
+    return;
+
+  auto& loader = Core::System::GetInstance().GetCustomAssetLoader();
+  for (const std::string& successor : it->second)
+  {
+    const auto source = s_hires_texture_id_to_source.find(successor);
+    if (source == s_hires_texture_id_to_source.end())
+      continue;
+
+    constexpr auto priority = VideoCommon::CustomAssetLoader::LoadPriority::Low;
+    auto asset = loader.LoadGameTexture(successor, source->second.library, priority);
+    if (loader.UseGameTexture(asset, priority))
+      continue;
+
+    INCSTAT(g_stats.this_frame.num_hires_texture_prefetches);
+    s_prefetched_hires_textures.push_back(std::move(asset));
+    if (s_prefetched_hires_textures.size() > MAX_PREFETCHED_HIRES_TEXTURES)
+      s_prefetched_hires_textures.pop_front();
+  }
 }
 }  // namespace
 
@@ -98,9 +162,26 @@ void HiresTexture::Update()
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+  const std::vector<std::string> extensions{".png", ".dds",
+                                            std::string(VideoCommon::TexturePackFile::EXTENSION)};
 
   auto& system = Core::System::GetInstance();
+  UpdateMemoryBudget();
+
+  const auto add_texture = [&](std::string name, bool has_arbitrary_mipmaps,
+                               std::shared_ptr<VideoCommon::CustomAssetLibrary> library) {
+    const auto [it, inserted] = s_hires_texture_id_to_source.try_emplace(
+        std::move(name), HiresTextureSource{has_arbitrary_mipmaps, std::move(library)});
+    if (inserted && g_ActiveConfig.bCacheHiresTextures)
+    {
+      auto hires_texture = std::make_shared<HiresTexture>(
+          has_arbitrary_mipmaps,
+          system.GetCustomAssetLoader().LoadGameTexture(
+              it->first, it->second.library, VideoCommon::CustomAssetLoader::LoadPriority::Low));
+      s_hires_texture_cache.try_emplace(it->first, std::move(hires_texture));
+    }
+    return inserted;
+  };
 
   for (const auto& texture_directory : texture_directories)
   {
@@ -111,18 +192,34 @@ void HiresTexture::Update()
     for (auto& path : texture_paths)
     {
       std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
+      std::string extension;
+      SplitPath(path, nullptr, &filename, &extension);
+      Common::ToLower(&extension);
 
-      if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
+      if (extension == VideoCommon::TexturePackFile::EXTENSION)
+      {
+        auto library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
+        if (!library->Open(path))
+          continue;
+
+        const VideoCommon::TexturePackFile& pack = library->GetFile();
+        for (std::size_t i = 0; i < pack.GetTextureCount(); i++)
+        {
+          if (!add_texture(std::string(pack.GetTextureName(i)), pack.HasArbitraryMipmaps(i),
+                           library))
+          {
+            failed_insert = true;
+          }
+        }
+      }
+      else if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
       {
         const size_t arb_index = filename.rfind("_arb");
         const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
         if (has_arbitrary_mipmaps)
           filename.erase(arb_index, 4);
 
-        const auto [it, inserted] =
-            s_hires_texture_id_to_arbmipmap.try_emplace(filename, has_arbitrary_mipmaps);
-        if (!inserted)
+        if (s_hires_texture_id_to_source.contains(filename))
         {
           failed_insert = true;
         }
@@ -132,14 +229,7 @@ void HiresTexture::Update()
           // just provide a string
           s_file_library->SetAssetIDMapData(filename, std::map<std::string, std::filesystem::path>{
                                                           {"texture", StringToPath(path)}});
-
-          if (g_ActiveConfig.bCacheHiresTextures)
-          {
-            auto hires_texture = std::make_shared<HiresTexture>(
-                has_arbitrary_mipmaps,
-                system.GetCustomAssetLoader().LoadGameTexture(filename, s_file_library));
-            s_hires_texture_cache.try_emplace(filename, std::move(hires_texture));
-          }
+          add_texture(std::move(filename), has_arbitrary_mipmaps, s_file_library);
         }
       }
     }
@@ -159,39 +249,75 @@ void HiresTexture::Update()
   else
   {
     OSD::AddMessage(
-        fmt::format("Found '{}' custom textures", s_hires_texture_id_to_arbmipmap.size()), 10000);
+        fmt::format("Found '{}' custom textures", s_hires_texture_id_to_source.size()), 10000);
   }
 }
 
+void HiresTexture::UpdateMemoryBudget()
+{
+  const std::size_t budget =
+      static_cast<std::size_t>(std::max(g_ActiveConfig.iHiresTextureBudgetMB, 0)) << 20;
+  Core::System::GetInstance().GetCustomAssetLoader().SetGameTextureMemoryBudget(budget);
+}
+
 void HiresTexture::Clear()
 {
   s_hires_texture_cache.clear();
-  s_hires_texture_id_to_arbmipmap.clear();
+  s_hires_texture_id_to_source.clear();
+  s_hires_texture_successors.clear();
+  s_last_requested_hires_texture.clear();
+  s_prefetched_hires_textures.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
 }
 
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
 {
-  const auto [base_filename, has_arb_mipmaps] = GetNameArbPair(texture_info);
-  if (base_filename == "")
+  const auto [base_filename, source] = GetNameSourcePair(texture_info);
+  if (!source)
     return nullptr;
 
+  auto& loader = Core::System::GetInstance().GetCustomAssetLoader();
+  std::shared_ptr<HiresTexture> hires_texture;
   if (auto iter = s_hires_texture_cache.find(base_filename); iter != s_hires_texture_cache.end())
   {
-    return iter->second;
+    hires_texture = iter->second;
   }
   else
   {
-    auto& system = Core::System::GetInstance();
-    auto hires_texture = std::make_shared<HiresTexture>(
-        has_arb_mipmaps,
-        system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
+    hires_texture = std::make_shared<HiresTexture>(
+        source->has_arbitrary_mipmaps,
+        loader.LoadGameTexture(base_filename, source->library,
+                               VideoCommon::CustomAssetLoader::LoadPriority::High));
     if (g_ActiveConfig.bCacheHiresTextures)
     {
       s_hires_texture_cache.try_emplace(base_filename, hires_texture);
     }
-    return hires_texture;
   }
+
+  // Until the data is loaded, the native texture is used, and the texture cache entry is
+  // recreated once it is available.
+  INCSTAT(g_stats.this_frame.num_hires_texture_requests);
+  if (!loader.UseGameTexture(hires_texture->GetAsset()))
+    INCSTAT(g_stats.this_frame.num_hires_texture_misses);
+
+  PrefetchSuccessors(base_filename);
+
+  const auto statistics = loader.GetGameTextureStatistics();
+  SETSTAT(g_stats.num_hires_textures_loaded, statistics.num_loaded);
+  SETSTAT(g_stats.num_hires_textures_evicted, statistics.num_evicted);
+  SETSTAT(g_stats.hires_texture_memory_kb, statistics.bytes_loaded / 1024);
+
+  const auto load_statistics = loader.GetLoadStatistics();
+  if (load_statistics.num_loads != 0)
+  {
+    SETSTAT(g_stats.custom_asset_load_latency_us,
+            load_statistics.total_latency.count() / load_statistics.num_loads);
+    SETSTAT(g_stats.custom_asset_max_load_latency_us, load_statistics.max_latency.count());
+    SETSTAT(g_stats.custom_asset_load_time_us,
+            load_statistics.total_load_time.count() / load_statistics.num_loads);
+    SETSTAT(g_stats.custom_asset_max_load_time_us, load_statistics.max_load_time.count());
+  }
+  return hires_texture;
 }
 
 HiresTexture::HiresTexture(bool has_arbitrary_mipmaps,
@@ -24,6 +24,7 @@ class HiresTexture
 public:
   static void Init();
   static void Update();
+  static void UpdateMemoryBudget();
   static void Clear();
   static void Shutdown();
   static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info);
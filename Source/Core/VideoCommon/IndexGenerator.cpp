@@ -6,6 +6,14 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <numeric>
+
+#if defined(_M_X86_64)
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -16,6 +24,220 @@ namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+enum class SIMD
+{
+  None,
+#if defined(_M_X86_64)
+  SSE2,
+  AVX2,
+#elif defined(_M_ARM_64)
+  NEON,
+#endif
+};
+
+// The indices of most primitives are a short pattern which repeats for every few vertices, e.g.
+// 0 1 2 3 4 5 6 7 8 for triangle lists. The SIMD kernels unroll the pattern over a whole number of
+// vectors, and then only need a single add per vector to produce the next block of indices. The
+// scalar loops below handle whatever is left.
+template <size_t N>
+struct IndexPattern
+{
+  // How much each index increases by from one repetition to the next.
+  u16 advance;
+  // Indices of the first repetition relative to the base index, or s_primitive_restart.
+  std::array<u16, N> offsets;
+  // Bit i is set if offsets[i] is the same for every repetition, like the centre of a fan.
+  u32 fixed = 0;
+};
+
+template <size_t W, size_t N>
+struct UnrolledPattern
+{
+  static constexpr size_t SIZE = std::lcm(N, W);
+  static constexpr u32 REPETITIONS = SIZE / N;
+
+  std::array<u16, SIZE> offsets{};
+  // All ones for the indices which the base index is added to.
+  std::array<u16, SIZE> index_mask{};
+  // Added to the indices for each block of REPETITIONS repetitions.
+  std::array<u16, SIZE> steps{};
+};
+
+template <size_t W, size_t N>
+constexpr UnrolledPattern<W, N> Unroll(const IndexPattern<N>& pattern)
+{
+  UnrolledPattern<W, N> result;
+  for (size_t i = 0; i < result.SIZE; i++)
+  {
+    const size_t j = i % N;
+    if (pattern.offsets[j] == s_primitive_restart)
+    {
+      result.offsets[i] = s_primitive_restart;
+      continue;
+    }
+
+    const bool fixed = (pattern.fixed >> j) & 1;
+    const u32 repetition = static_cast<u32>(i / N);
+    result.offsets[i] = pattern.offsets[j] + (fixed ? 0 : repetition * pattern.advance);
+    result.index_mask[i] = UINT16_MAX;
+    result.steps[i] = fixed ? 0 : result.REPETITIONS * pattern.advance;
+  }
+  return result;
+}
+
+#if defined(_M_X86_64)
+template <const auto& pattern>
+u16* ExpandPatternSSE2(u16* index_ptr, u32 index, u32 blocks)
+{
+  static constexpr auto unrolled = Unroll<8>(pattern);
+  constexpr size_t num_vectors = unrolled.SIZE / 8;
+
+  const __m128i base = _mm_set1_epi16(static_cast<s16>(index));
+  __m128i values[num_vectors];
+  __m128i steps[num_vectors];
+  for (size_t i = 0; i < num_vectors; i++)
+  {
+    const __m128i offsets =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&unrolled.offsets[i * 8]));
+    const __m128i mask =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&unrolled.index_mask[i * 8]));
+    values[i] = _mm_add_epi16(offsets, _mm_and_si128(base, mask));
+    steps[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&unrolled.steps[i * 8]));
+  }
+
+  for (u32 block = 0; block < blocks; block++)
+  {
+    for (size_t i = 0; i < num_vectors; i++)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr), values[i]);
+      values[i] = _mm_add_epi16(values[i], steps[i]);
+      index_ptr += 8;
+    }
+  }
+  return index_ptr;
+}
+
+template <const auto& pattern>
+FUNCTION_TARGET_AVX2 u16* ExpandPatternAVX2(u16* index_ptr, u32 index, u32 blocks)
+{
+  static constexpr auto unrolled = Unroll<16>(pattern);
+  constexpr size_t num_vectors = unrolled.SIZE / 16;
+
+  const __m256i base = _mm256_set1_epi16(static_cast<s16>(index));
+  __m256i values[num_vectors];
+  __m256i steps[num_vectors];
+  for (size_t i = 0; i < num_vectors; i++)
+  {
+    const __m256i offsets =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&unrolled.offsets[i * 16]));
+    const __m256i mask =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&unrolled.index_mask[i * 16]));
+    values[i] = _mm256_add_epi16(offsets, _mm256_and_si256(base, mask));
+    steps[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&unrolled.steps[i * 16]));
+  }
+
+  for (u32 block = 0; block < blocks; block++)
+  {
+    for (size_t i = 0; i < num_vectors; i++)
+    {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(index_ptr), values[i]);
+      values[i] = _mm256_add_epi16(values[i], steps[i]);
+      index_ptr += 16;
+    }
+  }
+  return index_ptr;
+}
+#elif defined(_M_ARM_64)
+template <const auto& pattern>
+u16* ExpandPatternNEON(u16* index_ptr, u32 index, u32 blocks)
+{
+  static constexpr auto unrolled = Unroll<8>(pattern);
+  constexpr size_t num_vectors = unrolled.SIZE / 8;
+
+  const uint16x8_t base = vdupq_n_u16(static_cast<u16>(index));
+  uint16x8_t values[num_vectors];
+  uint16x8_t steps[num_vectors];
+  for (size_t i = 0; i < num_vectors; i++)
+  {
+    values[i] = vaddq_u16(vld1q_u16(&unrolled.offsets[i * 8]),
+                          vandq_u16(base, vld1q_u16(&unrolled.index_mask[i * 8])));
+    steps[i] = vld1q_u16(&unrolled.steps[i * 8]);
+  }
+
+  for (u32 block = 0; block < blocks; block++)
+  {
+    for (size_t i = 0; i < num_vectors; i++)
+    {
+      vst1q_u16(index_ptr, values[i]);
+      values[i] = vaddq_u16(values[i], steps[i]);
+      index_ptr += 8;
+    }
+  }
+  return index_ptr;
+}
+#endif
+
+// Writes as many whole SIMD blocks of at most the given number of repetitions of the pattern as
+// possible, and returns the number of repetitions written. Setting up the vectors isn't free, so
+// draws too small for a single block are left to the scalar code entirely.
+template <SIMD simd, const auto& pattern>
+u32 ExpandPattern(u16** index_ptr, u32 index, u32 repetitions)
+{
+#if defined(_M_X86_64)
+  if constexpr (simd == SIMD::SSE2)
+  {
+    constexpr u32 per_block = decltype(Unroll<8>(pattern))::REPETITIONS;
+    if (repetitions >= per_block)
+      *index_ptr = ExpandPatternSSE2<pattern>(*index_ptr, index, repetitions / per_block);
+    return repetitions / per_block * per_block;
+  }
+  else if constexpr (simd == SIMD::AVX2)
+  {
+    constexpr u32 per_block = decltype(Unroll<16>(pattern))::REPETITIONS;
+    if (repetitions >= per_block)
+      *index_ptr = ExpandPatternAVX2<pattern>(*index_ptr, index, repetitions / per_block);
+    return repetitions / per_block * per_block;
+  }
+#elif defined(_M_ARM_64)
+  if constexpr (simd == SIMD::NEON)
+  {
+    constexpr u32 per_block = decltype(Unroll<8>(pattern))::REPETITIONS;
+    if (repetitions >= per_block)
+      *index_ptr = ExpandPatternNEON<pattern>(*index_ptr, index, repetitions / per_block);
+    return repetitions / per_block * per_block;
+  }
+#endif
+  return 0;
+}
+
+// Picks one of two patterns of different lengths.
+template <bool condition, const auto& a, const auto& b>
+constexpr const auto& SelectPattern()
+{
+  if constexpr (condition)
+    return a;
+  else
+    return b;
+}
+
+constexpr u16 R = s_primitive_restart;
+constexpr IndexPattern<1> s_sequence_pattern{1, {0}};
+constexpr IndexPattern<3> s_list_pattern{3, {0, 1, 2}};
+constexpr IndexPattern<4> s_list_pr_pattern{3, {0, 1, 2, R}};
+constexpr IndexPattern<6> s_strip_pattern{2, {0, 1, 2, 1, 3, 2}};
+constexpr IndexPattern<3> s_fan_pattern{1, {0, 1, 2}, 0b1};
+constexpr IndexPattern<6> s_fan_pr_pattern{3, {1, 2, 0, 3, 4, R}, 0b100};
+constexpr IndexPattern<6> s_quads_pattern{4, {0, 1, 2, 0, 2, 3}};
+constexpr IndexPattern<5> s_quads_pr_pattern{4, {1, 2, 0, 3, R}};
+constexpr IndexPattern<2> s_line_list_pattern{2, {0, 1}};
+constexpr IndexPattern<2> s_line_strip_pattern{1, {0, 1}};
+constexpr IndexPattern<6> s_lines_vs_expand_pattern{8, {0, 1, 6, 1, 6, 7}};
+constexpr IndexPattern<5> s_lines_vs_expand_pr_pattern{8, {0, 1, 6, 7, R}};
+constexpr IndexPattern<6> s_line_strip_vs_expand_pattern{4, {0, 1, 6, 1, 6, 7}};
+constexpr IndexPattern<5> s_line_strip_vs_expand_pr_pattern{4, {0, 1, 6, 7, R}};
+constexpr IndexPattern<6> s_points_vs_expand_pattern{4, {0, 1, 2, 1, 2, 3}};
+constexpr IndexPattern<5> s_points_vs_expand_pr_pattern{4, {0, 1, 2, 3, R}};
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -27,22 +249,25 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
   return index_ptr;
 }
 
-template <bool pr>
+template <SIMD simd, bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
+  constexpr auto& pattern = SelectPattern<pr, s_list_pr_pattern, s_list_pattern>();
+  u32 i = 2 + 3 * ExpandPattern<simd, pattern>(&index_ptr, index, num_verts / 3);
+  for (; i < num_verts; i += 3)
   {
     index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
   }
   return index_ptr;
 }
 
-template <bool pr>
+template <SIMD simd, bool pr>
 u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
+    u32 i = ExpandPattern<simd, s_sequence_pattern>(&index_ptr, index, num_verts);
+    for (; i < num_verts; ++i)
     {
       *index_ptr++ = index + i;
     }
@@ -50,8 +275,11 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
+    // Each repetition is a pair of triangles, so the winding starts out the same afterwards.
+    const u32 pairs = num_verts > 2 ? (num_verts - 2) / 2 : 0;
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    for (u32 i = 2 + 2 * ExpandPattern<simd, s_strip_pattern>(&index_ptr, index, pairs);
+         i < num_verts; ++i)
     {
       index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -80,13 +308,15 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
  * so we use 6 indices for 3 triangles
  */
 
-template <bool pr>
+template <SIMD simd, bool pr>
 u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 2;
 
   if constexpr (pr)
   {
+    const u32 triples = num_verts > 2 ? (num_verts - 2) / 3 : 0;
+    i += 3 * ExpandPattern<simd, s_fan_pr_pattern>(&index_ptr, index, triples);
     for (; i + 3 <= num_verts; i += 3)
     {
       *index_ptr++ = index + i - 1;
@@ -106,6 +336,10 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
       *index_ptr++ = s_primitive_restart;
     }
   }
+  else
+  {
+    i += ExpandPattern<simd, s_fan_pattern>(&index_ptr, index, num_verts > 2 ? num_verts - 2 : 0);
+  }
 
   for (; i < num_verts; ++i)
   {
@@ -131,10 +365,11 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
  * A simple triangle has to be rendered for three vertices.
  * ZWW do this for sun rays
  */
-template <bool pr>
+template <SIMD simd, bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
-  u32 i = 3;
+  constexpr auto& pattern = SelectPattern<pr, s_quads_pr_pattern, s_quads_pattern>();
+  u32 i = 3 + 4 * ExpandPattern<simd, pattern>(&index_ptr, index, num_verts / 4);
   for (; i < num_verts; i += 4)
   {
     if constexpr (pr)
@@ -161,16 +396,18 @@ u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
-template <bool pr>
+template <SIMD simd, bool pr>
 u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 {
   WARN_LOG_FMT(VIDEO, "Non-standard primitive drawing command GL_DRAW_QUADS_2");
-  return AddQuads<pr>(index_ptr, num_verts, index);
+  return AddQuads<simd, pr>(index_ptr, num_verts, index);
 }
 
+template <SIMD simd>
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
+  u32 i = 1 + 2 * ExpandPattern<simd, s_line_list_pattern>(&index_ptr, index, num_verts / 2);
+  for (; i < num_verts; i += 2)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -180,9 +417,12 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 
 // Shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
+template <SIMD simd>
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  u32 i = 1 + ExpandPattern<simd, s_line_strip_pattern>(&index_ptr, index,
+                                                        num_verts > 1 ? num_verts - 1 : 0);
+  for (; i < num_verts; ++i)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -190,7 +430,7 @@ u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
-template <bool pr, bool linestrip>
+template <SIMD simd, bool pr, bool linestrip>
 u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
   // VS Expand uses (index >> 2) as the base vertex
@@ -198,7 +438,14 @@ u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
   // Bit 1 indicates which point of the line (top/bottom for a vertical line)
   // VS Expand assumes the two points will be adjacent vertices
   constexpr u32 advance = linestrip ? 1 : 2;
-  for (u32 i = 1; i < num_verts; i += advance)
+  constexpr auto& pattern =
+      SelectPattern<linestrip,
+                    SelectPattern<pr, s_line_strip_vs_expand_pr_pattern,
+                                  s_line_strip_vs_expand_pattern>(),
+                    SelectPattern<pr, s_lines_vs_expand_pr_pattern, s_lines_vs_expand_pattern>()>();
+  const u32 lines = linestrip ? (num_verts > 1 ? num_verts - 1 : 0) : num_verts / 2;
+  for (u32 i = 1 + advance * ExpandPattern<simd, pattern>(&index_ptr, index << 2, lines);
+       i < num_verts; i += advance)
   {
     u32 p0 = (index + i - 1) << 2;
     u32 p1 = (index + i - 0) << 2;
@@ -223,21 +470,26 @@ u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+template <SIMD simd>
 u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 0; i != num_verts; ++i)
+  for (u32 i = ExpandPattern<simd, s_sequence_pattern>(&index_ptr, index, num_verts);
+       i != num_verts; ++i)
   {
     *index_ptr++ = index + i;
   }
   return index_ptr;
 }
 
-template <bool pr>
+template <SIMD simd, bool pr>
 u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
   // VS Expand uses (index >> 2) as the base vertex
   // Bottom two bits indicate which of (TL, TR, BL, BR) this is
-  for (u32 i = 0; i < num_verts; ++i)
+  constexpr auto& pattern =
+      SelectPattern<pr, s_points_vs_expand_pr_pattern, s_points_vs_expand_pattern>();
+  for (u32 i = ExpandPattern<simd, pattern>(&index_ptr, index << 2, num_verts); i < num_verts;
+       ++i)
   {
     u32 base = (index + i) << 2;
     if constexpr (pr)
@@ -260,49 +512,72 @@ u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
   }
   return index_ptr;
 }
-}  // Anonymous namespace
 
-void IndexGenerator::Init()
+using PrimitiveTable =
+    Common::EnumMap<u16* (*)(u16*, u32, u32), OpcodeDecoder::Primitive::GX_DRAW_POINTS>;
+
+template <SIMD simd>
+PrimitiveTable GetPrimitiveTable()
 {
   using OpcodeDecoder::Primitive;
+  PrimitiveTable table{};
 
   if (g_Config.backend_info.bSupportsPrimitiveRestart)
   {
-    m_primitive_table[Primitive::GX_DRAW_QUADS] = AddQuads<true>;
-    m_primitive_table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
-    m_primitive_table[Primitive::GX_DRAW_TRIANGLES] = AddList<true>;
-    m_primitive_table[Primitive::GX_DRAW_TRIANGLE_STRIP] = AddStrip<true>;
-    m_primitive_table[Primitive::GX_DRAW_TRIANGLE_FAN] = AddFan<true>;
+    table[Primitive::GX_DRAW_QUADS] = AddQuads<simd, true>;
+    table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<simd, true>;
+    table[Primitive::GX_DRAW_TRIANGLES] = AddList<simd, true>;
+    table[Primitive::GX_DRAW_TRIANGLE_STRIP] = AddStrip<simd, true>;
+    table[Primitive::GX_DRAW_TRIANGLE_FAN] = AddFan<simd, true>;
   }
   else
   {
-    m_primitive_table[Primitive::GX_DRAW_QUADS] = AddQuads<false>;
-    m_primitive_table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<false>;
-    m_primitive_table[Primitive::GX_DRAW_TRIANGLES] = AddList<false>;
-    m_primitive_table[Primitive::GX_DRAW_TRIANGLE_STRIP] = AddStrip<false>;
-    m_primitive_table[Primitive::GX_DRAW_TRIANGLE_FAN] = AddFan<false>;
+    table[Primitive::GX_DRAW_QUADS] = AddQuads<simd, false>;
+    table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<simd, false>;
+    table[Primitive::GX_DRAW_TRIANGLES] = AddList<simd, false>;
+    table[Primitive::GX_DRAW_TRIANGLE_STRIP] = AddStrip<simd, false>;
+    table[Primitive::GX_DRAW_TRIANGLE_FAN] = AddFan<simd, false>;
   }
   if (g_Config.UseVSForLinePointExpand())
   {
     if (g_Config.backend_info.bSupportsPrimitiveRestart)
     {
-      m_primitive_table[Primitive::GX_DRAW_LINES] = AddLines_VSExpand<true, false>;
-      m_primitive_table[Primitive::GX_DRAW_LINE_STRIP] = AddLines_VSExpand<true, true>;
-      m_primitive_table[Primitive::GX_DRAW_POINTS] = AddPoints_VSExpand<true>;
+      table[Primitive::GX_DRAW_LINES] = AddLines_VSExpand<simd, true, false>;
+      table[Primitive::GX_DRAW_LINE_STRIP] = AddLines_VSExpand<simd, true, true>;
+      table[Primitive::GX_DRAW_POINTS] = AddPoints_VSExpand<simd, true>;
     }
     else
     {
-      m_primitive_table[Primitive::GX_DRAW_LINES] = AddLines_VSExpand<false, false>;
-      m_primitive_table[Primitive::GX_DRAW_LINE_STRIP] = AddLines_VSExpand<false, true>;
-      m_primitive_table[Primitive::GX_DRAW_POINTS] = AddPoints_VSExpand<false>;
+      table[Primitive::GX_DRAW_LINES] = AddLines_VSExpand<simd, false, false>;
+      table[Primitive::GX_DRAW_LINE_STRIP] = AddLines_VSExpand<simd, false, true>;
+      table[Primitive::GX_DRAW_POINTS] = AddPoints_VSExpand<simd, false>;
     }
   }
   else
   {
-    m_primitive_table[Primitive::GX_DRAW_LINES] = AddLineList;
-    m_primitive_table[Primitive::GX_DRAW_LINE_STRIP] = AddLineStrip;
-    m_primitive_table[Primitive::GX_DRAW_POINTS] = AddPoints;
+    table[Primitive::GX_DRAW_LINES] = AddLineList<simd>;
+    table[Primitive::GX_DRAW_LINE_STRIP] = AddLineStrip<simd>;
+    table[Primitive::GX_DRAW_POINTS] = AddPoints<simd>;
   }
+  return table;
+}
+}  // Anonymous namespace
+
+void IndexGenerator::Init(bool use_simd)
+{
+#if defined(_M_X86_64)
+  if (use_simd && cpu_info.bAVX2)
+    m_primitive_table = GetPrimitiveTable<SIMD::AVX2>();
+  else if (use_simd)
+    m_primitive_table = GetPrimitiveTable<SIMD::SSE2>();
+  else
+    m_primitive_table = GetPrimitiveTable<SIMD::None>();
+#elif defined(_M_ARM_64)
+  m_primitive_table =
+      use_simd ? GetPrimitiveTable<SIMD::NEON>() : GetPrimitiveTable<SIMD::None>();
+#else
+  m_primitive_table = GetPrimitiveTable<SIMD::None>();
+#endif
 }
 
 void IndexGenerator::Start(u16* index_ptr)
@@ -13,7 +13,8 @@
 class IndexGenerator
 {
 public:
-  void Init();
+  // Uses the scalar code for all primitives if use_simd is false.
+  void Init(bool use_simd = true);
   void Start(u16* index_ptr);
 
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
@@ -14,6 +14,9 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <array>
+#include <cstring>
+
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
@@ -50,6 +53,29 @@ public:
       INCSTAT(g_stats.this_frame.num_xf_loads);
     }
   }
+  // Loads a batch of XF memory writes at once, so that the pending draws are checked and the XF
+  // state is invalidated once for the whole range. The draws are flushed if they use any part of
+  // the range, even one that didn't change, but batches are short, such as a matrix split between
+  // several loads.
+  void OnXFBatch(const u8* data, const XFLoadBatch& batch)
+  {
+    std::array<u8, MAX_XF_BATCH_WORDS * 4> values;
+    u32 num_words = 0;
+    u32 offset = 0;
+    while (offset < batch.size)
+    {
+      const u32 count = ((Common::swap32(&data[offset + 1]) >> 16) & 0xf) + 1;
+      std::memcpy(&values[num_words * 4], &data[offset + 5], count * 4);
+      num_words += count;
+      m_cycles += 18 + 6 * count;
+      INCSTAT(g_stats.this_frame.num_xf_loads);
+
+      OnCommand(&data[offset], 5 + count * 4);
+      offset += 5 + count * 4;
+    }
+
+    LoadXFReg(batch.address, static_cast<u8>(num_words), values.data());
+  }
   OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
   {
     m_cycles += 12;
@@ -257,21 +283,86 @@ public:
   bool m_in_display_list = false;
 };
 
+XFLoadBatch ScanXFLoadBatch(const u8* data, u32 available)
+{
+  XFLoadBatch batch;
+  while (available - batch.size >= 5 &&
+         static_cast<Opcode>(data[batch.size]) == Opcode::GX_LOAD_XF_REG)
+  {
+    const u32 cmd2 = Common::swap32(&data[batch.size + 1]);
+    const u16 address = cmd2 & 0xffff;
+    // Malformed loads are left to RunCommand, which reports them.
+    if ((cmd2 >> 16) >= 16)
+      break;
+    const u32 count = (cmd2 >> 16) + 1;
+    const u32 size = 5 + count * 4;
+
+    if (available - batch.size < size)
+      break;
+    if (batch.num_commands != 0 && address != batch.address + batch.num_words)
+      break;
+    if (address + count > XFMEM_REGISTERS_START || batch.num_words + count > MAX_XF_BATCH_WORDS)
+      break;
+
+    if (batch.num_commands == 0)
+      batch.address = address;
+    batch.num_words += count;
+    batch.num_commands++;
+    batch.size += size;
+  }
+  return batch;
+}
+
 template <bool is_preprocess>
-u8* RunFifo(DataReader src, u32* cycles)
+u8* RunFifo(DataReader src, u32* cycles, u32* next_command_size)
 {
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
-  u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
+  const u8* const data = src.GetPointer();
+  const u32 available = static_cast<u32>(src.size());
+
+  // Like Run, but the FIFO is scanned ahead for batches of XF loads, and only the commands of the
+  // FIFO itself are counted, not those of the display lists it calls.
+  u32 size = 0;
+  [[maybe_unused]] u32 num_commands = 0;
+  while (size < available)
+  {
+    if constexpr (!is_preprocess)
+    {
+      const XFLoadBatch batch = ScanXFLoadBatch(&data[size], available - size);
+      if (batch.num_commands > 1)
+      {
+        callback.OnXFBatch(&data[size], batch);
+        size += batch.size;
+        num_commands += batch.num_commands;
+        continue;
+      }
+    }
+
+    const u32 command_size = RunCommand(&data[size], available - size, callback);
+    if (command_size == 0)
+      break;
+    size += command_size;
+    num_commands++;
+  }
+
+  if constexpr (!is_preprocess)
+    ADDSTAT(g_stats.this_frame.num_fifo_commands, num_commands);
 
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
 
+  if (next_command_size != nullptr)
+  {
+    *next_command_size =
+        size < available ? GetCommandSize(&data[size], available - size, callback) : 0;
+  }
+
   src.Skip(size);
   return src.GetPointer();
 }
 
-template u8* RunFifo<true>(DataReader src, u32* cycles);
-template u8* RunFifo<false>(DataReader src, u32* cycles);
+template u8* RunFifo<true>(DataReader src, u32* cycles, u32* next_command_size);
+template u8* RunFifo<false>(DataReader src, u32* cycles, u32* next_command_size);
 
 }  // namespace OpcodeDecoder
@@ -273,8 +273,72 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
   return size;
 }
 
+// Returns the size of the command at data without running it. If the size isn't known yet, returns
+// the number of bytes needed to tell, which is more than available.
+template <typename T, typename = std::enable_if_t<std::is_base_of_v<Callback, T>>>
+DOLPHIN_FORCE_INLINE u32 GetCommandSize(const u8* data, u32 available, T& callback)
+{
+  if (available < 1)
+    return 1;
+
+  const Opcode cmd = static_cast<Opcode>(data[0]);
+  switch (cmd)
+  {
+  case Opcode::GX_LOAD_CP_REG:
+    return 6;
+
+  case Opcode::GX_LOAD_XF_REG:
+    if (available < 5)
+      return 5;
+    return 5 + (((Common::swap32(&data[1]) >> 16) & 0xf) + 1) * 4;
+
+  case Opcode::GX_LOAD_INDX_A:
+  case Opcode::GX_LOAD_INDX_B:
+  case Opcode::GX_LOAD_INDX_C:
+  case Opcode::GX_LOAD_INDX_D:
+  case Opcode::GX_LOAD_BP_REG:
+    return 5;
+
+  case Opcode::GX_CMD_CALL_DL:
+    return 9;
+
+  default:
+    if (cmd >= Opcode::GX_PRIMITIVE_START && cmd <= Opcode::GX_PRIMITIVE_END)
+    {
+      if (available < 3)
+        return 3;
+      const u8 vat = static_cast<u8>(cmd) & OpcodeDecoder::GX_VAT_MASK;
+      return 3 + Common::swap16(&data[1]) * callback.GetVertexSize(vat);
+    }
+    // NOPs and unknown opcodes are a single byte.
+    return 1;
+  }
+}
+
+// A run of complete XF loads which write consecutive words of XF memory, and can be loaded at once.
+struct XFLoadBatch
+{
+  u16 address = 0;
+  u32 num_words = 0;
+  u32 num_commands = 0;
+  // The size of the commands in the FIFO.
+  u32 size = 0;
+};
+
+// LoadXFReg takes up to 255 words at once.
+constexpr u32 MAX_XF_BATCH_WORDS = 0xff;
+
+// Scans the commands at data for a batch of XF loads, starting with the first command. Stops at
+// any other command, at a load which doesn't continue where the last one ended, at XF registers,
+// and at a load that hasn't fully arrived. num_commands is 0 if data doesn't start with such a
+// load.
+XFLoadBatch ScanXFLoadBatch(const u8* data, u32 available);
+
+// Runs the complete commands in src, and returns a pointer to the first one that isn't.
+// next_command_size receives the size returned by GetCommandSize for that command, or 0 if every
+// command was run, so that callers can wait until it has arrived instead of scanning it again.
 template <bool is_preprocess = false>
-u8* RunFifo(DataReader src, u32* cycles);
+u8* RunFifo(DataReader src, u32* cycles, u32* next_command_size = nullptr);
 
 }  // namespace OpcodeDecoder
 
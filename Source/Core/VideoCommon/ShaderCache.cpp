@@ -3,11 +3,20 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
+#include "Common/TraceRecorder.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/AbstractGfx.h"
@@ -16,6 +25,7 @@
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/Spirv.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -42,6 +52,13 @@ bool ShaderCache::Initialize()
   m_api_type = g_ActiveConfig.backend_info.api_type;
   m_host_config.bits = ShaderHostConfig::GetCurrent().bits;
 
+  // Backends other than OpenGL compile through SPIR-V, so cache it before the first shaders.
+  if (g_ActiveConfig.bShaderCache && m_api_type != APIType::OpenGL &&
+      m_api_type != APIType::Nothing)
+  {
+    SPIRV::OpenDiskCache(m_api_type);
+  }
+
   if (!CompileSharedPipelines())
     return false;
 
@@ -62,6 +79,9 @@ void ShaderCache::InitializeShaderCache()
     LoadPipelineUIDCache();
   }
 
+  // Compile the pipelines from the game's UID manifest, if any, before anything else.
+  PrecompileManifestPipelines();
+
   // Queue ubershader precompiling if required.
   if (g_ActiveConfig.UsingUberShaders())
     QueueUberShaderPipelines();
@@ -111,7 +131,20 @@ void ShaderCache::Shutdown()
   if (m_async_shader_compiler)
     m_async_shader_compiler->StopWorkerThreads();
 
+  if (g_ActiveConfig.bDumpShaderManifest)
+  {
+    const std::string filename = File::GetUserPath(D_DUMP_IDX) + SHADER_MANIFESTS_DIR DIR_SEP +
+                                 SConfig::GetInstance().GetGameID() + ".uidmanifest";
+    if (ExportPipelineUIDManifest(filename))
+      INFO_LOG_FMT(VIDEO, "Wrote {} pipeline UIDs to {}", m_gx_pipeline_cache.size(), filename);
+  }
+
   ClosePipelineUIDCache();
+  SPIRV::CloseDiskCache();
+
+  INFO_LOG_FMT(VIDEO, "Shader source memo: {} hits, {} misses, {} KiB", m_source_memo.GetHits(),
+               m_source_memo.GetMisses(), m_source_memo.GetSize() / 1024);
+  m_source_memo.Clear();
 }
 
 const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
@@ -124,7 +157,10 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
+  {
+    TRACE_ZONE("ShaderCache::CompilePipeline");
     pipeline = g_gfx->CreatePipeline(*pipeline_config);
+  }
   if (g_ActiveConfig.bShaderCache && !exists_in_cache)
     AppendGXPipelineUID(uid);
   return InsertGXPipeline(uid, std::move(pipeline));
@@ -156,7 +192,10 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
+  {
+    TRACE_ZONE("ShaderCache::CompileUberPipeline");
     pipeline = g_gfx->CreatePipeline(*pipeline_config);
+  }
   return InsertGXUberPipeline(uid, std::move(pipeline));
 }
 
@@ -225,6 +264,28 @@ static void UnserializePipelineUid(const SerializedUidType& uid, UidType& real_u
   real_uid.blending_state.hex = uid.blending_state_bits;
 }
 
+// Reads a UID cache in the format used before it was switched to IndexedDiskCache, i.e. a header
+// followed by the raw UIDs. Returns an empty list if the file is in any other format.
+static std::vector<SerializedGXPipelineUid> ReadLegacyPipelineUIDCache(const std::string& filename)
+{
+  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
+  File::IOFile file(filename, "rb");
+  u32 magic;
+  u32 version;
+  if (!file.ReadArray(&magic, 1) || !file.ReadArray(&version, 1) || magic != CACHE_FILE_MAGIC ||
+      version != GX_PIPELINE_UID_VERSION)
+  {
+    return {};
+  }
+
+  // Ignore a partially written UID at the end, e.g. if Dolphin crashed.
+  std::vector<SerializedGXPipelineUid> uids(static_cast<size_t>(
+      (file.GetSize() - sizeof(magic) - sizeof(version)) / sizeof(SerializedGXPipelineUid)));
+  if (!file.ReadArray(uids.data(), uids.size()))
+    return {};
+  return uids;
+}
+
 template <ShaderStage stage, typename K, typename T>
 void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid)
 {
@@ -276,7 +337,7 @@ void ShaderCache::ClearShaderCache(T& cache)
 }
 
 template <typename KeyType, typename DiskKeyType, typename T>
-void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
+void ShaderCache::LoadPipelineCache(T& cache, Common::IndexedDiskCache<DiskKeyType, u8>& disk_cache,
                                     APIType api_type, const char* type, bool include_gameid)
 {
   class CacheReader : public Common::LinearDiskCacheReader<DiskKeyType, u8>
@@ -432,33 +493,45 @@ void ShaderCache::CompileMissingPipelines()
 
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
-  return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
+  TRACE_ZONE("ShaderCache::CompileVertexShader");
+  const ShaderSourceMemo::Source source_code =
+      m_source_memo.Get(ShaderSourceMemo::Kind::Vertex, m_api_type, m_host_config, uid, [&] {
+        return GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
+      });
+  return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, *source_code);
 }
 
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
-  return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer(),
+  TRACE_ZONE("ShaderCache::CompileVertexUberShader");
+  const ShaderSourceMemo::Source source_code =
+      m_source_memo.Get(ShaderSourceMemo::Kind::UberVertex, m_api_type, m_host_config, uid, [&] {
+        return UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
+      });
+  return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, *source_code,
                                        fmt::to_string(*uid.GetUidData()));
 }
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData(), {});
-  return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
+  TRACE_ZONE("ShaderCache::CompilePixelShader");
+  const ShaderSourceMemo::Source source_code =
+      m_source_memo.Get(ShaderSourceMemo::Kind::Pixel, m_api_type, m_host_config, uid, [&] {
+        return GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData(), {});
+      });
+  return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, *source_code);
 }
 
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData(), {});
-  return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer(),
+  TRACE_ZONE("ShaderCache::CompilePixelUberShader");
+  const ShaderSourceMemo::Source source_code =
+      m_source_memo.Get(ShaderSourceMemo::Kind::UberPixel, m_api_type, m_host_config, uid, [&] {
+        return UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData(), {});
+      });
+  return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, *source_code,
                                        fmt::to_string(*uid.GetUidData()));
 }
 
@@ -552,10 +625,12 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
 const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid& uid)
 {
-  const ShaderCode source_code =
-      GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
+  const ShaderSourceMemo::Source source_code =
+      m_source_memo.Get(ShaderSourceMemo::Kind::Geometry, m_api_type, m_host_config, uid, [&] {
+        return GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
+      });
   std::unique_ptr<AbstractShader> shader =
-      g_gfx->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
+      g_gfx->CreateShaderFromSource(ShaderStage::Geometry, *source_code,
                                     fmt::format("Geometry shader: {}", *uid.GetUidData()));
 
   auto& entry = m_gs_cache.shader_map[uid];
@@ -922,81 +997,36 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
 
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
+  const std::string filename =
       File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
-  {
-    // If an existing case exists, validate the version before reading entries.
-    u32 existing_magic;
-    u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
-    {
-      // Ensure the expected size matches the actual size of the file. If it doesn't, it means
-      // the cache file may be corrupted, and we should not proceed with loading potentially
-      // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
-      uid_file_valid = file_size == expected_size;
-      if (uid_file_valid)
-      {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
-      }
-
-      // We open the file for reading and writing, so we must seek to the end before writing.
-      if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, File::SeekOrigin::Begin);
-    }
 
-    // If the file is invalid, close it. We re-open and truncate it below.
-    if (!uid_file_valid)
-      m_gx_pipeline_uid_cache_file.Close();
-  }
+  // UID caches are kept across Dolphin versions, so only the UID layout is part of the version.
+  const std::vector<SerializedGXPipelineUid> legacy_uids = ReadLegacyPipelineUIDCache(filename);
+  const std::string version = fmt::format("uid-{}", GX_PIPELINE_UID_VERSION);
+  m_gx_pipeline_uid_cache.Open(filename, version);
+  m_gx_pipeline_uid_cache.ForEach([this](const SerializedGXPipelineUid& uid, const u8*, u32) {
+    // This just adds the pipeline to the map, it is compiled later.
+    AddSerializedGXPipelineUID(uid);
+  });
 
-  // If the file is not open, it means it was either corrupted or didn't exist.
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  for (const SerializedGXPipelineUid& uid : legacy_uids)
   {
-    if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
-    {
-      // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
-      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
-                                              sizeof(GX_PIPELINE_UID_VERSION));
-
-      // Write any current UIDs out to the file.
-      // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
-      // we don't lose the existing UIDs which were previously at the beginning.
-      for (const auto& it : m_gx_pipeline_cache)
-        AppendGXPipelineUID(it.first);
-    }
+    AddSerializedGXPipelineUID(uid);
+    m_gx_pipeline_uid_cache.Append(uid, nullptr, 0);
   }
 
+  // Write any current UIDs which are missing from the file.
+  // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
+  // we don't lose the UIDs which were used in this session before it was opened.
+  for (const auto& it : m_gx_pipeline_cache)
+    AppendGXPipelineUID(it.first);
+
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
 }
 
 void ShaderCache::ClosePipelineUIDCache()
 {
-  // This is left as a method in case we need to append extra data to the file in the future.
-  m_gx_pipeline_uid_cache_file.Close();
+  m_gx_pipeline_uid_cache.Close();
 }
 
 void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
@@ -1015,16 +1045,145 @@ void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
 {
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  if (!m_gx_pipeline_uid_cache.IsOpen())
     return;
 
   SerializedGXPipelineUid disk_uid;
   SerializePipelineUid(config, disk_uid);
-  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  if (!m_gx_pipeline_uid_cache.Contains(disk_uid))
+    m_gx_pipeline_uid_cache.Append(disk_uid, nullptr, 0);
+}
+
+namespace
+{
+// UID manifest format:
+// header
+// SerializedGXPipelineUid uids[header.count];
+struct PipelineUIDManifestHeader
+{
+  u32 magic;
+  u32 version;
+  u32 count;
+  char game_id[20];
+};
+static_assert(sizeof(PipelineUIDManifestHeader) == 32);
+
+constexpr u32 PIPELINE_UID_MANIFEST_MAGIC = 0x4D495550;  // PUIM
+}  // namespace
+
+std::optional<std::vector<SerializedGXPipelineUid>>
+ReadPipelineUIDManifest(const std::string& filename, std::string_view game_id)
+{
+  File::IOFile file(filename, "rb");
+  PipelineUIDManifestHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != PIPELINE_UID_MANIFEST_MAGIC ||
+      header.version != GX_PIPELINE_UID_VERSION)
+  {
+    WARN_LOG_FMT(VIDEO, "{} is not a valid UID manifest for this version of Dolphin.", filename);
+    return std::nullopt;
+  }
+
+  const std::string_view manifest_game_id(header.game_id,
+                                          strnlen(header.game_id, sizeof(header.game_id)));
+  if (manifest_game_id != game_id)
+  {
+    WARN_LOG_FMT(VIDEO, "UID manifest {} is for game {}, ignoring.", filename, manifest_game_id);
+    return std::nullopt;
+  }
+
+  // Check the count against the file size before allocating anything for it.
+  const u64 max_count = (file.GetSize() - sizeof(header)) / sizeof(SerializedGXPipelineUid);
+  std::vector<SerializedGXPipelineUid> uids;
+  if (header.count <= max_count)
+    uids.resize(header.count);
+  if (uids.size() != header.count || !file.ReadArray(uids.data(), uids.size()))
   {
-    WARN_LOG_FMT(VIDEO, "Writing pipeline UID to cache failed, closing file.");
-    m_gx_pipeline_uid_cache_file.Close();
+    WARN_LOG_FMT(VIDEO, "UID manifest {} is truncated.", filename);
+    return std::nullopt;
   }
+
+  return uids;
+}
+
+bool WritePipelineUIDManifest(const std::string& filename, std::string_view game_id,
+                              std::span<const SerializedGXPipelineUid> uids)
+{
+  PipelineUIDManifestHeader header{};
+  header.magic = PIPELINE_UID_MANIFEST_MAGIC;
+  header.version = GX_PIPELINE_UID_VERSION;
+  header.count = static_cast<u32>(uids.size());
+  std::memcpy(header.game_id, game_id.data(), std::min(game_id.size(), sizeof(header.game_id)));
+
+  File::IOFile file;
+  if (!File::CreateFullPath(filename) || !file.Open(filename, "wb") ||
+      !file.WriteArray(&header, 1) || !file.WriteArray(uids.data(), uids.size()))
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to write UID manifest {}", filename);
+    return false;
+  }
+
+  return true;
+}
+
+size_t ShaderCache::ImportPipelineUIDManifest(const std::string& filename)
+{
+  const std::optional<std::vector<SerializedGXPipelineUid>> uids =
+      ReadPipelineUIDManifest(filename, SConfig::GetInstance().GetGameID());
+  if (!uids)
+    return 0;
+
+  const size_t previous_count = m_gx_pipeline_cache.size();
+  for (const SerializedGXPipelineUid& uid : *uids)
+  {
+    AddSerializedGXPipelineUID(uid);
+    if (m_gx_pipeline_uid_cache.IsOpen() && !m_gx_pipeline_uid_cache.Contains(uid))
+      m_gx_pipeline_uid_cache.Append(uid, nullptr, 0);
+  }
+
+  return m_gx_pipeline_cache.size() - previous_count;
+}
+
+bool ShaderCache::ExportPipelineUIDManifest(const std::string& filename) const
+{
+  std::vector<SerializedGXPipelineUid> uids(m_gx_pipeline_cache.size());
+  auto uid_it = uids.begin();
+  for (const auto& it : m_gx_pipeline_cache)
+    SerializePipelineUid(it.first, *(uid_it++));
+
+  return WritePipelineUIDManifest(filename, SConfig::GetInstance().GetGameID(), uids);
+}
+
+void ShaderCache::PrecompileManifestPipelines()
+{
+  const std::string filename = File::GetUserPath(D_LOAD_IDX) + SHADER_MANIFESTS_DIR DIR_SEP +
+                               SConfig::GetInstance().GetGameID() + ".uidmanifest";
+  if (!File::Exists(filename))
+    return;
+
+  const size_t count = ImportPipelineUIDManifest(filename);
+  if (count == 0)
+    return;
+
+  // Unless we are waiting for shaders, or there are no worker threads to compile them on, the
+  // imported pipelines are compiled along with the other missing ones.
+  const u32 num_threads = g_ActiveConfig.GetShaderManifestPrecompilerThreads();
+  if (!g_ActiveConfig.bWaitForShadersBeforeStarting || num_threads == 0)
+    return;
+
+  // Nothing else is running yet, so generate and compile the shaders on every core. Pipelines
+  // whose shaders aren't ready are requeued, so the shaders are all built in one parallel pass and
+  // the pipelines in a second one.
+  NOTICE_LOG_FMT(VIDEO, "Precompiling {} pipelines from {} on {} threads", count, filename,
+                 num_threads);
+
+  const auto start = std::chrono::steady_clock::now();
+  m_async_shader_compiler->ResizeWorkerThreads(num_threads);
+  CompileMissingPipelines();
+  WaitForAsyncCompiler();
+  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  NOTICE_LOG_FMT(VIDEO, "Precompiled {} pipelines in {:.2f} seconds", count, elapsed.count());
 }
 
 void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
@@ -1181,6 +1340,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
 
     bool Compile() override
     {
+      TRACE_ZONE("ShaderCache::CompilePipeline");
       if (config)
         pipeline = g_gfx->CreatePipeline(*config);
       return true;
@@ -1256,6 +1416,7 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
 
     bool Compile() override
     {
+      TRACE_ZONE("ShaderCache::CompileUberPipeline");
       if (config)
         UberPipeline = g_gfx->CreatePipeline(*config);
       return true;
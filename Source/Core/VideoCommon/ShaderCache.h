@@ -9,13 +9,15 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/IOFile.h"
-#include "Common/LinearDiskCache.h"
+#include "Common/IndexedDiskCache.h"
 
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractShader.h"
@@ -62,6 +64,11 @@ public:
   // Retrieves all pending shaders/pipelines from the async compiler.
   void RetrieveAsyncShaders();
 
+  // UID manifests list the pipelines a game uses, so that they can be shared between users and
+  // precompiled before the game starts. Import returns the number of previously unknown UIDs.
+  size_t ImportPipelineUIDManifest(const std::string& filename);
+  bool ExportPipelineUIDManifest(const std::string& filename) const;
+
   // Accesses ShaderGen shader caches
   const AbstractPipeline* GetPipelineForUid(const GXPipelineUid& uid);
   const AbstractPipeline* GetUberPipelineForUid(const GXUberPipelineUid& uid);
@@ -123,6 +130,7 @@ private:
   void LoadPipelineUIDCache();
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
+  void PrecompileManifestPipelines();
   void QueueUberShaderPipelines();
   bool CompileSharedPipelines();
 
@@ -176,7 +184,7 @@ private:
   template <typename T>
   void ClearShaderCache(T& cache);
   template <typename KeyType, typename DiskKeyType, typename T>
-  void LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
+  void LoadPipelineCache(T& cache, Common::IndexedDiskCache<DiskKeyType, u8>& disk_cache,
                          APIType api_type, const char* type, bool include_gameid);
   template <typename T, typename Y>
   void ClearPipelineCache(T& cache, Y& disk_cache);
@@ -197,6 +205,9 @@ private:
   ShaderHostConfig m_host_config = {};
   std::unique_ptr<AsyncShaderCompiler> m_async_shader_compiler;
 
+  // Generated sources, shared between the async compiler's worker threads.
+  mutable ShaderSourceMemo m_source_memo;
+
   // Shared shaders
   std::unique_ptr<AbstractShader> m_screen_quad_vertex_shader;
   std::unique_ptr<AbstractShader> m_texture_copy_vertex_shader;
@@ -216,7 +227,7 @@ private:
       bool pending = false;
     };
     std::map<Uid, Shader> shader_map;
-    Common::LinearDiskCache<Uid, u8> disk_cache;
+    Common::IndexedDiskCache<Uid, u8> disk_cache;
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -228,9 +239,9 @@ private:
   std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
-  File::IOFile m_gx_pipeline_uid_cache_file;
-  Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
-  Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
+  Common::IndexedDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_uid_cache;
+  Common::IndexedDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
+  Common::IndexedDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
   // EFB copy to VRAM/RAM pipelines
   std::map<TextureConversionShaderGen::TCShaderUid, std::unique_ptr<AbstractPipeline>>
@@ -255,6 +266,13 @@ private:
   Common::EventHook m_frame_end_handler;
 };
 
+// Reads the UIDs from a manifest written for game_id. Returns nothing if the file is not a valid
+// manifest for this version of Dolphin and that game.
+std::optional<std::vector<SerializedGXPipelineUid>>
+ReadPipelineUIDManifest(const std::string& filename, std::string_view game_id);
+bool WritePipelineUIDManifest(const std::string& filename, std::string_view game_id,
+                              std::span<const SerializedGXPipelineUid> uids);
+
 }  // namespace VideoCommon
 
 extern std::unique_ptr<VideoCommon::ShaderCache> g_shader_cache;
@@ -3,7 +3,12 @@
 
 #include "VideoCommon/ShaderGenCommon.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
@@ -12,6 +17,38 @@
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
+namespace
+{
+// Buffers of destroyed ShaderCode objects, kept for the next ones created on the same thread.
+constexpr size_t INITIAL_BUFFER_SIZE = 16384;
+constexpr size_t MAX_POOLED_BUFFER_SIZE = 1024 * 1024;
+constexpr size_t MAX_POOLED_BUFFERS = 4;
+thread_local std::vector<std::string> s_buffer_pool;
+}  // namespace
+
+ShaderCode::ShaderCode()
+{
+  if (s_buffer_pool.empty())
+  {
+    m_buffer.reserve(INITIAL_BUFFER_SIZE);
+    return;
+  }
+
+  m_buffer = std::move(s_buffer_pool.back());
+  s_buffer_pool.pop_back();
+  m_buffer.clear();
+}
+
+ShaderCode::~ShaderCode()
+{
+  const size_t capacity = m_buffer.capacity();
+  if (capacity >= INITIAL_BUFFER_SIZE && capacity <= MAX_POOLED_BUFFER_SIZE &&
+      s_buffer_pool.size() < MAX_POOLED_BUFFERS)
+  {
+    s_buffer_pool.push_back(std::move(m_buffer));
+  }
+}
+
 ShaderHostConfig ShaderHostConfig::GetCurrent()
 {
   ShaderHostConfig bits = {};
@@ -51,6 +88,72 @@ ShaderHostConfig ShaderHostConfig::GetCurrent()
   return bits;
 }
 
+ShaderSourceMemo::Key ShaderSourceMemo::MakeKey(Kind kind, APIType api_type,
+                                                const ShaderHostConfig& host_config,
+                                                const void* uid_data, size_t uid_data_size)
+{
+  // Everything besides the UID fits in the seed.
+  const u64 seed = (static_cast<u64>(kind) << 48) | (static_cast<u64>(api_type) << 32) |
+                   static_cast<u64>(host_config.bits);
+  const XXH128_hash_t hash = XXH3_128bits_withSeed(uid_data, uid_data_size, seed);
+  return {hash.low64, hash.high64};
+}
+
+ShaderSourceMemo::Source ShaderSourceMemo::Find(const Key& key)
+{
+  std::lock_guard guard(m_lock);
+  const auto iter = m_sources.find(key);
+  if (iter == m_sources.end())
+  {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  m_hits.fetch_add(1, std::memory_order_relaxed);
+  return iter->second;
+}
+
+ShaderSourceMemo::Source ShaderSourceMemo::Insert(const Key& key, std::string source)
+{
+  auto new_source = std::make_shared<const std::string>(std::move(source));
+  const size_t source_size = new_source->size();
+  if (source_size > m_max_size || m_max_entries == 0)
+    return new_source;
+
+  std::lock_guard guard(m_lock);
+
+  // Another thread may have generated the same shader in the meantime.
+  const auto [iter, inserted] = m_sources.try_emplace(key, new_source);
+  if (!inserted)
+    return iter->second;
+
+  m_insertion_order.push_back(key);
+  m_size += source_size;
+  while (m_size > m_max_size || m_sources.size() > m_max_entries)
+  {
+    const auto oldest = m_sources.find(m_insertion_order.front());
+    m_size -= oldest->second->size();
+    m_sources.erase(oldest);
+    m_insertion_order.pop_front();
+  }
+
+  return new_source;
+}
+
+void ShaderSourceMemo::Clear()
+{
+  std::lock_guard guard(m_lock);
+  m_sources.clear();
+  m_insertion_order.clear();
+  m_size = 0;
+}
+
+size_t ShaderSourceMemo::GetSize() const
+{
+  std::lock_guard guard(m_lock);
+  return m_size;
+}
+
 std::string GetDiskShaderCacheFileName(APIType api_type, const char* type, bool include_gameid,
                                        bool include_host_config, bool include_api)
 {
@@ -3,12 +3,18 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -107,13 +113,38 @@ private:
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
-  ShaderCode() { m_buffer.reserve(16384); }
+  // The buffer is taken from a per-thread pool of previously used ones, so that generating a
+  // shader doesn't have to allocate and grow a new string every time.
+  ShaderCode();
+  ~ShaderCode();
+
+  ShaderCode(const ShaderCode&) = default;
+  ShaderCode(ShaderCode&&) = default;
+  ShaderCode& operator=(const ShaderCode&) = default;
+  ShaderCode& operator=(ShaderCode&&) = default;
+
   const std::string& GetBuffer() const { return m_buffer; }
 
+  // Moves the generated code out, leaving the buffer empty.
+  std::string TakeBuffer() { return std::exchange(m_buffer, {}); }
+
   // Writes format strings using fmtlib format strings.
   template <typename... Args>
   void Write(fmt::format_string<Args...> format, Args&&... args)
   {
+    if constexpr (sizeof...(Args) == 0)
+    {
+      // Most writes are plain text, which can be copied without parsing it as a format string,
+      // unless it contains escaped braces.
+      const fmt::string_view text = format;
+      if (!std::memchr(text.data(), '{', text.size()) &&
+          !std::memchr(text.data(), '}', text.size()))
+      {
+        m_buffer.append(text.data(), text.size());
+        return;
+      }
+    }
+
     fmt::format_to(std::back_inserter(m_buffer), format, std::forward<Args>(args)...);
   }
 
@@ -185,6 +216,83 @@ union ShaderHostConfig
   static ShaderHostConfig GetCurrent();
 };
 
+// In-memory cache of generated shader sources, keyed by a hash of the UID along with everything
+// else that affects the generated code. Shaders that are compiled again, e.g. after the pipeline
+// caches are cleared or when switching back to a previous host config, then don't need to be
+// regenerated. Thread-safe, as the async shader compiler generates sources on worker threads.
+class ShaderSourceMemo
+{
+public:
+  enum class Kind : u32
+  {
+    Vertex,
+    Geometry,
+    Pixel,
+    UberVertex,
+    UberPixel,
+  };
+
+  using Source = std::shared_ptr<const std::string>;
+
+  // Once either limit is exceeded, the oldest sources are dropped.
+  static constexpr size_t DEFAULT_MAX_SIZE = 32 * 1024 * 1024;
+  static constexpr size_t DEFAULT_MAX_ENTRIES = 8192;
+
+  explicit ShaderSourceMemo(size_t max_size = DEFAULT_MAX_SIZE,
+                            size_t max_entries = DEFAULT_MAX_ENTRIES)
+      : m_max_size(max_size), m_max_entries(max_entries)
+  {
+  }
+
+  // Returns the source previously generated for this UID, or calls generate() (which must return a
+  // ShaderCode) and remembers its result.
+  template <typename UidData, typename Generator>
+  Source Get(Kind kind, APIType api_type, const ShaderHostConfig& host_config,
+             const ShaderUid<UidData>& uid, Generator&& generate)
+  {
+    const Key key =
+        MakeKey(kind, api_type, host_config, uid.GetUidDataRaw(), uid.GetUidDataSize());
+    if (Source source = Find(key))
+      return source;
+
+    return Insert(key, generate().TakeBuffer());
+  }
+
+  void Clear();
+
+  size_t GetSize() const;
+  u64 GetHits() const { return m_hits.load(std::memory_order_relaxed); }
+  u64 GetMisses() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+  struct Key
+  {
+    u64 low;
+    u64 high;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const { return static_cast<size_t>(key.low); }
+  };
+
+  static Key MakeKey(Kind kind, APIType api_type, const ShaderHostConfig& host_config,
+                     const void* uid_data, size_t uid_data_size);
+  Source Find(const Key& key);
+  Source Insert(const Key& key, std::string source);
+
+  mutable std::mutex m_lock;
+  std::unordered_map<Key, Source, KeyHash> m_sources;
+  std::deque<Key> m_insertion_order;
+  size_t m_size = 0;
+  size_t m_max_size;
+  size_t m_max_entries;
+  std::atomic<u64> m_hits{0};
+  std::atomic<u64> m_misses{0};
+};
+
 // Gets the filename of the specified type of cache object (e.g. vertex shader, pipeline).
 std::string GetDiskShaderCacheFileName(APIType api_type, const char* type, bool include_gameid,
                                        bool include_host_config, bool include_api = true);
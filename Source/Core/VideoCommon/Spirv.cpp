@@ -3,17 +3,29 @@
 
 #include "VideoCommon/Spirv.h"
 
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <xxhash.h>
+
 // glslang includes
 #include "GlslangToSpv.h"
 #include "ResourceLimits.h"
 #include "disassemble.h"
 
 #include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Version.h"
 
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -21,20 +33,18 @@ namespace
 {
 bool InitializeGlslang()
 {
-  static bool glslang_initialized = false;
-  if (glslang_initialized)
-    return true;
-
-  if (!glslang::InitializeProcess())
-  {
-    PanicAlertFmt("Failed to initialize glslang shader compiler");
-    return false;
-  }
-
-  std::atexit([]() { glslang::FinalizeProcess(); });
+  // Shaders may be compiled from several threads at once, so initialize exactly once.
+  static const bool glslang_initialized = [] {
+    if (!glslang::InitializeProcess())
+    {
+      PanicAlertFmt("Failed to initialize glslang shader compiler");
+      return false;
+    }
 
-  glslang_initialized = true;
-  return true;
+    std::atexit([]() { glslang::FinalizeProcess(); });
+    return true;
+  }();
+  return glslang_initialized;
 }
 
 const TBuiltInResource* GetCompilerResourceLimits()
@@ -43,9 +53,9 @@ const TBuiltInResource* GetCompilerResourceLimits()
 }
 
 std::optional<SPIRV::CodeVector>
-CompileShaderToSPV(EShLanguage stage, APIType api_type,
-                   glslang::EShTargetLanguageVersion language_version, const char* stage_filename,
-                   std::string_view source)
+CompileShaderToSPVUncached(EShLanguage stage, APIType api_type,
+                           glslang::EShTargetLanguageVersion language_version,
+                           const char* stage_filename, std::string_view source)
 {
   if (!InitializeGlslang())
     return std::nullopt;
@@ -67,7 +77,7 @@ CompileShaderToSPV(EShLanguage stage, APIType api_type,
   shader->setStringsWithLengths(&pass_source_code, &pass_source_code_length, 1);
 
   auto DumpBadShader = [&](const char* msg) {
-    static int counter = 0;
+    static std::atomic<int> counter = 0;
     std::string filename = VideoBackendBase::BadShaderFilename(stage_filename, counter++);
     std::ofstream stream;
     File::OpenFStream(stream, filename, std::ios_base::out);
@@ -158,6 +168,151 @@ CompileShaderToSPV(EShLanguage stage, APIType api_type,
 
   return out_code;
 }
+
+// Everything which affects the generated code. Must not contain padding, as it is hashed and
+// written to disk as raw bytes.
+struct CacheKey
+{
+  u64 source_hash_low;
+  u64 source_hash_high;
+  u64 source_length;
+  u32 stage;
+  u32 api_type;
+  u32 language_version;
+  u32 debug_info;
+
+  bool operator==(const CacheKey&) const = default;
+};
+static_assert(sizeof(CacheKey) == 40, "CacheKey must not contain padding");
+
+struct CacheKeyHash
+{
+  size_t operator()(const CacheKey& key) const
+  {
+    return static_cast<size_t>(key.source_hash_low ^ (key.stage << 4) ^ key.api_type);
+  }
+};
+
+class SpirvCache final : public Common::LinearDiskCacheReader<CacheKey, SPIRV::CodeType>
+{
+public:
+  void Read(const CacheKey& key, const SPIRV::CodeType* value, u32 value_size) override
+  {
+    AddToMemoryCache(key, SPIRV::CodeVector(value, value + value_size));
+    m_keys_on_disk.insert(key);
+  }
+
+  std::optional<SPIRV::CodeVector> Lookup(const CacheKey& key)
+  {
+    std::lock_guard lk(m_lock);
+    const auto it = m_code.find(key);
+    if (it == m_code.end())
+      return std::nullopt;
+    return it->second;
+  }
+
+  void Insert(const CacheKey& key, const SPIRV::CodeVector& code)
+  {
+    std::lock_guard lk(m_lock);
+    AddToMemoryCache(key, code);
+
+    // Code which was dropped from the memory cache may be compiled again, but must only be written
+    // to disk once.
+    if (m_disk_cache_open && m_keys_on_disk.insert(key).second)
+      m_disk_cache.Append(key, code.data(), static_cast<u32>(code.size()));
+  }
+
+  void OpenDiskCache(APIType api_type)
+  {
+    std::lock_guard lk(m_lock);
+    const std::string filename = GetDiskShaderCacheFileName(api_type, "spirv", false, false);
+    const u32 count = m_disk_cache.OpenAndRead(filename, *this);
+    m_disk_cache_open = true;
+    INFO_LOG_FMT(VIDEO, "Loaded {} cached SPIR-V shaders from {}", count, filename);
+  }
+
+  void CloseDiskCache()
+  {
+    std::lock_guard lk(m_lock);
+    if (!m_disk_cache_open)
+      return;
+    m_disk_cache.Sync();
+    m_disk_cache.Close();
+    m_disk_cache_open = false;
+    m_keys_on_disk.clear();
+  }
+
+  std::atomic<u64> hits = 0;
+  std::atomic<u64> misses = 0;
+  std::atomic<u64> compile_time_us = 0;
+
+private:
+  // Once the cached code grows past this, the oldest entries are dropped. The disk cache is not
+  // trimmed, so they are only compiled again if they are still in use on the next run.
+  static constexpr size_t MAX_MEMORY_CACHE_SIZE = 64 * 1024 * 1024;
+
+  void AddToMemoryCache(const CacheKey& key, SPIRV::CodeVector code)
+  {
+    const size_t code_size = code.size() * sizeof(SPIRV::CodeType);
+    if (!m_code.try_emplace(key, std::move(code)).second)
+      return;
+
+    m_insertion_order.push_back(key);
+    m_memory_cache_size += code_size;
+    while (m_memory_cache_size > MAX_MEMORY_CACHE_SIZE && m_insertion_order.size() > 1)
+    {
+      const auto it = m_code.find(m_insertion_order.front());
+      m_memory_cache_size -= it->second.size() * sizeof(SPIRV::CodeType);
+      m_code.erase(it);
+      m_insertion_order.pop_front();
+    }
+  }
+
+  std::mutex m_lock;
+  std::unordered_map<CacheKey, SPIRV::CodeVector, CacheKeyHash> m_code;
+  std::deque<CacheKey> m_insertion_order;
+  size_t m_memory_cache_size = 0;
+  Common::LinearDiskCache<CacheKey, SPIRV::CodeType> m_disk_cache;
+  std::unordered_set<CacheKey, CacheKeyHash> m_keys_on_disk;
+  bool m_disk_cache_open = false;
+};
+
+SpirvCache s_cache;
+
+std::optional<SPIRV::CodeVector>
+CompileShaderToSPV(EShLanguage stage, APIType api_type,
+                   glslang::EShTargetLanguageVersion language_version, const char* stage_filename,
+                   std::string_view source)
+{
+  const XXH128_hash_t source_hash = XXH3_128bits(source.data(), source.size());
+  CacheKey key{};
+  key.source_hash_low = source_hash.low64;
+  key.source_hash_high = source_hash.high64;
+  key.source_length = source.size();
+  key.stage = static_cast<u32>(stage);
+  key.api_type = static_cast<u32>(api_type);
+  key.language_version = static_cast<u32>(language_version);
+  key.debug_info = g_ActiveConfig.bEnableValidationLayer;
+
+  if (std::optional<SPIRV::CodeVector> code = s_cache.Lookup(key))
+  {
+    s_cache.hits++;
+    return code;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::optional<SPIRV::CodeVector> code =
+      CompileShaderToSPVUncached(stage, api_type, language_version, stage_filename, source);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  s_cache.misses++;
+  s_cache.compile_time_us +=
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+  // Failures are not cached so that they are reported again the next time.
+  if (code)
+    s_cache.Insert(key, *code);
+  return code;
+}
 }  // namespace
 
 namespace SPIRV
@@ -185,4 +340,29 @@ std::optional<CodeVector> CompileComputeShader(std::string_view source_code, API
 {
   return CompileShaderToSPV(EShLangCompute, api_type, language_version, "cs", source_code);
 }
+
+void OpenDiskCache(APIType api_type)
+{
+  s_cache.CloseDiskCache();
+  s_cache.OpenDiskCache(api_type);
+}
+
+void CloseDiskCache()
+{
+  s_cache.CloseDiskCache();
+
+  const CacheStats stats = GetCacheStats();
+  const u64 lookups = stats.hits + stats.misses;
+  if (lookups != 0)
+  {
+    INFO_LOG_FMT(VIDEO, "SPIR-V cache: {} hits, {} misses ({:.1f}% hit rate), {} ms compiling",
+                 stats.hits, stats.misses, stats.hits * 100.0 / lookups,
+                 stats.compile_time_us / 1000);
+  }
+}
+
+CacheStats GetCacheStats()
+{
+  return {s_cache.hits.load(), s_cache.misses.load(), s_cache.compile_time_us.load()};
+}
 }  // namespace SPIRV
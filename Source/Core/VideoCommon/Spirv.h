@@ -34,4 +34,17 @@ std::optional<CodeVector> CompileFragmentShader(std::string_view source_code, AP
 // Compile a compute shader to SPIR-V.
 std::optional<CodeVector> CompileComputeShader(std::string_view source_code, APIType api_type,
                                                glslang::EShTargetLanguageVersion language_version);
+
+// Compilation results are cached in memory, up to a size limit, keyed by a hash of the source code
+// and compiler options. The disk cache additionally persists them across runs.
+void OpenDiskCache(APIType api_type);
+void CloseDiskCache();
+
+struct CacheStats
+{
+  u64 hits;
+  u64 misses;
+  u64 compile_time_us;
+};
+CacheStats GetCacheStats();
 }  // namespace SPIRV
@@ -90,14 +90,46 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Texture memory", "%d KiB", texture_cache_memory_kb);
+  draw_statistic("Texture lookups", "%d", this_frame.num_texture_lookups);
+  draw_statistic("Texture overlaps scanned", "%d", this_frame.num_texture_overlaps_scanned);
+  draw_statistic("Textures evicted", "%d", this_frame.num_textures_evicted);
+  draw_statistic("Textures decoded", "%d", this_frame.num_textures_decoded);
+  draw_statistic("Textures decoded (MT)", "%d", this_frame.num_textures_decoded_parallel);
+  draw_statistic("Texture decode time", "%d us", this_frame.texture_decode_time_us);
+  draw_statistic("Texture rehashes", "%d", this_frame.num_texture_rehashes);
+  draw_statistic("Texture rehashes avoided", "%d", this_frame.num_texture_rehashes_avoided);
+  if (g_ActiveConfig.bHiresTextures)
+  {
+    draw_statistic("Custom textures loaded", "%d", num_hires_textures_loaded);
+    draw_statistic("Custom textures evicted", "%d", num_hires_textures_evicted);
+    draw_statistic("Custom texture memory", "%d KiB", hires_texture_memory_kb);
+    draw_statistic("Custom texture misses", "%d/%d", this_frame.num_hires_texture_misses,
+                   this_frame.num_hires_texture_requests);
+    draw_statistic("Custom textures prefetched", "%d", this_frame.num_hires_texture_prefetches);
+    draw_statistic("Custom asset load latency", "%d us (max %d us)", custom_asset_load_latency_us,
+                   custom_asset_max_load_latency_us);
+    draw_statistic("Custom asset load time", "%d us (max %d us)", custom_asset_load_time_us,
+                   custom_asset_max_load_time_us);
+  }
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
+  draw_statistic("FIFO batches", "%d", this_frame.num_fifo_batches);
+  const double commands_per_batch =
+      this_frame.num_fifo_batches != 0 ?
+          double(this_frame.num_fifo_commands) / this_frame.num_fifo_batches :
+          0.0;
+  draw_statistic("FIFO commands", "%d (%.1f per batch)", this_frame.num_fifo_commands,
+                 commands_per_batch);
+  draw_statistic("FIFO decodes deferred", "%d", this_frame.num_fifo_runs_deferred);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Redundant state writes", "%d", this_frame.num_redundant_state_writes);
+  draw_statistic("Merged state changes", "%d", this_frame.num_merged_state_changes);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -110,10 +142,23 @@ void Statistics::Display() const
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  if (g_ActiveConfig.bCPUCull)
+  {
+    draw_statistic("CPU culled draws", "%d/%d", this_frame.num_cpu_culled_draws,
+                   this_frame.num_cpu_cull_draws);
+    draw_statistic("CPU culled vertices", "%d", this_frame.num_cpu_culled_vertices);
+    draw_statistic("CPU cull time", "%d us", this_frame.cpu_cull_time_us);
+  }
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
+  if (num_frame_dump_frames != 0 || num_frame_dump_drops != 0)
+  {
+    draw_statistic("Frames dumped", "%d", num_frame_dump_frames);
+    draw_statistic("Frames dropped from dump", "%d", num_frame_dump_drops);
+    draw_statistic("Frame dump waits", "%d", num_frame_dump_waits);
+  }
 
   ImGui::Columns(1);
 
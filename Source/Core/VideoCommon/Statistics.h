@@ -18,6 +18,20 @@ struct Statistics
   int num_textures_created = 0;
   int num_textures_uploaded = 0;
   int num_textures_alive = 0;
+  int texture_cache_memory_kb = 0;
+
+  int num_hires_textures_loaded = 0;
+  int num_hires_textures_evicted = 0;
+  int hires_texture_memory_kb = 0;
+  // Averages over all custom asset loads
+  int custom_asset_load_latency_us = 0;
+  int custom_asset_max_load_latency_us = 0;
+  int custom_asset_load_time_us = 0;
+  int custom_asset_max_load_time_us = 0;
+
+  int num_frame_dump_frames = 0;
+  int num_frame_dump_drops = 0;
+  int num_frame_dump_waits = 0;
 
   int num_vertex_loaders = 0;
 
@@ -56,8 +70,20 @@ struct Statistics
     int num_primitive_joins = 0;
     int num_draw_calls = 0;
 
+    // State writes which didn't split the pending draws, as they didn't change anything or only
+    // changed XF memory which the pending draws don't read.
+    int num_redundant_state_writes = 0;
+    int num_merged_state_changes = 0;
+
     int num_dlists_called = 0;
 
+    // Times the GPU woke up to decode FIFO data, the commands it decoded from the FIFO, not
+    // counting those of display lists, and the times decoding was put off as the next command
+    // hadn't fully arrived.
+    int num_fifo_batches = 0;
+    int num_fifo_commands = 0;
+    int num_fifo_runs_deferred = 0;
+
     int bytes_vertex_streamed = 0;
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
@@ -76,6 +102,23 @@ struct Statistics
     int num_efb_peeks = 0;
     int num_efb_pokes = 0;
 
+    int num_textures_decoded = 0;
+    int num_textures_decoded_parallel = 0;
+    int texture_decode_time_us = 0;
+
+    int num_cpu_cull_draws = 0;
+    int num_cpu_culled_draws = 0;
+    int num_cpu_culled_vertices = 0;
+    int cpu_cull_time_us = 0;
+    int num_texture_rehashes = 0;
+    int num_texture_rehashes_avoided = 0;
+    int num_texture_lookups = 0;
+    int num_texture_overlaps_scanned = 0;
+    int num_textures_evicted = 0;
+    int num_hires_texture_requests = 0;
+    int num_hires_texture_misses = 0;
+    int num_hires_texture_prefetches = 0;
+
     int num_draw_done = 0;
     int num_token = 0;
     int num_token_int = 0;
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -25,6 +26,9 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/SmallVector.h"
+#include "Common/Timer.h"
+#include "Common/TraceRecorder.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -61,6 +65,12 @@ static const u64 TEXHASH_INVALID = 0;
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
 
+// Textures smaller than this are decoded on the GPU thread alone, as waking up the decoding threads
+// would take longer than decoding the texture.
+static const u32 MIN_PARALLEL_DECODE_TEXELS = 128 * 128;
+// Each band of a texture that is decoded in parallel covers at least this many texels.
+static const u32 MIN_DECODE_BAND_TEXELS = 64 * 64;
+
 static int xfb_count = 0;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -89,10 +99,92 @@ void TextureCacheBase::CheckTempSize(size_t required_size)
   m_temp = static_cast<u8*>(Common::AllocateAlignedMemory(m_temp_size, 16));
 }
 
+void TextureCacheBase::DecodeTextureLevels(std::span<const CPUDecodedLevel> levels,
+                                           TextureFormat format, const u8* tlut,
+                                           TLUTFormat tlut_format)
+{
+  const u64 start_time = Common::Timer::NowUs();
+
+  u32 total_texels = 0;
+  for (const CPUDecodedLevel& level : levels)
+  {
+    if (level.src)
+      total_texels += level.expanded_width * level.expanded_height;
+  }
+
+  // The format overlay is drawn over each decoded region, so it needs whole levels.
+  const u32 num_threads = m_decoding_pool.GetNumWorkers() + 1;
+  if (num_threads == 1 || total_texels < MIN_PARALLEL_DECODE_TEXELS ||
+      m_backup_config.texfmt_overlay)
+  {
+    for (const CPUDecodedLevel& level : levels)
+    {
+      if (level.src)
+      {
+        TexDecoder_Decode(level.dst, level.src, level.expanded_width, level.expanded_height,
+                          format, tlut, tlut_format);
+      }
+    }
+  }
+  else
+  {
+    // Split the levels into bands of whole block rows, aiming for two bands per thread so that
+    // the threads stay busy when some bands decode faster than others. Small mip levels end up as
+    // a single band, which is decoded alongside the bands of the larger levels.
+    const u32 block_height = TexDecoder_GetBlockHeightInTexels(format);
+    const u32 band_texels = std::max(MIN_DECODE_BAND_TEXELS, total_texels / (num_threads * 2));
+
+    struct LevelBands
+    {
+      u32 block_rows_per_band;
+      u32 num_bands;
+    };
+    Common::SmallVector<LevelBands, 16> level_bands;
+    size_t total_bands = 0;
+    for (const CPUDecodedLevel& level : levels)
+    {
+      const u32 block_rows = level.expanded_height / block_height;
+      const u32 block_row_texels = level.expanded_width * block_height;
+      const u32 rows_per_band =
+          std::max((band_texels + block_row_texels - 1) / block_row_texels, 1u);
+      const u32 num_bands = level.src ? (block_rows + rows_per_band - 1) / rows_per_band : 0;
+      level_bands.push_back({rows_per_band, num_bands});
+      total_bands += num_bands;
+    }
+
+    m_decoding_pool.ParallelFor(total_bands, [&](size_t band) {
+      size_t level_index = 0;
+      while (band >= level_bands[level_index].num_bands)
+        band -= level_bands[level_index++].num_bands;
+
+      const CPUDecodedLevel& level = levels[level_index];
+      const u32 rows_per_band = level_bands[level_index].block_rows_per_band;
+      const u32 first_row = static_cast<u32>(band) * rows_per_band;
+      const u32 num_rows =
+          std::min(rows_per_band, level.expanded_height / block_height - first_row);
+      const u32 y = first_row * block_height;
+      const u8* const src =
+          level.src + TexDecoder_GetTextureSizeInBytes(level.expanded_width, y, format);
+      TexDecoder_Decode(level.dst + y * level.expanded_width * sizeof(u32), src,
+                        level.expanded_width, num_rows * block_height, format, tlut, tlut_format);
+    });
+
+    INCSTAT(g_stats.this_frame.num_textures_decoded_parallel);
+  }
+
+  INCSTAT(g_stats.this_frame.num_textures_decoded);
+  ADDSTAT(g_stats.this_frame.texture_decode_time_us,
+          static_cast<int>(Common::Timer::NowUs() - start_time));
+}
+
 TextureCacheBase::TextureCacheBase()
 {
   SetBackupConfig(g_ActiveConfig);
 
+  m_decoding_pool.Reset("Texture Decoding", m_backup_config.texture_decoding_threads);
+  Core::System::GetInstance().GetMemory().SetWriteTrackingEnabled(
+      m_backup_config.track_texture_writes);
+
   m_temp_size = 2048 * 2048 * 4;
   m_temp = static_cast<u8*>(Common::AllocateAlignedMemory(m_temp_size, 16));
 
@@ -111,8 +203,13 @@ void TextureCacheBase::Shutdown()
 
   HiresTexture::Shutdown();
 
+  // Dumped textures are read back before the GPU context goes away.
+  m_texture_dumper.Shutdown();
+
   // For correctness, we need to invalidate textures before the gpu context starts shutting down.
   Invalidate();
+
+  Core::System::GetInstance().GetMemory().SetWriteTrackingEnabled(false);
 }
 
 TextureCacheBase::~TextureCacheBase()
@@ -141,8 +238,10 @@ void TextureCacheBase::Invalidate()
     bind.reset();
   m_textures_by_hash.clear();
   m_textures_by_address.clear();
+  m_indexed_entry_sizes.clear();
+  m_tracked_texture_hashes.clear();
 
-  m_texture_pool.clear();
+  ClearTexturePool();
 }
 
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
@@ -152,6 +251,10 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
   {
     HiresTexture::Update();
   }
+  else if (config.iHiresTextureBudgetMB != m_backup_config.hires_texture_budget_mb)
+  {
+    HiresTexture::UpdateMemoryBudget();
+  }
 
   const u32 change_count =
       config.graphics_mod_config ? config.graphics_mod_config->GetChangeCount() : 0;
@@ -171,6 +274,15 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  if (config.GetTextureDecodingThreads() != m_backup_config.texture_decoding_threads)
+    m_decoding_pool.Reset("Texture Decoding", config.GetTextureDecodingThreads());
+
+  if (config.bTrackTextureWrites != m_backup_config.track_texture_writes)
+  {
+    Core::System::GetInstance().GetMemory().SetWriteTrackingEnabled(config.bTrackTextureWrites);
+    m_tracked_texture_hashes.clear();
+  }
+
   SetBackupConfig(config);
 }
 
@@ -214,6 +326,23 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
   }
 
+  for (auto iter3 = m_tracked_texture_hashes.begin(); iter3 != m_tracked_texture_hashes.end();)
+  {
+    if (iter3->second.frame_count == FRAMECOUNT_INVALID)
+    {
+      iter3->second.frame_count = _frameCount;
+      ++iter3;
+    }
+    else if (_frameCount > TEXTURE_KILL_THRESHOLD + iter3->second.frame_count)
+    {
+      iter3 = m_tracked_texture_hashes.erase(iter3);
+    }
+    else
+    {
+      ++iter3;
+    }
+  }
+
   TexPool::iterator iter2 = m_texture_pool.begin();
   TexPool::iterator tcend2 = m_texture_pool.end();
   while (iter2 != tcend2)
@@ -224,13 +353,78 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
     if (_frameCount > TEXTURE_POOL_KILL_THRESHOLD + iter2->second.frameCount)
     {
-      iter2 = m_texture_pool.erase(iter2);
+      iter2 = EraseFromTexturePool(iter2);
     }
     else
     {
       ++iter2;
     }
   }
+
+  EnforceMemoryBudget(_frameCount);
+}
+
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  const u64 budget = static_cast<u64>(std::max(g_ActiveConfig.iTextureCacheBudgetMB, 0)) << 20;
+  if (budget == 0 || m_texture_memory_usage <= budget)
+    return;
+
+  // Unused textures in the pool can go right away, oldest first. Textures released to the pool
+  // during this frame still have FRAMECOUNT_INVALID, and go last.
+  const auto trim_pool = [this, budget] {
+    std::vector<TexPool::iterator> pool_entries;
+    pool_entries.reserve(m_texture_pool.size());
+    for (auto iter = m_texture_pool.begin(); iter != m_texture_pool.end(); ++iter)
+      pool_entries.push_back(iter);
+    const auto last_use = [](const TexPool::iterator& iter) {
+      const int frame_count = iter->second.frameCount;
+      return frame_count == FRAMECOUNT_INVALID ? std::numeric_limits<int>::max() : frame_count;
+    };
+    std::sort(pool_entries.begin(), pool_entries.end(),
+              [&](const auto& a, const auto& b) { return last_use(a) < last_use(b); });
+    for (const auto& iter : pool_entries)
+    {
+      if (m_texture_memory_usage <= budget)
+        break;
+      EraseFromTexturePool(iter);
+      INCSTAT(g_stats.this_frame.num_textures_evicted);
+    }
+  };
+
+  trim_pool();
+  if (m_texture_memory_usage <= budget)
+    return;
+
+  // Then evict the least recently used entries which weren't used in this frame. EFB and XFB copies
+  // may only exist on the host GPU, so they are left alone, just like in Cleanup.
+  std::vector<TexAddrCache::iterator> candidates;
+  for (auto iter = m_textures_by_address.begin(); iter != m_textures_by_address.end(); ++iter)
+  {
+    const RcTcacheEntry& entry = iter->second;
+    if (!entry->IsCopy() && !entry->IsLocked() && entry->frameCount != FRAMECOUNT_INVALID &&
+        entry->frameCount < frame_count)
+    {
+      candidates.push_back(iter);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+    return a->second->frameCount < b->second->frameCount;
+  });
+
+  u64 freed = 0;
+  const u64 excess = m_texture_memory_usage - budget;
+  for (const auto& iter : candidates)
+  {
+    if (freed >= excess)
+      break;
+    if (iter->second->texture)
+      freed += iter->second->texture->GetConfig().GetMemorySize();
+    InvalidateTexture(iter);
+  }
+
+  // The evicted entries have released their textures to the pool, unless they are still bound.
+  trim_pool();
 }
 
 bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -251,6 +445,7 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   m_backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   m_backup_config.hires_textures = config.bHiresTextures;
   m_backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  m_backup_config.hires_texture_budget_mb = config.iHiresTextureBudgetMB;
   m_backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   m_backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   m_backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
@@ -259,6 +454,8 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   m_backup_config.graphics_mods = config.bGraphicMods;
   m_backup_config.graphics_mod_change_count =
       config.graphics_mod_config ? config.graphics_mod_config->GetChangeCount() : 0;
+  m_backup_config.texture_decoding_threads = config.GetTextureDecodingThreads();
+  m_backup_config.track_texture_writes = config.bTrackTextureWrites;
 }
 
 bool TextureCacheBase::DidLinkedAssetsChange(const TCacheEntry& entry)
@@ -267,8 +464,13 @@ bool TextureCacheBase::DidLinkedAssetsChange(const TCacheEntry& entry)
   {
     if (cached_asset.m_asset)
     {
-      if (cached_asset.m_asset->GetLastLoadedTime() > cached_asset.m_cached_write_time)
+      // An unloaded texture keeps its load time, wait for its data to come back rather than
+      // recreating the entry with the native texture again
+      if (cached_asset.m_asset->GetLastLoadedTime() > cached_asset.m_cached_write_time &&
+          cached_asset.m_asset->GetData())
+      {
         return true;
+      }
     }
   }
 
@@ -348,7 +550,7 @@ RcTcacheEntry TextureCacheBase::ApplyPaletteToEntry(RcTcacheEntry& entry, const
     g_gfx->EndUtilityDrawing();
   }
 
-  m_textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  AddToAddressCache(decoded_entry);
 
   return decoded_entry;
 }
@@ -394,7 +596,7 @@ RcTcacheEntry TextureCacheBase::ReinterpretEntry(const RcTcacheEntry& existing_e
   g_gfx->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  m_textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  AddToAddressCache(reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -748,7 +950,10 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     auto& entry = GetEntry(id);
     if (entry)
-      m_textures_by_address.emplace(addr, entry);
+    {
+      ASSERT(entry->addr == addr);
+      AddToAddressCache(entry);
+    }
   }
 
   // Fill in hash map.
@@ -791,6 +996,9 @@ void TextureCacheBase::OnFrameEnd()
   // copies.
   FlushEFBCopies();
 
+  // Read back the textures dumped during the frame together, rather than waiting for each one.
+  m_texture_dumper.Flush();
+
   Cleanup(g_presenter->FrameCount());
 }
 
@@ -852,6 +1060,7 @@ RcTcacheEntry TextureCacheBase::DoPartialTextureUpdates(RcTcacheEntry& entry_to_
   auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlaps_scanned);
     auto& entry = iter.first->second;
     if (entry != entry_to_update && entry->IsCopy() &&
         entry->references.count(entry_to_update.get()) == 0 &&
@@ -1245,6 +1454,7 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  TRACE_ZONE("TextureCacheBase::Load");
   if (auto entry = LoadImpl(texture_info, false))
   {
     if (!DidLinkedAssetsChange(*entry))
@@ -1296,11 +1506,11 @@ TCacheEntry* TextureCacheBase::LoadImpl(const TextureInfo& texture_info, bool fo
   entry->frameCount = FRAMECOUNT_INVALID;
   if (entry->texture_info_name.empty() && g_ActiveConfig.bGraphicMods)
   {
-    entry->texture_info_name = texture_info.CalculateTextureName().GetFullName();
+    entry->SetTextureInfoName(texture_info.CalculateTextureName().GetFullName());
 
     GraphicsModActionData::TextureLoad texture_load{entry->texture_info_name};
     for (const auto& action :
-         g_graphics_mod_manager->GetTextureLoadActions(entry->texture_info_name))
+         g_graphics_mod_manager->GetTextureLoadActions(entry->texture_info_name_key))
     {
       action->OnTextureLoad(&texture_load);
     }
@@ -1315,6 +1525,30 @@ TCacheEntry* TextureCacheBase::LoadImpl(const TextureInfo& texture_info, bool fo
   return entry.get();
 }
 
+u64 TextureCacheBase::GetTextureDataHash(const TextureInfo& texture_info, int sample_size)
+{
+  const u32 size = texture_info.GetTextureSize();
+  auto& memory = Core::System::GetInstance().GetMemory();
+  if (texture_info.IsFromTmem() || !memory.IsWriteTrackingEnabled())
+    return Common::GetHash64(texture_info.GetData(), size, sample_size);
+
+  const u32 address = texture_info.GetRawAddress();
+  auto [iter, inserted] = m_tracked_texture_hashes.try_emplace({address, size, sample_size});
+  TrackedTextureHash& tracked = iter->second;
+  tracked.frame_count = FRAMECOUNT_INVALID;
+  if (!inserted && !memory.WasWrittenSince(address, size, tracked.token))
+  {
+    INCSTAT(g_stats.this_frame.num_texture_rehashes_avoided);
+    return tracked.hash;
+  }
+
+  // Start tracking before hashing, so that writes which race with the hash aren't missed.
+  tracked.token = memory.TrackWrites(address, size);
+  tracked.hash = Common::GetHash64(texture_info.GetData(), size, sample_size);
+  INCSTAT(g_stats.this_frame.num_texture_rehashes);
+  return tracked.hash;
+}
+
 RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
                                            const TextureInfo& texture_info)
 {
@@ -1351,15 +1585,13 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  base_hash = GetTextureDataHash(texture_info, textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
     palette_size = *texture_info.GetPaletteSize();
-    full_hash =
-        base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
-                                      textureCacheSafetyColorSampleSize);
+    // Palettes are small, so always hash all of it.
+    full_hash = base_hash ^ Common::HashXXH3(texture_info.GetTlutAddress(), palette_size);
   }
   else
   {
@@ -1393,6 +1625,7 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
   //
   // For efb copies, the entry created in CopyRenderTargetToTexture always has to be used, or else
   // it was done in vain.
+  INCSTAT(g_stats.this_frame.num_texture_lookups);
   auto iter_range = m_textures_by_address.equal_range(texture_info.GetRawAddress());
   TexAddrCache::iterator iter = iter_range.first;
   TexAddrCache::iterator oldest_entry = iter;
@@ -1619,7 +1852,8 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
     texture_name = texture_info.CalculateTextureName().GetFullName();
     GraphicsModActionData::TextureCreate texture_create{
         texture_name, width, height, &cached_game_assets, &additional_dependencies};
-    for (const auto& action : g_graphics_mod_manager->GetTextureCreateActions(texture_name))
+    for (const auto& action : g_graphics_mod_manager->GetTextureCreateActions(
+             GraphicsModManager::GetTextureKey(texture_name)))
     {
       action->OnTextureCreate(&texture_create);
     }
@@ -1629,7 +1863,13 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
   for (auto& cached_asset : cached_game_assets)
   {
     auto data = cached_asset.m_asset->GetData();
-    if (data)
+    if (!data)
+    {
+      // The native texture is used until the data is loaded, which may be the same data as
+      // before it was unloaded, so any load has to recreate the entry
+      cached_asset.m_cached_write_time = {};
+    }
+    else
     {
       if (cached_asset.m_asset->Validate(texture_info.GetRawWidth(), texture_info.GetRawHeight()))
       {
@@ -1644,7 +1884,7 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
                          std::move(data_for_assets), has_arbitrary_mipmaps, skip_texture_dump);
   entry->linked_game_texture_assets = std::move(cached_game_assets);
   entry->linked_asset_dependencies = std::move(additional_dependencies);
-  entry->texture_info_name = std::move(texture_name);
+  entry->SetTextureInfoName(std::move(texture_name));
   return entry;
 }
 
@@ -1728,6 +1968,10 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     // Initialized to null because only software loading uses this buffer
     u8* dst_buffer = nullptr;
 
+    // Levels are decoded on the CPU all at once, so that the decoding threads can work on them
+    // together. There are at most 11 levels, for a 1024x1024 texture.
+    Common::SmallVector<CPUDecodedLevel, 16> cpu_levels;
+
     if (!decode_on_gpu ||
         !DecodeTextureOnGPU(
             entry, 0, texture_info.GetData(), texture_info.GetTextureSize(),
@@ -1757,21 +2001,18 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
       dst_buffer = m_temp;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        cpu_levels.push_back({0, width, height, expanded_width, expanded_height,
+                              texture_info.GetData(), dst_buffer});
       }
       else
       {
         TexDecoder_DecodeRGBA8FromTmem(dst_buffer, texture_info.GetData(),
                                        texture_info.GetTmemOddAddress(), expanded_width,
                                        expanded_height);
+        cpu_levels.push_back(
+            {0, width, height, expanded_width, expanded_height, nullptr, dst_buffer});
       }
 
-      entry->texture->Load(0, width, height, expanded_width, dst_buffer, decoded_texture_size);
-
-      arbitrary_mip_detector.AddLevel(width, height, expanded_width, dst_buffer);
-
       dst_buffer += decoded_texture_size;
     }
 
@@ -1793,19 +2034,27 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
-        entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
-                             mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
-
-        arbitrary_mip_detector.AddLevel(mip_level->GetRawWidth(), mip_level->GetRawHeight(),
-                                        mip_level->GetExpandedWidth(), dst_buffer);
+        cpu_levels.push_back({level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
+                              mip_level->GetExpandedWidth(), mip_level->GetExpandedHeight(),
+                              mip_level->GetData(), dst_buffer});
 
         dst_buffer += decoded_mip_size;
       }
     }
 
+    if (!cpu_levels.empty())
+    {
+      DecodeTextureLevels(cpu_levels, texture_info.GetTextureFormat(),
+                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+    }
+
+    for (const CPUDecodedLevel& level : cpu_levels)
+    {
+      entry->texture->Load(level.level, level.width, level.height, level.expanded_width,
+                           level.dst, level.expanded_width * sizeof(u32) * level.expanded_height);
+      arbitrary_mip_detector.AddLevel(level.width, level.height, level.expanded_width, level.dst);
+    }
+
     entry->has_arbitrary_mips = arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
 
     if (g_ActiveConfig.bDumpTextures && !skip_texture_dump && texLevels > 0)
@@ -1825,7 +2074,6 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     }
   }
 
-  const auto iter = m_textures_by_address.emplace(texture_info.GetRawAddress(), entry);
   if (safety_color_sample_size == 0 ||
       std::max(texture_info.GetTextureSize(), creation_info.palette_size) <=
           (u32)safety_color_sample_size * 8)
@@ -1843,6 +2091,8 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
+  const auto iter = AddToAddressCache(entry);
+
   INCSTAT(g_stats.num_textures_uploaded);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(m_textures_by_address.size()));
 
@@ -1925,7 +2175,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  m_textures_by_address.emplace(entry->addr, entry);
+  AddToAddressCache(entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(m_textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1934,7 +2184,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
     const std::string id = fmt::format("{}x{}", width, height);
     if (g_ActiveConfig.bGraphicMods)
     {
-      entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+      entry->SetTextureInfoName(fmt::format("{}_{}", XFB_DUMP_PREFIX, id));
     }
 
     if (g_ActiveConfig.bDumpXFBTarget)
@@ -1951,6 +2201,7 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
 
 RcTcacheEntry TextureCacheBase::GetXFBFromCache(u32 address, u32 width, u32 height, u32 stride)
 {
+  INCSTAT(g_stats.this_frame.num_texture_lookups);
   auto iter_range = m_textures_by_address.equal_range(address);
   TexAddrCache::iterator iter = iter_range.first;
 
@@ -1997,6 +2248,8 @@ void TextureCacheBase::StitchXFBCopy(RcTcacheEntry& stitched_entry)
   auto iter = FindOverlappingTextures(stitched_entry->addr, stitched_entry->size_in_bytes);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlaps_scanned);
+
     // Currently, this checks the stride of the VRAM copy against the VI request. Therefore, for
     // interlaced modes, VRAM copies won't be considered candidates. This is okay for now, because
     // our force progressive hack means that an XFB copy should always have a matching stride. If
@@ -2323,7 +2576,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       if (skip == true)
       {
         if (copy_to_ram)
+        {
           UninitializeEFBMemory(dst, dstStride, bytes_per_row, num_blocks_y);
+          memory.MarkWritten(dstAddr, covered_range);
+        }
         return;
       }
     }
@@ -2385,7 +2641,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         const std::string id = fmt::format("{}x{}", tex_w, tex_h);
         if (g_ActiveConfig.bGraphicMods)
         {
-          entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+          entry->SetTextureInfoName(fmt::format("{}_{}", XFB_DUMP_PREFIX, id));
         }
 
         if (g_ActiveConfig.bDumpXFBTarget)
@@ -2401,7 +2657,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         const std::string id = fmt::format("{}x{}_{}", tex_w, tex_h, static_cast<int>(baseFormat));
         if (g_ActiveConfig.bGraphicMods)
         {
-          entry->texture_info_name = fmt::format("{}_{}", EFB_DUMP_PREFIX, id);
+          entry->SetTextureInfoName(fmt::format("{}_{}", EFB_DUMP_PREFIX, id));
         }
 
         if (g_ActiveConfig.bDumpEFBTarget)
@@ -2459,6 +2715,9 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     }
   }
 
+  // Deferred copies are marked again once they are flushed.
+  memory.MarkWritten(dstAddr, covered_range);
+
   // Invalidate all textures, if they are either fully overwritten by our efb copy, or if they
   // have a different stride than our efb copy. Partly overwritten textures with the same stride
   // as our efb copy are marked to check them for partial texture updates.
@@ -2467,6 +2726,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   auto iter = FindOverlappingTextures(dstAddr, covered_range);
   while (iter.first != iter.second)
   {
+    INCSTAT(g_stats.this_frame.num_texture_overlaps_scanned);
     RcTcacheEntry& overlapping_entry = iter.first->second;
 
     if (overlapping_entry->addr == dstAddr && overlapping_entry->is_xfb_copy)
@@ -2540,7 +2800,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    m_textures_by_address.emplace(dstAddr, std::move(entry));
+    AddToAddressCache(std::move(entry));
   }
 }
 
@@ -2581,6 +2841,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   u8* const dst = memory.GetPointerForRange(entry->addr, covered_range);
   WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
                     entry->memory_stride, std::move(entry->pending_efb_copy));
+  memory.MarkWritten(entry->addr, covered_range);
 
   // If the EFB copy was invalidated (e.g. the bloom case mentioned in InvalidateTexture), we don't
   // need to do anything more. The entry will be automatically deleted by smart pointers
@@ -2599,6 +2860,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
     auto range = FindOverlappingTextures(entry->addr, covered_range);
     for (auto iter = range.first; iter != range.second; ++iter)
     {
+      INCSTAT(g_stats.this_frame.num_texture_overlaps_scanned);
       auto& overlapping_entry = iter->second;
       if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
           overlapping_entry->OverlapsMemoryRange(entry->addr, covered_range))
@@ -2733,6 +2995,8 @@ TextureCacheBase::AllocateTexture(const TextureConfig& config)
     }
   }
 
+  m_texture_memory_usage += config.GetMemorySize();
+  SETSTAT(g_stats.texture_cache_memory_kb, m_texture_memory_usage >> 10);
   INCSTAT(g_stats.num_textures_created);
   return TexPoolEntry(std::move(texture), std::move(framebuffer));
 }
@@ -2767,16 +3031,24 @@ TextureCacheBase::TexAddrCache::iterator TextureCacheBase::GetTexCacheIter(TCach
   return m_textures_by_address.end();
 }
 
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddToAddressCache(RcTcacheEntry entry)
+{
+  entry->indexed_size = entry->size_in_bytes;
+  m_indexed_entry_sizes[entry->indexed_size]++;
+  const u32 addr = entry->addr;
+  return m_textures_by_address.emplace(addr, std::move(entry));
+}
+
 std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
   // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
+  // which end after the given addr. But we know the size of the largest texture in the cache,
+  // so no texture which starts further than that before addr can overlap. This is usually a much
+  // smaller window than the largest possible texture size (1024 x 1024 texels times 8 nibbles),
+  // but it still yields false-positives which must be checked later on.
+  const u32 max_texture_size =
+      m_indexed_entry_sizes.empty() ? 0 : m_indexed_entry_sizes.rbegin()->first;
   u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
   auto begin = m_textures_by_address.lower_bound(lower_addr);
   auto end = m_textures_by_address.upper_bound(addr + size_in_bytes);
@@ -2828,9 +3100,28 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
   }
   entry->invalidated = true;
 
+  auto size_iter = m_indexed_entry_sizes.find(entry->indexed_size);
+  if (size_iter != m_indexed_entry_sizes.end() && --size_iter->second == 0)
+    m_indexed_entry_sizes.erase(size_iter);
+
   return m_textures_by_address.erase(iter);
 }
 
+TextureCacheBase::TexPool::iterator TextureCacheBase::EraseFromTexturePool(TexPool::iterator iter)
+{
+  m_texture_memory_usage -= iter->first.GetMemorySize();
+  SETSTAT(g_stats.texture_cache_memory_kb, m_texture_memory_usage >> 10);
+  return m_texture_pool.erase(iter);
+}
+
+void TextureCacheBase::ClearTexturePool()
+{
+  for (const auto& [config, pool_entry] : m_texture_pool)
+    m_texture_memory_usage -= config.GetMemorySize();
+  SETSTAT(g_stats.texture_cache_memory_kb, m_texture_memory_usage >> 10);
+  m_texture_pool.clear();
+}
+
 void TextureCacheBase::ReleaseToPool(TCacheEntry* entry)
 {
   if (!entry->texture)
@@ -3144,6 +3435,12 @@ void TCacheEntry::SetNotCopy()
   is_xfb_container = false;
 }
 
+void TCacheEntry::SetTextureInfoName(std::string name)
+{
+  texture_info_name = std::move(name);
+  texture_info_name_key = GraphicsModManager::GetTextureKey(texture_info_name);
+}
+
 int TCacheEntry::HashSampleSize() const
 {
   if (should_force_safe_hashing)
@@ -3155,6 +3452,33 @@ int TCacheEntry::HashSampleSize() const
 }
 
 u64 TCacheEntry::CalculateHash() const
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  if (!memory.IsWriteTrackingEnabled())
+    return CalculateHashUncached();
+
+  const u32 hashed_size =
+      memory_stride == BytesPerRow() ? size_in_bytes : memory_stride * NumBlocksY();
+  if (has_tracked_hash && tracked_hash_addr == addr && tracked_hash_size == hashed_size &&
+      tracked_hash_stride == memory_stride &&
+      !memory.WasWrittenSince(addr, hashed_size, tracked_hash_token))
+  {
+    INCSTAT(g_stats.this_frame.num_texture_rehashes_avoided);
+    return tracked_hash;
+  }
+
+  // Start tracking before hashing, so that writes which race with the hash aren't missed.
+  tracked_hash_token = memory.TrackWrites(addr, hashed_size);
+  tracked_hash = CalculateHashUncached();
+  tracked_hash_addr = addr;
+  tracked_hash_size = hashed_size;
+  tracked_hash_stride = memory_stride;
+  has_tracked_hash = true;
+  INCSTAT(g_stats.this_frame.num_texture_rehashes);
+  return tracked_hash;
+}
+
+u64 TCacheEntry::CalculateHashUncached() const
 {
   const u32 bytes_per_row = BytesPerRow();
   const u32 hash_sample_size = HashSampleSize();
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -20,6 +21,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/Assets/CustomAsset.h"
@@ -156,6 +158,9 @@ struct TCacheEntry
   // removing the cache entry
   std::multimap<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
 
+  // size_in_bytes at the time the entry was added to m_textures_by_address
+  u32 indexed_size = 0;
+
   // This is used to keep track of both:
   //   * efb copies used by this partially updated texture
   //   * partially updated textures which refer to this efb copy
@@ -167,6 +172,17 @@ struct TCacheEntry
   u32 pending_efb_copy_height = 0;
 
   std::string texture_info_name = "";
+  // Hash of texture_info_name, which graphics mod actions are looked up by
+  u64 texture_info_name_key = 0;
+
+  // Result of the last CalculateHash call, which stays valid until the guest writes to the hashed
+  // memory range. Only used with the TrackTextureWrites hack.
+  mutable u64 tracked_hash = 0;
+  mutable u64 tracked_hash_token = 0;
+  mutable u32 tracked_hash_addr = 0;
+  mutable u32 tracked_hash_size = 0;
+  mutable u32 tracked_hash_stride = 0;
+  mutable bool has_tracked_hash = false;
 
   std::vector<VideoCommon::CachedAsset<VideoCommon::GameTextureAsset>> linked_game_texture_assets;
   std::vector<VideoCommon::CachedAsset<VideoCommon::CustomAsset>> linked_asset_dependencies;
@@ -220,6 +236,8 @@ struct TCacheEntry
   void SetEfbCopy(u32 stride);
   void SetNotCopy();
 
+  void SetTextureInfoName(std::string name);
+
   bool OverlapsMemoryRange(u32 range_address, u32 range_size) const;
 
   bool IsEfbCopy() const { return is_efb_copy; }
@@ -229,6 +247,7 @@ struct TCacheEntry
   u32 BytesPerRow() const;
 
   u64 CalculateHash() const;
+  u64 CalculateHashUncached() const;
 
   int HashSampleSize() const;
   u32 GetWidth() const { return texture->GetConfig().width; }
@@ -370,13 +389,34 @@ private:
 
   void CheckTempSize(size_t required_size);
 
+  // A texture level which is decoded on the CPU into the temporary buffer.
+  struct CPUDecodedLevel
+  {
+    u32 level;
+    u32 width;
+    u32 height;
+    u32 expanded_width;
+    u32 expanded_height;
+    // Null when the level has already been decoded.
+    const u8* src;
+    u8* dst;
+  };
+
+  // Decodes all levels, splitting large textures into bands of blocks for the decoding threads.
+  void DecodeTextureLevels(std::span<const CPUDecodedLevel> levels, TextureFormat format,
+                           const u8* tlut, TLUTFormat tlut_format);
+
   RcTcacheEntry AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
-  // Return all possible overlapping textures. As addr+size of the textures is not
-  // indexed, this may return false positives.
+  // Entries must only be added to m_textures_by_address through this, so that the largest entry
+  // size used by FindOverlappingTextures stays up to date.
+  TexAddrCache::iterator AddToAddressCache(RcTcacheEntry entry);
+
+  // Return all possible overlapping textures. Only textures which start at most the size of the
+  // largest cached texture before addr are returned, but this may still include false positives.
   std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
   FindOverlappingTextures(u32 addr, u32 size_in_bytes);
 
@@ -384,6 +424,13 @@ private:
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
                                            bool discard_pending_efb_copy = false);
 
+  TexPool::iterator EraseFromTexturePool(TexPool::iterator iter);
+  void ClearTexturePool();
+
+  // Evicts unused textures, least recently used first, until the cache fits in the configured
+  // memory budget.
+  void EnforceMemoryBudget(int frame_count);
+
   void UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
   void UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
 
@@ -404,6 +451,10 @@ private:
   // Returns an EFB copy staging texture to the pool, so it can be re-used.
   void ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> tex);
 
+  // Hashes the data of a texture for the lookup, skipping the hash if the data hasn't been written
+  // since it was last hashed.
+  u64 GetTextureDataHash(const TextureInfo& texture_info, int sample_size);
+
   bool CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format);
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
@@ -412,10 +463,23 @@ private:
   // but it's possible for invalidated TCache entries to live on elsewhere
   TexAddrCache m_textures_by_address;
 
+  // Number of entries in m_textures_by_address for each entry size.
+  std::map<u32, u32> m_indexed_entry_sizes;
+
   // m_textures_by_hash is an alternative view of the texture cache
   // All textures in here will also be in m_textures_by_address
   TexHashCache m_textures_by_hash;
 
+  // Hashes of texture data in RAM by address, size and sample count, which are reused until the
+  // guest writes to the hashed range. Only used with the TrackTextureWrites hack.
+  struct TrackedTextureHash
+  {
+    u64 hash = 0;
+    u64 token = 0;
+    int frame_count = FRAMECOUNT_INVALID;
+  };
+  std::map<std::tuple<u32, u32, int>, TrackedTextureHash> m_tracked_texture_hashes;
+
   // m_bound_textures are actually active in the current draw
   // It's valid for textures to be in here after they've been invalidated
   std::array<RcTcacheEntry, 8> m_bound_textures{};
@@ -423,6 +487,10 @@ private:
   TexPool m_texture_pool;
   u64 m_last_entry_id = 0;
 
+  // Memory used by all textures allocated through AllocateTexture, whether they are in use by a
+  // cache entry or sitting in the pool.
+  u64 m_texture_memory_usage = 0;
+
   // Backup configuration values
   struct BackupConfig
   {
@@ -431,6 +499,7 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    int hires_texture_budget_mb;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
@@ -439,6 +508,8 @@ private:
     bool arbitrary_mipmap_detection;
     bool graphics_mods;
     u32 graphics_mod_change_count;
+    u32 texture_decoding_threads;
+    bool track_texture_writes;
   };
   BackupConfig m_backup_config = {};
 
@@ -468,6 +539,9 @@ private:
       AfterFrameEvent::Register([this](Core::System&) { OnFrameEnd(); }, "TextureCache");
 
   VideoCommon::TextureUtils::TextureDumper m_texture_dumper;
+
+  // Worker threads that help the GPU thread decode large textures.
+  Common::ThreadPool m_decoding_pool;
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -13,6 +13,7 @@
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Inline.h"
 #include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -165,6 +166,44 @@ static inline void DecodeBytes_IA4(u32* dst, const u8* src)
   }
 }
 
+// Expands the first `num_entries` TLUT entries to RGBA8 colors.
+static void DecodeTLUT(u32* dst, const u8* tlut_, TLUTFormat tlutfmt, int num_entries)
+{
+  const u16* tlut = (u16*)tlut_;
+  switch (tlutfmt)
+  {
+  case TLUTFormat::IA8:
+    for (int i = 0; i < num_entries; i++)
+      dst[i] = DecodePixel_IA8(tlut[i]);
+    break;
+
+  case TLUTFormat::RGB565:
+    for (int i = 0; i < num_entries; i++)
+      dst[i] = DecodePixel_RGB565(Common::swap16(tlut[i]));
+    break;
+
+  case TLUTFormat::RGB5A3:
+    for (int i = 0; i < num_entries; i++)
+      dst[i] = DecodePixel_RGB5A3(Common::swap16(tlut[i]));
+    break;
+
+  default:
+    std::fill_n(dst, num_entries, 0);
+    break;
+  }
+}
+
+// Stores the four rows of a 4x4 block, given rows 0 and 2 in the lanes of `rows02` and rows 1 and 3
+// in the lanes of `rows13`.
+FUNCTION_TARGET_AVX2
+static inline void StoreBlockRows_AVX2(u32* dst, int width, __m256i rows02, __m256i rows13)
+{
+  _mm_storeu_si128((__m128i*)(dst + 0 * width), _mm256_castsi256_si128(rows02));
+  _mm_storeu_si128((__m128i*)(dst + 1 * width), _mm256_castsi256_si128(rows13));
+  _mm_storeu_si128((__m128i*)(dst + 2 * width), _mm256_extracti128_si256(rows02, 1));
+  _mm_storeu_si128((__m128i*)(dst + 3 * width), _mm256_extracti128_si256(rows13, 1));
+}
+
 #ifdef CHECK
 static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
 {
@@ -254,6 +293,78 @@ static void TexDecoder_DecodeImpl_C4(u32* dst, const u8* src, int width, int hei
   }
 }
 
+// Looks up 32 4-bit palette indices (two rows of a C4 block in each lane) in the byte planes of a
+// 16-entry palette and stores the resulting four rows.
+FUNCTION_TARGET_AVX2
+static inline void LookupAndStoreC4Rows_AVX2(u32* dst, int width, __m256i indices,
+                                             const __m256i* planes)
+{
+  const __m256i r = _mm256_shuffle_epi8(planes[0], indices);
+  const __m256i g = _mm256_shuffle_epi8(planes[1], indices);
+  const __m256i b = _mm256_shuffle_epi8(planes[2], indices);
+  const __m256i a = _mm256_shuffle_epi8(planes[3], indices);
+
+  const __m256i rg_lo = _mm256_unpacklo_epi8(r, g);
+  const __m256i ba_lo = _mm256_unpacklo_epi8(b, a);
+  const __m256i rg_hi = _mm256_unpackhi_epi8(r, g);
+  const __m256i ba_hi = _mm256_unpackhi_epi8(b, a);
+
+  // Texels 0-7 of each lane belong to its first row, texels 8-15 to its second row.
+  const __m256i texels0 = _mm256_unpacklo_epi16(rg_lo, ba_lo);
+  const __m256i texels4 = _mm256_unpackhi_epi16(rg_lo, ba_lo);
+  const __m256i texels8 = _mm256_unpacklo_epi16(rg_hi, ba_hi);
+  const __m256i texels12 = _mm256_unpackhi_epi16(rg_hi, ba_hi);
+
+  _mm256_storeu_si256((__m256i*)(dst + 0 * width),
+                      _mm256_permute2x128_si256(texels0, texels4, 0x20));
+  _mm256_storeu_si256((__m256i*)(dst + 1 * width),
+                      _mm256_permute2x128_si256(texels8, texels12, 0x20));
+  _mm256_storeu_si256((__m256i*)(dst + 4 * width),
+                      _mm256_permute2x128_si256(texels0, texels4, 0x31));
+  _mm256_storeu_si256((__m256i*)(dst + 5 * width),
+                      _mm256_permute2x128_si256(texels8, texels12, 0x31));
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Decode the palette once, and split it into one byte plane per channel so that each channel of
+  // 32 texels can be looked up with a single byte shuffle.
+  u32 palette[16];
+  DecodeTLUT(palette, tlut, tlutfmt, 16);
+  alignas(16) u8 plane_bytes[4][16];
+  for (int i = 0; i < 16; i++)
+  {
+    for (int c = 0; c < 4; c++)
+      plane_bytes[c][i] = static_cast<u8>(palette[i] >> (8 * c));
+  }
+  __m256i planes[4];
+  for (int c = 0; c < 4; c++)
+    planes[c] = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)plane_bytes[c]));
+
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0f0f0f0fL);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      // Rows 0-3 of the block end up in the low lane, rows 4-7 in the high lane.
+      const __m256i r = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(r, 4), kMask_x0f);
+      const __m256i lo = _mm256_and_si256(r, kMask_x0f);
+
+      // Interleave the nibbles to get the indices in texel order.
+      const __m256i indices0145 = _mm256_unpacklo_epi8(hi, lo);
+      const __m256i indices2367 = _mm256_unpackhi_epi8(hi, lo);
+
+      u32* dst_row = dst + y * width + x;
+      LookupAndStoreC4Rows_AVX2(dst_row, width, indices0145, planes);
+      LookupAndStoreC4Rows_AVX2(dst_row + 2 * width, width, indices2367, planes);
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_I4_SSSE3(u32* dst, const u8* src, int width, int height,
                                            TextureFormat texformat, const u8* tlut,
@@ -303,6 +414,58 @@ static void TexDecoder_DecodeImpl_I4_SSSE3(u32* dst, const u8* src, int width, i
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0f0f0f0fL);
+  const __m256i kMask_xf0 = _mm256_set1_epi32(0xf0f0f0f0L);
+
+  // Same byte pattern as the SSSE3 version, except that each 256-bit shuffle produces a whole
+  // 8-texel row: the low lane gets texels 0-3 and the high lane texels 4-7.
+  const __m256i mask_even =
+      _mm256_setr_epi8(0, 0, 0, 0, 8, 8, 8, 8, 1, 1, 1, 1, 9, 9, 9, 9,  //
+                       2, 2, 2, 2, 10, 10, 10, 10, 3, 3, 3, 3, 11, 11, 11, 11);
+  const __m256i mask_odd =
+      _mm256_setr_epi8(4, 4, 4, 4, 12, 12, 12, 12, 5, 5, 5, 5, 13, 13, 13, 13,  //
+                       6, 6, 6, 6, 14, 14, 14, 14, 7, 7, 7, 7, 15, 15, 15, 15);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      // Load the whole 8x8 block: rows 0-3 in the low lane, rows 4-7 in the high lane.
+      const __m256i r0 = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+
+      // Replicate the hi and lo nibble of every byte, as in the SSSE3 version.
+      const __m256i i1 = _mm256_and_si256(r0, kMask_xf0);
+      const __m256i i11 = _mm256_or_si256(i1, _mm256_srli_epi16(i1, 4));
+      const __m256i i2 = _mm256_and_si256(r0, kMask_x0f);
+      const __m256i i22 = _mm256_or_si256(i2, _mm256_slli_epi16(i2, 4));
+
+      // Build the SSSE3 "base" for each pair of rows: (rows 0/1 | rows 4/5), (rows 2/3 | rows 6/7)
+      const __m256i base0145 = _mm256_unpacklo_epi64(i11, i22);
+      const __m256i base2367 = _mm256_unpackhi_epi64(i11, i22);
+
+      // Broadcast each row pair to both lanes so that it can be expanded to full rows.
+      const __m256i base01 = _mm256_permute2x128_si256(base0145, base0145, 0x00);
+      const __m256i base45 = _mm256_permute2x128_si256(base0145, base0145, 0x11);
+      const __m256i base23 = _mm256_permute2x128_si256(base2367, base2367, 0x00);
+      const __m256i base67 = _mm256_permute2x128_si256(base2367, base2367, 0x11);
+
+      u32* dst_row = dst + y * width + x;
+      _mm256_storeu_si256((__m256i*)(dst_row + 0 * width), _mm256_shuffle_epi8(base01, mask_even));
+      _mm256_storeu_si256((__m256i*)(dst_row + 1 * width), _mm256_shuffle_epi8(base01, mask_odd));
+      _mm256_storeu_si256((__m256i*)(dst_row + 2 * width), _mm256_shuffle_epi8(base23, mask_even));
+      _mm256_storeu_si256((__m256i*)(dst_row + 3 * width), _mm256_shuffle_epi8(base23, mask_odd));
+      _mm256_storeu_si256((__m256i*)(dst_row + 4 * width), _mm256_shuffle_epi8(base45, mask_even));
+      _mm256_storeu_si256((__m256i*)(dst_row + 5 * width), _mm256_shuffle_epi8(base45, mask_odd));
+      _mm256_storeu_si256((__m256i*)(dst_row + 6 * width), _mm256_shuffle_epi8(base67, mask_even));
+      _mm256_storeu_si256((__m256i*)(dst_row + 7 * width), _mm256_shuffle_epi8(base67, mask_odd));
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_I4(u32* dst, const u8* src, int width, int height,
                                      TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                      int Wsteps4, int Wsteps8)
@@ -425,6 +588,28 @@ static void TexDecoder_DecodeImpl_I8_SSSE3(u32* dst, const u8* src, int width, i
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Every 8-texel row is broadcast to both lanes and expanded with a single shuffle.
+  const __m256i mask = _mm256_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,  //
+                                        4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; ++iy, xStep++)
+      {
+        const __m256i r =
+            _mm256_broadcastq_epi64(_mm_loadl_epi64((const __m128i*)(src + 8 * xStep)));
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), _mm256_shuffle_epi8(r, mask));
+      }
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_I8(u32* dst, const u8* src, int width, int height,
                                      TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                      int Wsteps4, int Wsteps8)
@@ -563,6 +748,30 @@ static void TexDecoder_DecodeImpl_C8(u32* dst, const u8* src, int width, int hei
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Decode the whole palette once and gather from it, instead of converting every texel.
+  u32 palette[256];
+  DecodeTLUT(palette, tlut, tlutfmt, 256);
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        const __m256i indices =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + 8 * xStep)));
+        const __m256i texels = _mm256_i32gather_epi32((const int*)palette, indices, 4);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), texels);
+      }
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_IA4(u32* dst, const u8* src, int width, int height,
                                       TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                       int Wsteps4, int Wsteps8)
@@ -604,6 +813,30 @@ static void TexDecoder_DecodeImpl_IA8_SSSE3(u32* dst, const u8* src, int width,
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // The low lane of a 4x4 block holds rows 0 and 1 and the high lane rows 2 and 3, so shuffling
+  // the low and the high half of each lane yields rows (0, 2) and (1, 3) respectively.
+  const __m256i mask_lo = _mm256_setr_epi8(1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6,  //
+                                           1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6);
+  const __m256i mask_hi =
+      _mm256_setr_epi8(9, 9, 9, 8, 11, 11, 11, 10, 13, 13, 13, 12, 15, 15, 15, 14,  //
+                       9, 9, 9, 8, 11, 11, 11, 10, 13, 13, 13, 12, 15, 15, 15, 14);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      const __m256i r = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      const __m256i rows02 = _mm256_shuffle_epi8(r, mask_lo);
+      const __m256i rows13 = _mm256_shuffle_epi8(r, mask_hi);
+      StoreBlockRows_AVX2(dst + y * width + x, width, rows02, rows13);
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_IA8(u32* dst, const u8* src, int width, int height,
                                       TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                       int Wsteps4, int Wsteps8)
@@ -774,6 +1007,45 @@ static void TexDecoder_DecodeImpl_RGB565(u32* dst, const u8* src, int width, int
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB565_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Same bit swizzling as the SSE2 version, applied to a whole 4x4 block at once.
+  const __m256i kMaskR0 = _mm256_set1_epi32(0x000000F8);
+  const __m256i kMaskG0 = _mm256_set1_epi32(0x0000FC00);
+  const __m256i kMaskG1 = _mm256_set1_epi32(0x00000300);
+  const __m256i kMaskB0 = _mm256_set1_epi32(0x00F80000);
+  const __m256i kAlpha = _mm256_set1_epi32(0xFF000000);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      const __m256i rgb565x16 = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+
+      // Duplicate every 16-bit color into a 32-bit word. The low lane holds rows 0 and 1 and the
+      // high lane rows 2 and 3, so this yields rows (0, 2) and (1, 3).
+      __m256i rows[2] = {_mm256_unpacklo_epi16(rgb565x16, rgb565x16),
+                         _mm256_unpackhi_epi16(rgb565x16, rgb565x16)};
+      for (__m256i& c0 : rows)
+      {
+        const __m256i r0 = _mm256_and_si256(c0, kMaskR0);
+        const __m256i r1 = _mm256_srli_epi32(r0, 5);
+        const __m256i gtmp = _mm256_srli_epi32(c0, 3);
+        const __m256i g0 = _mm256_and_si256(gtmp, kMaskG0);
+        const __m256i g1 = _mm256_and_si256(_mm256_srli_epi32(gtmp, 6), kMaskG1);
+        const __m256i b0 = _mm256_and_si256(_mm256_srli_epi32(c0, 5), kMaskB0);
+        const __m256i b1 = _mm256_srli_epi16(b0, 5);
+        c0 = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(r0, r1), _mm256_or_si256(g0, g1)),
+                             _mm256_or_si256(_mm256_or_si256(b0, b1), kAlpha));
+      }
+
+      StoreBlockRows_AVX2(dst + y * width + x, width, rows[0], rows[1]);
+    }
+  }
+}
+
 FUNCTION_TARGET_SSSE3
 static void TexDecoder_DecodeImpl_RGB5A3_SSSE3(u32* dst, const u8* src, int width, int height,
                                                TextureFormat texformat, const u8* tlut,
@@ -881,6 +1153,72 @@ static void TexDecoder_DecodeImpl_RGB5A3_SSSE3(u32* dst, const u8* src, int widt
   }
 }
 
+// Decodes eight RGB5A3 texels, each zero-extended to 32 bits. Unlike the SSE versions, both
+// encodings are always computed and the result is selected per texel, so there is no scalar
+// fallback for blocks that mix RGB555 and RGBA4443 texels.
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodeRGB5A3x8_AVX2(__m256i valV)
+{
+  const __m256i kMask_x1f = _mm256_set1_epi32(0x0000001fL);
+  const __m256i kMask_x0f = _mm256_set1_epi32(0x0000000fL);
+  const __m256i kMask_x07 = _mm256_set1_epi32(0x00000007L);
+  const __m256i kMask_x8000 = _mm256_set1_epi32(0x00008000L);
+  const __m256i aVxff00 = _mm256_set1_epi32(0xFF000000L);
+
+  // RGB555: Swizzle bits: 00012345 -> 12345123
+  const __m256i tmpr5V = _mm256_and_si256(_mm256_srli_epi16(valV, 10), kMask_x1f);
+  const __m256i r5V = _mm256_or_si256(_mm256_slli_epi16(tmpr5V, 3), _mm256_srli_epi16(tmpr5V, 2));
+  const __m256i tmpg5V = _mm256_and_si256(_mm256_srli_epi16(valV, 5), kMask_x1f);
+  const __m256i g5V = _mm256_or_si256(_mm256_slli_epi16(tmpg5V, 3), _mm256_srli_epi16(tmpg5V, 2));
+  const __m256i tmpb5V = _mm256_and_si256(valV, kMask_x1f);
+  const __m256i b5V = _mm256_or_si256(_mm256_slli_epi16(tmpb5V, 3), _mm256_srli_epi16(tmpb5V, 2));
+  const __m256i rgb555 = _mm256_or_si256(_mm256_or_si256(r5V, _mm256_slli_epi32(g5V, 8)),
+                                         _mm256_or_si256(_mm256_slli_epi32(b5V, 16), aVxff00));
+
+  // RGBA4443: Swizzle bits: 00001234 -> 12341234
+  const __m256i tmpr4V = _mm256_and_si256(_mm256_srli_epi16(valV, 8), kMask_x0f);
+  const __m256i r4V = _mm256_or_si256(_mm256_slli_epi16(tmpr4V, 4), tmpr4V);
+  const __m256i tmpg4V = _mm256_and_si256(_mm256_srli_epi16(valV, 4), kMask_x0f);
+  const __m256i g4V = _mm256_or_si256(_mm256_slli_epi16(tmpg4V, 4), tmpg4V);
+  const __m256i tmpb4V = _mm256_and_si256(valV, kMask_x0f);
+  const __m256i b4V = _mm256_or_si256(_mm256_slli_epi16(tmpb4V, 4), tmpb4V);
+  const __m256i tmpaV = _mm256_and_si256(_mm256_srli_epi16(valV, 12), kMask_x07);
+  const __m256i aV =
+      _mm256_or_si256(_mm256_slli_epi16(tmpaV, 5),
+                      _mm256_or_si256(_mm256_slli_epi16(tmpaV, 2), _mm256_srli_epi16(tmpaV, 1)));
+  const __m256i rgba4443 =
+      _mm256_or_si256(_mm256_or_si256(r4V, _mm256_slli_epi32(g4V, 8)),
+                      _mm256_or_si256(_mm256_slli_epi32(b4V, 16), _mm256_slli_epi32(aV, 24)));
+
+  const __m256i is_rgb555 = _mm256_cmpeq_epi32(_mm256_and_si256(valV, kMask_x8000), kMask_x8000);
+  return _mm256_blendv_epi8(rgba4443, rgb555, is_rgb555);
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB5A3_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Byteswap and zero-extend the 16-bit texels of the low and the high half of each lane, giving
+  // rows (0, 2) and (1, 3) of a 4x4 block.
+  const __m256i mask_lo = _mm256_setr_epi8(1, 0, -128, -128, 3, 2, -128, -128, 5, 4, -128, -128, 7,
+                                           6, -128, -128, 1, 0, -128, -128, 3, 2, -128, -128, 5, 4,
+                                           -128, -128, 7, 6, -128, -128);
+  const __m256i mask_hi = _mm256_setr_epi8(9, 8, -128, -128, 11, 10, -128, -128, 13, 12, -128, -128,
+                                           15, 14, -128, -128, 9, 8, -128, -128, 11, 10, -128, -128,
+                                           13, 12, -128, -128, 15, 14, -128, -128);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      const __m256i r = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      const __m256i rows02 = DecodeRGB5A3x8_AVX2(_mm256_shuffle_epi8(r, mask_lo));
+      const __m256i rows13 = DecodeRGB5A3x8_AVX2(_mm256_shuffle_epi8(r, mask_hi));
+      StoreBlockRows_AVX2(dst + y * width + x, width, rows02, rows13);
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_RGB5A3(u32* dst, const u8* src, int width, int height,
                                          TextureFormat texformat, const u8* tlut,
                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
@@ -1036,6 +1374,31 @@ static void TexDecoder_DecodeImpl_RGBA8_SSSE3(u32* dst, const u8* src, int width
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGBA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  const __m256i mask0312 =
+      _mm256_setr_epi8(2, 1, 3, 0, 6, 5, 7, 4, 10, 9, 11, 8, 14, 13, 15, 12,  //
+                       2, 1, 3, 0, 6, 5, 7, 4, 10, 9, 11, 8, 14, 13, 15, 12);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      // All 16 AR pairs followed by all 16 GB pairs. The low lanes hold texels 0-7 (rows 0 and 1)
+      // and the high lanes texels 8-15 (rows 2 and 3).
+      const u8* src2 = src + 64 * yStep;
+      const __m256i ar = _mm256_loadu_si256((const __m256i*)src2);
+      const __m256i gb = _mm256_loadu_si256((const __m256i*)src2 + 1);
+
+      const __m256i rows02 = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(ar, gb), mask0312);
+      const __m256i rows13 = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(ar, gb), mask0312);
+      StoreBlockRows_AVX2(dst + y * width + x, width, rows02, rows13);
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_RGBA8(u32* dst, const u8* src, int width, int height,
                                         TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                         int Wsteps4, int Wsteps8)
@@ -1157,6 +1520,161 @@ static void TexDecoder_DecodeImpl_RGBA8(u32* dst, const u8* src, int width, int
   }
 }
 
+// Computes the four colors of each of two consecutive DXT blocks in `dxt`. Color i of the first
+// block ends up in 32-bit word i of `colors0`, likewise for the second block and `colors1`.
+static DOLPHIN_FORCE_INLINE void DecodeCMPRColors(const __m128i dxt, __m128i* colors0,
+                                                  __m128i* colors1)
+{
+  // JSD NOTE: You may see many strange patterns of behavior in the below code, but they
+  // are for performance reasons. Sometimes, calculating what should be obvious hard-coded
+  // constants is faster than loading their values from memory. Unfortunately, there is no
+  // way to inline 128-bit constants from opcodes so they must be loaded from memory. This
+  // seems a little ridiculous to me in that you can't even generate a constant value of 1
+  // without having to load it from memory. So, I stored the minimal constant I could,
+  // 128-bits worth of 1s :). Then I use sequences of shifts to squash it to the appropriate
+  // size and bitpositions that I need.
+  const __m128i allFFs128 = _mm_cmpeq_epi32(_mm_setzero_si128(), _mm_setzero_si128());
+
+  __m128i argb888x4;
+  __m128i c1 = _mm_unpackhi_epi16(dxt, dxt);
+  c1 = _mm_slli_si128(c1, 8);
+  const __m128i c0 =
+      _mm_or_si128(c1, _mm_srli_si128(_mm_slli_si128(_mm_unpacklo_epi16(dxt, dxt), 8), 8));
+
+  // Compare rgb0 to rgb1:
+  // Each 32-bit word will contain either 0xFFFFFFFF or 0x00000000 for true/false.
+  const __m128i c0cmp = _mm_srli_epi32(_mm_slli_epi32(_mm_srli_epi64(c0, 8), 16), 16);
+  const __m128i c0shr = _mm_srli_epi64(c0cmp, 32);
+  const __m128i cmprgb0rgb1 = _mm_cmpgt_epi32(c0cmp, c0shr);
+
+  int cmp0 = _mm_extract_epi16(cmprgb0rgb1, 0);
+  int cmp1 = _mm_extract_epi16(cmprgb0rgb1, 4);
+
+  // green:
+  // NOTE: We start with the larger number of bits (6) firts for G and shift the mask down
+  // 1 bit to get a 5-bit mask later for R and B components.
+  // low6mask == _mm_set_epi32(0x0000FC00, 0x0000FC00, 0x0000FC00, 0x0000FC00)
+  const __m128i low6mask = _mm_slli_epi32(_mm_srli_epi32(allFFs128, 24 + 2), 8 + 2);
+  const __m128i gtmp = _mm_srli_epi32(c0, 3);
+  const __m128i g0 = _mm_and_si128(gtmp, low6mask);
+  // low3mask == _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300)
+  const __m128i g1 = _mm_and_si128(
+      _mm_srli_epi32(gtmp, 6), _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300));
+  argb888x4 = _mm_or_si128(g0, g1);
+  // red:
+  // low5mask == _mm_set_epi32(0x000000F8, 0x000000F8, 0x000000F8, 0x000000F8)
+  const __m128i low5mask = _mm_slli_epi32(_mm_srli_epi32(low6mask, 8 + 3), 3);
+  const __m128i r0 = _mm_and_si128(c0, low5mask);
+  const __m128i r1 = _mm_srli_epi32(r0, 5);
+  argb888x4 = _mm_or_si128(argb888x4, _mm_or_si128(r0, r1));
+  // blue:
+  // _mm_slli_epi32(low5mask, 16) == _mm_set_epi32(0x00F80000, 0x00F80000, 0x00F80000,
+  // 0x00F80000)
+  const __m128i b0 = _mm_and_si128(_mm_srli_epi32(c0, 5), _mm_slli_epi32(low5mask, 16));
+  const __m128i b1 = _mm_srli_epi16(b0, 5);
+  // OR in the fixed alpha component
+  // _mm_slli_epi32( allFFs128, 24 ) == _mm_set_epi32(0xFF000000, 0xFF000000, 0xFF000000,
+  // 0xFF000000)
+  argb888x4 = _mm_or_si128(_mm_or_si128(argb888x4, _mm_slli_epi32(allFFs128, 24)),
+                           _mm_or_si128(b0, b1));
+  // calculate RGB2 and RGB3:
+  const __m128i rgb0 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(2, 2, 0, 0));
+  const __m128i rgb1 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(3, 3, 1, 1));
+  const __m128i rrggbb0 =
+      _mm_and_si128(_mm_unpacklo_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
+  const __m128i rrggbb1 =
+      _mm_and_si128(_mm_unpacklo_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
+  const __m128i rrggbb01 =
+      _mm_and_si128(_mm_unpackhi_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
+  const __m128i rrggbb11 =
+      _mm_and_si128(_mm_unpackhi_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
+
+  __m128i rgb2, rgb3;
+
+  // if (rgb0 > rgb1):
+  if (cmp0 != 0)
+  {
+    // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
+    // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
+    const __m128i rrggbbsum = _mm_add_epi16(rrggbb0, rrggbb1);
+
+    const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb0, 1);
+    const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb0, 2);
+
+    const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb1, 1);
+    const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb1, 2);
+
+    const __m128i rrggbb2 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
+    const __m128i rrggbb3 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
+
+    const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
+    const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
+
+    rgb2 = _mm_and_si128(rgb2dup, _mm_srli_si128(allFFs128, 8));
+    rgb3 = _mm_and_si128(rgb3dup, _mm_srli_si128(allFFs128, 8));
+  }
+  else
+  {
+    // RGB2b = avg(RGB0, RGB1)
+    const __m128i rrggbb21 = _mm_srai_epi16(_mm_add_epi16(rrggbb0, rrggbb1), 1);
+    const __m128i rgb210 = _mm_srli_si128(_mm_packus_epi16(rrggbb21, rrggbb21), 8);
+    rgb2 = rgb210;
+    rgb3 = _mm_and_si128(rgb210, _mm_srli_epi32(allFFs128, 8));
+  }
+
+  // if (rgb0 > rgb1):
+  if (cmp1 != 0)
+  {
+    // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
+    // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
+    const __m128i rrggbbsum = _mm_add_epi16(rrggbb01, rrggbb11);
+
+    const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb01, 1);
+    const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb01, 2);
+
+    const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb11, 1);
+    const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb11, 2);
+
+    const __m128i rrggbb2 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
+    const __m128i rrggbb3 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
+
+    const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
+    const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
+
+    rgb2 = _mm_or_si128(rgb2, _mm_and_si128(rgb2dup, _mm_slli_si128(allFFs128, 8)));
+    rgb3 = _mm_or_si128(rgb3, _mm_and_si128(rgb3dup, _mm_slli_si128(allFFs128, 8)));
+  }
+  else
+  {
+    // RGB2b = avg(RGB0, RGB1)
+    const __m128i rrggbb211 = _mm_srai_epi16(_mm_add_epi16(rrggbb01, rrggbb11), 1);
+    const __m128i rgb211 = _mm_slli_si128(_mm_packus_epi16(rrggbb211, rrggbb211), 8);
+    rgb2 = _mm_or_si128(rgb2, rgb211);
+
+    // _mm_srli_epi32( allFFs128, 8 ) == _mm_set_epi32(0x00FFFFFF, 0x00FFFFFF, 0x00FFFFFF,
+    // 0x00FFFFFF)
+    // Make this color fully transparent:
+    rgb3 = _mm_or_si128(rgb3, _mm_and_si128(_mm_and_si128(rgb2, _mm_srli_epi32(allFFs128, 8)),
+                                            _mm_slli_si128(allFFs128, 8)));
+  }
+
+  // Create an array for color lookups for DXT0 so we can use the 2-bit indices:
+  *colors0 = _mm_or_si128(
+      _mm_or_si128(_mm_srli_si128(_mm_slli_si128(argb888x4, 8), 8),
+                   _mm_slli_si128(_mm_srli_si128(_mm_slli_si128(rgb2, 8), 8 + 4), 8)),
+      _mm_slli_si128(_mm_srli_si128(rgb3, 4), 8 + 4));
+
+  // Create an array for color lookups for DXT1 so we can use the 2-bit indices:
+  *colors1 =
+      _mm_or_si128(_mm_or_si128(_mm_srli_si128(argb888x4, 8),
+                                _mm_slli_si128(_mm_srli_si128(rgb2, 8 + 4), 8)),
+                   _mm_slli_si128(_mm_srli_si128(rgb3, 8 + 4), 8 + 4));
+}
+
 static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int height,
                                        TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                        int Wsteps4, int Wsteps8)
@@ -1176,16 +1694,6 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
       // parallelizable at this level, so we do.
       for (int z = 0, xStep = 2 * yStep; z < 2; ++z, xStep++)
       {
-        // JSD NOTE: You may see many strange patterns of behavior in the below code, but they
-        // are for performance reasons. Sometimes, calculating what should be obvious hard-coded
-        // constants is faster than loading their values from memory. Unfortunately, there is no
-        // way to inline 128-bit constants from opcodes so they must be loaded from memory. This
-        // seems a little ridiculous to me in that you can't even generate a constant value of 1
-        // without having to load it from memory. So, I stored the minimal constant I could,
-        // 128-bits worth of 1s :). Then I use sequences of shifts to squash it to the appropriate
-        // size and bitpositions that I need.
-        const __m128i allFFs128 = _mm_cmpeq_epi32(_mm_setzero_si128(), _mm_setzero_si128());
-
         // Load 128 bits, i.e. two DXTBlocks (64-bits each)
         const __m128i dxt = _mm_loadu_si128((__m128i*)(src + sizeof(struct DXTBlock) * 2 * xStep));
 
@@ -1196,144 +1704,8 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
         u32 dxt0sel = dxttmp[1];
         u32 dxt1sel = dxttmp[3];
 
-        __m128i argb888x4;
-        __m128i c1 = _mm_unpackhi_epi16(dxt, dxt);
-        c1 = _mm_slli_si128(c1, 8);
-        const __m128i c0 =
-            _mm_or_si128(c1, _mm_srli_si128(_mm_slli_si128(_mm_unpacklo_epi16(dxt, dxt), 8), 8));
-
-        // Compare rgb0 to rgb1:
-        // Each 32-bit word will contain either 0xFFFFFFFF or 0x00000000 for true/false.
-        const __m128i c0cmp = _mm_srli_epi32(_mm_slli_epi32(_mm_srli_epi64(c0, 8), 16), 16);
-        const __m128i c0shr = _mm_srli_epi64(c0cmp, 32);
-        const __m128i cmprgb0rgb1 = _mm_cmpgt_epi32(c0cmp, c0shr);
-
-        int cmp0 = _mm_extract_epi16(cmprgb0rgb1, 0);
-        int cmp1 = _mm_extract_epi16(cmprgb0rgb1, 4);
-
-        // green:
-        // NOTE: We start with the larger number of bits (6) firts for G and shift the mask down
-        // 1 bit to get a 5-bit mask later for R and B components.
-        // low6mask == _mm_set_epi32(0x0000FC00, 0x0000FC00, 0x0000FC00, 0x0000FC00)
-        const __m128i low6mask = _mm_slli_epi32(_mm_srli_epi32(allFFs128, 24 + 2), 8 + 2);
-        const __m128i gtmp = _mm_srli_epi32(c0, 3);
-        const __m128i g0 = _mm_and_si128(gtmp, low6mask);
-        // low3mask == _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300)
-        const __m128i g1 = _mm_and_si128(
-            _mm_srli_epi32(gtmp, 6), _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300));
-        argb888x4 = _mm_or_si128(g0, g1);
-        // red:
-        // low5mask == _mm_set_epi32(0x000000F8, 0x000000F8, 0x000000F8, 0x000000F8)
-        const __m128i low5mask = _mm_slli_epi32(_mm_srli_epi32(low6mask, 8 + 3), 3);
-        const __m128i r0 = _mm_and_si128(c0, low5mask);
-        const __m128i r1 = _mm_srli_epi32(r0, 5);
-        argb888x4 = _mm_or_si128(argb888x4, _mm_or_si128(r0, r1));
-        // blue:
-        // _mm_slli_epi32(low5mask, 16) == _mm_set_epi32(0x00F80000, 0x00F80000, 0x00F80000,
-        // 0x00F80000)
-        const __m128i b0 = _mm_and_si128(_mm_srli_epi32(c0, 5), _mm_slli_epi32(low5mask, 16));
-        const __m128i b1 = _mm_srli_epi16(b0, 5);
-        // OR in the fixed alpha component
-        // _mm_slli_epi32( allFFs128, 24 ) == _mm_set_epi32(0xFF000000, 0xFF000000, 0xFF000000,
-        // 0xFF000000)
-        argb888x4 = _mm_or_si128(_mm_or_si128(argb888x4, _mm_slli_epi32(allFFs128, 24)),
-                                 _mm_or_si128(b0, b1));
-        // calculate RGB2 and RGB3:
-        const __m128i rgb0 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(2, 2, 0, 0));
-        const __m128i rgb1 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(3, 3, 1, 1));
-        const __m128i rrggbb0 =
-            _mm_and_si128(_mm_unpacklo_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
-        const __m128i rrggbb1 =
-            _mm_and_si128(_mm_unpacklo_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
-        const __m128i rrggbb01 =
-            _mm_and_si128(_mm_unpackhi_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
-        const __m128i rrggbb11 =
-            _mm_and_si128(_mm_unpackhi_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
-
-        __m128i rgb2, rgb3;
-
-        // if (rgb0 > rgb1):
-        if (cmp0 != 0)
-        {
-          // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
-          // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
-          const __m128i rrggbbsum = _mm_add_epi16(rrggbb0, rrggbb1);
-
-          const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb0, 1);
-          const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb0, 2);
-
-          const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb1, 1);
-          const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb1, 2);
-
-          const __m128i rrggbb2 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
-          const __m128i rrggbb3 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
-
-          const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
-          const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
-
-          rgb2 = _mm_and_si128(rgb2dup, _mm_srli_si128(allFFs128, 8));
-          rgb3 = _mm_and_si128(rgb3dup, _mm_srli_si128(allFFs128, 8));
-        }
-        else
-        {
-          // RGB2b = avg(RGB0, RGB1)
-          const __m128i rrggbb21 = _mm_srai_epi16(_mm_add_epi16(rrggbb0, rrggbb1), 1);
-          const __m128i rgb210 = _mm_srli_si128(_mm_packus_epi16(rrggbb21, rrggbb21), 8);
-          rgb2 = rgb210;
-          rgb3 = _mm_and_si128(rgb210, _mm_srli_epi32(allFFs128, 8));
-        }
-
-        // if (rgb0 > rgb1):
-        if (cmp1 != 0)
-        {
-          // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
-          // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
-          const __m128i rrggbbsum = _mm_add_epi16(rrggbb01, rrggbb11);
-
-          const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb01, 1);
-          const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb01, 2);
-
-          const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb11, 1);
-          const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb11, 2);
-
-          const __m128i rrggbb2 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
-          const __m128i rrggbb3 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
-
-          const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
-          const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
-
-          rgb2 = _mm_or_si128(rgb2, _mm_and_si128(rgb2dup, _mm_slli_si128(allFFs128, 8)));
-          rgb3 = _mm_or_si128(rgb3, _mm_and_si128(rgb3dup, _mm_slli_si128(allFFs128, 8)));
-        }
-        else
-        {
-          // RGB2b = avg(RGB0, RGB1)
-          const __m128i rrggbb211 = _mm_srai_epi16(_mm_add_epi16(rrggbb01, rrggbb11), 1);
-          const __m128i rgb211 = _mm_slli_si128(_mm_packus_epi16(rrggbb211, rrggbb211), 8);
-          rgb2 = _mm_or_si128(rgb2, rgb211);
-
-          // _mm_srli_epi32( allFFs128, 8 ) == _mm_set_epi32(0x00FFFFFF, 0x00FFFFFF, 0x00FFFFFF,
-          // 0x00FFFFFF)
-          // Make this color fully transparent:
-          rgb3 = _mm_or_si128(rgb3, _mm_and_si128(_mm_and_si128(rgb2, _mm_srli_epi32(allFFs128, 8)),
-                                                  _mm_slli_si128(allFFs128, 8)));
-        }
-
-        // Create an array for color lookups for DXT0 so we can use the 2-bit indices:
-        const __m128i mmcolors0 = _mm_or_si128(
-            _mm_or_si128(_mm_srli_si128(_mm_slli_si128(argb888x4, 8), 8),
-                         _mm_slli_si128(_mm_srli_si128(_mm_slli_si128(rgb2, 8), 8 + 4), 8)),
-            _mm_slli_si128(_mm_srli_si128(rgb3, 4), 8 + 4));
-
-        // Create an array for color lookups for DXT1 so we can use the 2-bit indices:
-        const __m128i mmcolors1 =
-            _mm_or_si128(_mm_or_si128(_mm_srli_si128(argb888x4, 8),
-                                      _mm_slli_si128(_mm_srli_si128(rgb2, 8 + 4), 8)),
-                         _mm_slli_si128(_mm_srli_si128(rgb3, 8 + 4), 8 + 4));
+        __m128i mmcolors0, mmcolors1;
+        DecodeCMPRColors(dxt, &mmcolors0, &mmcolors1);
 
 // The #ifdef CHECKs here and below are to compare correctness of output against the reference code.
 // Don't use them in a normal build.
@@ -1413,6 +1785,51 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_CMPR_AVX2(u32* dst, const u8* src, int width, int height,
+                                            TextureFormat texformat, const u8* tlut,
+                                            TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // The colors are computed exactly like in the SSE2 version, but instead of looking up each texel
+  // individually, the eight colors of two horizontally adjacent blocks are kept in one register and
+  // a whole 8-texel row is selected with a single cross-lane permute.
+  const __m256i kMask_x3 = _mm256_set1_epi32(3);
+  const __m256i block_offset = _mm256_setr_epi32(0, 0, 0, 0, 4, 4, 4, 4);
+  const __m256i selector_words = _mm256_setr_epi32(1, 1, 1, 1, 3, 3, 3, 3);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int z = 0, xStep = 2 * yStep; z < 2; ++z, xStep++)
+      {
+        const __m128i dxt = _mm_loadu_si128((__m128i*)(src + sizeof(struct DXTBlock) * 2 * xStep));
+
+        __m128i colors0, colors1;
+        DecodeCMPRColors(dxt, &colors0, &colors1);
+        const __m256i colors =
+            _mm256_inserti128_si256(_mm256_castsi128_si256(colors0), colors1, 1);
+
+        // The 2-bit indices of the first block in words 0-3, those of the second block in 4-7.
+        const __m256i selectors =
+            _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(dxt), selector_words);
+
+        u32* dst32 = dst + (y + z * 4) * width + x;
+        for (int row = 0; row < 4; row++)
+        {
+          const int shift = row * 8;
+          const __m256i shifts =
+              _mm256_setr_epi32(shift + 6, shift + 4, shift + 2, shift + 0,  //
+                                shift + 6, shift + 4, shift + 2, shift + 0);
+          const __m256i indices = _mm256_or_si256(
+              _mm256_and_si256(_mm256_srlv_epi32(selectors, shifts), kMask_x3), block_offset);
+          _mm256_storeu_si256((__m256i*)(dst32 + width * row),
+                              _mm256_permutevar8x32_epi32(colors, indices));
+        }
+      }
+    }
+  }
+}
+
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
                             const u8* tlut, TLUTFormat tlutfmt)
 {
@@ -1422,11 +1839,18 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   switch (texformat)
   {
   case TextureFormat::C4:
-    TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::I4:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I4_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1434,7 +1858,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::I8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1442,7 +1869,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C8:
-    TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    // Decoding the full 256-entry palette up front only pays off for textures with more texels.
+    if (cpu_info.bAVX2 && width * height > 256)
+      TexDecoder_DecodeImpl_C8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::IA4:
@@ -1450,7 +1882,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::IA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_IA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                       Wsteps8);
     else
@@ -1464,12 +1899,19 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGB565:
-    TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                 Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB565_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else
+      TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                   Wsteps8);
     break;
 
   case TextureFormat::RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB5A3_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1478,7 +1920,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGBA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGBA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGBA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                         Wsteps8);
     else
@@ -1487,7 +1932,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::CMPR:
-    TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_CMPR_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                      Wsteps8);
+    else
+      TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                 Wsteps8);
     break;
 
   case TextureFormat::XFB:
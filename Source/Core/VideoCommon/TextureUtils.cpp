@@ -3,19 +3,31 @@
 
 #include "VideoCommon/TextureUtils.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
+#include "Common/Image.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 
+#include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/AbstractTexture.h"
 
 namespace
 {
+// Readbacks are flushed early past this, to bound the memory used by staging textures.
+constexpr std::size_t MAX_PENDING_READBACKS = 64;
+// The GPU thread waits for the workers when more than this much image data is waiting to be
+// encoded.
+constexpr std::size_t MAX_QUEUED_BYTES = 256 * 1024 * 1024;
+
 std::string BuildDumpTextureFilename(std::string basename, u32 level, bool is_arbitrary)
 {
   if (is_arbitrary)
@@ -53,8 +65,9 @@ void TextureDumper::DumpTexture(const ::AbstractTexture& texture, std::string ba
   const std::string dump_dir =
       File::GetUserPath(D_DUMPTEXTURES_IDX) + SConfig::GetInstance().GetGameID();
 
-  if (m_dumped_textures.empty())
+  if (!m_searched_dump_dir)
   {
+    m_searched_dump_dir = true;
     if (!File::IsDirectory(dump_dir))
       File::CreateDir(dump_dir);
 
@@ -70,11 +83,119 @@ void TextureDumper::DumpTexture(const ::AbstractTexture& texture, std::string ba
   }
 
   const std::string name = BuildDumpTextureFilename(std::move(basename), level, is_arbitrary);
-  const bool file_existed = !m_dumped_textures.insert(name).second;
-  if (file_existed)
+  if (m_dumped_textures.contains(name))
+    return;
+
+  // Compressed and float textures can't be copied to RGBA8.
+  if (AbstractTexture::IsCompressedFormat(texture.GetFormat()) ||
+      texture.GetFormat() == AbstractTextureFormat::RGBA16F || level >= texture.GetLevels())
+  {
     return;
+  }
+
+  const TextureConfig readback_config(std::max(1u, texture.GetWidth() >> level),
+                                      std::max(1u, texture.GetHeight() >> level), 1, 1, 1,
+                                      AbstractTextureFormat::RGBA8, 0,
+                                      AbstractTextureType::Texture_2DArray);
+  auto readback_texture =
+      g_gfx->CreateStagingTexture(StagingTextureType::Readback, readback_config);
+  if (!readback_texture)
+    return;
+
+  readback_texture->CopyFromTexture(&texture, 0, level);
+  m_pending_readbacks.push_back(
+      {std::move(readback_texture), fmt::format("{}/{}.png", dump_dir, name)});
+  // Only marked as dumped once queued, so that a texture which couldn't be read back is tried
+  // again the next time it is loaded.
+  m_dumped_textures.insert(name);
+  if (m_pending_readbacks.size() >= MAX_PENDING_READBACKS)
+    Flush();
+}
+
+TextureDumper::TextureDumper() = default;
 
-  texture.Save(fmt::format("{}/{}.png", dump_dir, name), level,
-               Config::Get(Config::GFX_TEXTURE_PNG_COMPRESSION_LEVEL));
+TextureDumper::~TextureDumper()
+{
+  Shutdown();
+}
+
+void TextureDumper::Flush()
+{
+  if (m_pending_readbacks.empty())
+    return;
+
+  if (m_workers.empty())
+    StartWorkers();
+
+  const int compression_level = Config::Get(Config::GFX_TEXTURE_PNG_COMPRESSION_LEVEL);
+  for (PendingReadback& readback : m_pending_readbacks)
+  {
+    const u32 width = readback.texture->GetWidth();
+    const u32 height = readback.texture->GetHeight();
+    EncodeJob job{std::move(readback.filename), std::vector<u8>(size_t(width) * height * 4), width,
+                  height, compression_level};
+    // The first readback waits for the GPU, after which the others are already complete.
+    readback.texture->ReadTexels(readback.texture->GetRect(), job.data.data(), width * 4);
+
+    std::unique_lock lk(m_mutex);
+    m_job_finished.wait(lk, [&] { return m_queued_bytes < MAX_QUEUED_BYTES; });
+    m_queued_bytes += job.data.size();
+    m_jobs.push_back(std::move(job));
+    m_job_queued.notify_one();
+  }
+  m_pending_readbacks.clear();
+}
+
+void TextureDumper::Shutdown()
+{
+  Flush();
+  if (m_workers.empty())
+    return;
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_exit_workers = true;
+  }
+  m_job_queued.notify_all();
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+  m_exit_workers = false;
+}
+
+void TextureDumper::StartWorkers()
+{
+  // Leave some threads for the emulation itself.
+  const u32 num_workers = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+  for (u32 i = 0; i < num_workers; i++)
+    m_workers.emplace_back(&TextureDumper::WorkerThread, this);
+}
+
+void TextureDumper::WorkerThread()
+{
+  Common::SetCurrentThreadName("Texture dumping");
+
+  std::unique_lock lk(m_mutex);
+  while (true)
+  {
+    // Finish the queued jobs before exiting, so that no dumped texture is lost.
+    m_job_queued.wait(lk, [this] { return !m_jobs.empty() || m_exit_workers; });
+    if (m_jobs.empty())
+      return;
+
+    EncodeJob job = std::move(m_jobs.front());
+    m_jobs.pop_front();
+    lk.unlock();
+
+    if (!Common::SavePNG(job.filename, job.data.data(), Common::ImageByteFormat::RGBA, job.width,
+                         job.height, job.width * 4, job.compression_level))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to dump texture to {}", job.filename);
+    }
+
+    lk.lock();
+    m_queued_bytes -= job.data.size();
+    m_job_finished.notify_all();
+  }
 }
 }  // namespace VideoCommon::TextureUtils
@@ -3,24 +3,78 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 
+class AbstractStagingTexture;
 class AbstractTexture;
 
 namespace VideoCommon::TextureUtils
 {
+// Dumps textures without stalling the GPU thread. Textures are copied to staging textures when
+// they are dumped, and read back together at the end of the frame. The PNG files are encoded and
+// written by a pool of worker threads.
 class TextureDumper
 {
 public:
+  TextureDumper();
+  ~TextureDumper();
+
+  TextureDumper(const TextureDumper&) = delete;
+  TextureDumper& operator=(const TextureDumper&) = delete;
+
   // Only dumps if texture did not already exist anywhere within the dump-textures path.
   void DumpTexture(const ::AbstractTexture& texture, std::string basename, u32 level,
                    bool is_arbitrary);
 
+  // Reads back the textures dumped since the last call and queues them for encoding. Waits if the
+  // workers have fallen too far behind.
+  void Flush();
+
+  // Finishes writing every dumped texture, and stops the workers.
+  void Shutdown();
+
 private:
+  struct PendingReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    std::string filename;
+  };
+
+  struct EncodeJob
+  {
+    std::string filename;
+    std::vector<u8> data;
+    u32 width;
+    u32 height;
+    int compression_level;
+  };
+
+  void StartWorkers();
+  void WorkerThread();
+
   std::unordered_set<std::string> m_dumped_textures;
+  bool m_searched_dump_dir = false;
+  std::vector<PendingReadback> m_pending_readbacks;
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  // Signalled when jobs are queued, or when the workers should exit.
+  std::condition_variable m_job_queued;
+  // Signalled when jobs are finished.
+  std::condition_variable m_job_finished;
+  std::deque<EncodeJob> m_jobs;
+  std::size_t m_queued_bytes = 0;
+  bool m_exit_workers = false;
 };
 
 void DumpTexture(const ::AbstractTexture& texture, std::string basename, u32 level,
@@ -33,6 +33,10 @@ static const X64Reg base_reg = RBX;
 
 static const u8* memory_base_ptr = (u8*)&g_main_cp_state.array_strides;
 
+// Vertices are only converted in pairs while neither of them is one of the last three, which update
+// the zfreeze caches.
+static constexpr u8 PAIR_LOOP_MIN_REMAINING = 4;
+
 static OpArg MPIC(const void* ptr, X64Reg scale_reg, int scale = SCALE_1)
 {
   return MComplex(base_reg, scale_reg, scale, PtrOffset(ptr, memory_base_ptr));
@@ -46,7 +50,8 @@ static OpArg MPIC(const void* ptr)
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att)
 {
-  AllocCodeSpace(4096);
+  // The AVX2 pair loop roughly doubles the size of the code.
+  AllocCodeSpace(cpu_info.bAVX2 ? 12288 : 4096);
   ClearCodeSpace();
   GenerateVertexLoader();
   WriteProtect(true);
@@ -55,9 +60,19 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
                                 vtx_desc, vtx_att);
 }
 
+OpArg VertexLoaderX64::SrcAddr(u32 offset) const
+{
+  return MDisp(src_reg, offset + m_lane * m_vertex_size);
+}
+
+OpArg VertexLoaderX64::DstAddr(u32 offset) const
+{
+  return MDisp(dst_reg, offset + m_lane * m_native_vtx_decl.stride);
+}
+
 OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attribute)
 {
-  OpArg data = MDisp(src_reg, m_src_ofs);
+  OpArg data = SrcAddr(m_src_ofs);
   if (IsIndexed(attribute))
   {
     int bits = attribute == VertexComponentFormat::Index8 ? 8 : 16;
@@ -66,7 +81,11 @@ OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attrib
     if (array == CPArray::Position)
     {
       CMP(bits, R(scratch1), Imm8(-1));
-      m_skip_vertex = J_CC(CC_E, Jump::Near);
+      // A pair containing a skipped vertex is left to the single vertex loop.
+      if (m_num_lanes > 1)
+        m_split_pair.push_back(J_CC(CC_E, Jump::Near));
+      else
+        m_skip_vertex = J_CC(CC_E, Jump::Near);
     }
     IMUL(32, scratch1, MPIC(&g_main_cp_state.array_strides[array]));
     MOV(64, R(scratch2), MPIC(&VertexLoaderManager::cached_arraybases[array]));
@@ -124,6 +143,29 @@ void VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute,
       _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
   };
 
+  // The AVX2 path converts the components of two vertices at once, one in each 128-bit lane, so it
+  // needs the constants twice.
+  struct alignas(32) LanePair
+  {
+    __m128i lanes[2];
+  };
+  static const auto paired_shuffle_lut = [] {
+    std::array<std::array<LanePair, 3>, shuffle_lut.size()> lut;
+    for (size_t i = 0; i < lut.size(); i++)
+    {
+      for (size_t j = 0; j < lut[i].size(); j++)
+        lut[i][j] = {shuffle_lut[static_cast<ComponentFormat>(i)][j],
+                     shuffle_lut[static_cast<ComponentFormat>(i)][j]};
+    }
+    return lut;
+  }();
+  static const auto paired_scale_factors = [] {
+    std::array<LanePair, std::size(scale_factors)> factors;
+    for (size_t i = 0; i < factors.size(); i++)
+      factors[i] = {_mm_castps_si128(scale_factors[i]), _mm_castps_si128(scale_factors[i])};
+    return factors;
+  }();
+
   X64Reg coords = XMM0;
 
   const auto write_zfreeze = [&]() {  // zfreeze
@@ -170,6 +212,52 @@ void VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute,
   if (attribute == VertexComponentFormat::Direct)
     m_src_ofs += load_bytes;
 
+  if (m_num_lanes > 1)
+  {
+    // Only VEX encoded instructions may be used here, as the upper halves of the YMM registers are
+    // dirty. The first vertex is loaded into the lower lane of YMM0, and the second one is
+    // broadcast and blended into the upper lane, which avoids the shuffle port.
+    if (m_lane == 0)
+    {
+      if (load_bytes > 8)
+        VMOVDQU(XMM0, data);
+      else if (load_bytes > 4)
+        VMOVQ_xmm(XMM0, data);
+      else
+        VMOVD_xmm(XMM0, data);
+      return;
+    }
+
+    if (load_bytes > 8)
+      VBROADCASTI128(YMM1, data);
+    else if (load_bytes > 4)
+      VPBROADCASTQ_256(YMM1, data);
+    else
+      VPBROADCASTD_256(YMM1, data);
+    VPBLENDD_256(YMM0, YMM0, R(YMM1), 0xF0);
+
+    VPSHUFB_256(YMM0, YMM0, MPIC(&paired_shuffle_lut[static_cast<size_t>(format)][count_in - 1]));
+
+    // Sign-extend.
+    if (format == ComponentFormat::Byte)
+      VPSRAD_256(YMM0, YMM0, 24);
+    if (format == ComponentFormat::Short)
+      VPSRAD_256(YMM0, YMM0, 16);
+
+    if (format < ComponentFormat::Float)
+    {
+      VCVTDQ2PS_256(YMM0, R(YMM0));
+
+      if (dequantize && scaling_exponent)
+        VMULPS_256(YMM0, YMM0, MPIC(&paired_scale_factors[scaling_exponent]));
+    }
+
+    const u32 dst_ofs = m_dst_ofs - sizeof(float) * count_out;
+    StoreFirstVertex(dst_ofs, XMM0, count_out);
+    VEXTRACTI128(DstAddr(dst_ofs), YMM0, 1);
+    return;
+  }
+
   if (cpu_info.bSSSE3)
   {
     if (load_bytes > 8)
@@ -302,7 +390,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     MOV(32, R(scratch1), data);
     if (format != ColorFormat::RGBA8888)
       OR(32, R(scratch1), Imm32(0xFF000000));
-    MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
+    MOV(32, DstAddr(m_dst_ofs), R(scratch1));
     load_bytes = format == ColorFormat::RGB888 ? 3 : 4;
     break;
 
@@ -342,7 +430,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
       OR(32, R(scratch1), R(scratch2));
     }
     OR(32, R(scratch1), Imm32(0x000000FF));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, DstAddr(m_dst_ofs), scratch1);
     load_bytes = 2;
     break;
 
@@ -370,7 +458,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     MOV(32, R(scratch2), R(scratch1));
     SHL(32, R(scratch1), Imm8(4));
     OR(32, R(scratch1), R(scratch2));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, DstAddr(m_dst_ofs), scratch1);
     load_bytes = 2;
     break;
 
@@ -402,7 +490,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     SHR(32, R(scratch1), Imm8(6));
     AND(32, R(scratch1), Imm32(0x03030303));
     OR(32, R(scratch1), R(scratch2));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, DstAddr(m_dst_ofs), scratch1);
     load_bytes = 3;
     break;
   }
@@ -410,43 +498,67 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     m_src_ofs += load_bytes;
 }
 
-void VertexLoaderX64::GenerateVertexLoader()
+void VertexLoaderX64::StoreFirstVertex(u32 offset, X64Reg src, int count)
 {
-  BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
-                   scratch3, remaining_reg, skipped_reg, base_reg};
-  regs &= ABI_ALL_CALLEE_SAVED;
-  regs[RBP] = true;  // Give us a stack frame
-  ABI_PushRegistersAndAdjustStack(regs, 0);
-
-  // Backup count since we're going to count it down.
-  PUSH(32, R(ABI_PARAM3));
-
-  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
-  // We also have it end at a value of 0, to simplify indexing for zfreeze;
-  // this requires subtracting 1 at the start.
-  LEA(32, remaining_reg, MDisp(ABI_PARAM3, -1));
-
-  MOV(64, R(base_reg), R(ABI_PARAM4));
-
-  if (IsIndexed(m_VtxDesc.low.Position))
-    XOR(32, R(skipped_reg), R(skipped_reg));
+  // The second vertex of a pair always stores 16 bytes, like the single vertex loop does for three
+  // components: anything past the attribute is written again later, as the pair loop leaves at
+  // least three vertices to the single vertex loop. The first vertex may only do so if that stays
+  // within the vertex, as the start of the second vertex has already been written.
+  if (offset + 16 <= static_cast<u32>(m_native_vtx_decl.stride))
+  {
+    VMOVUPS(MDisp(dst_reg, offset), src);
+    return;
+  }
 
-  // TODO: load constants into registers outside the main loop
+  switch (count)
+  {
+  case 1:
+    VMOVSS(MDisp(dst_reg, offset), src);
+    break;
+  case 2:
+    VMOVLPS(MDisp(dst_reg, offset), src);
+    break;
+  case 3:
+    VMOVLPS(MDisp(dst_reg, offset), src);
+    VEXTRACTPS(MDisp(dst_reg, offset + 2 * sizeof(float)), src, 2);
+    break;
+  }
+}
 
-  const u8* loop_start = GetCodePtr();
+void VertexLoaderX64::GenerateVertex()
+{
+  // Each attribute is generated for every vertex of the pair in turn, starting from the same
+  // source and destination offsets.
+  const auto for_each_lane = [this](const auto& generate) {
+    const u32 src_ofs = m_src_ofs;
+    const u32 dst_ofs = m_dst_ofs;
+    for (m_lane = 0; m_lane < m_num_lanes; m_lane++)
+    {
+      m_src_ofs = src_ofs;
+      m_dst_ofs = dst_ofs;
+      generate();
+    }
+    m_lane = 0;
+  };
 
   if (m_VtxDesc.low.PosMatIdx)
   {
-    MOVZX(32, 8, scratch1, MDisp(src_reg, m_src_ofs));
-    AND(32, R(scratch1), Imm8(0x3F));
-    MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
+    for_each_lane([&] {
+      MOVZX(32, 8, scratch1, SrcAddr(m_src_ofs));
+      AND(32, R(scratch1), Imm8(0x3F));
+      MOV(32, DstAddr(m_dst_ofs), R(scratch1));
 
-    // zfreeze
-    CMP(32, R(remaining_reg), Imm8(3));
-    FixupBranch dont_store = J_CC(CC_AE);
-    MOV(32, MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4),
-        R(scratch1));
-    SetJumpTarget(dont_store);
+      // zfreeze (the last vertices are never converted in pairs)
+      if (m_num_lanes == 1)
+      {
+        CMP(32, R(remaining_reg), Imm8(3));
+        FixupBranch dont_store = J_CC(CC_AE);
+        MOV(32,
+            MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4),
+            R(scratch1));
+        SetJumpTarget(dont_store);
+      }
+    });
 
     m_native_vtx_decl.posmtx.components = 4;
     m_native_vtx_decl.posmtx.enable = true;
@@ -464,10 +576,12 @@ void VertexLoaderX64::GenerateVertexLoader()
       texmatidx_ofs[i] = m_src_ofs++;
   }
 
-  OpArg data = GetVertexAddr(CPArray::Position, m_VtxDesc.low.Position);
   int pos_elements = m_VtxAttr.g0.PosElements == CoordComponentCount::XY ? 2 : 3;
-  ReadVertex(data, m_VtxDesc.low.Position, m_VtxAttr.g0.PosFormat, pos_elements, pos_elements,
-             m_VtxAttr.g0.ByteDequant, m_VtxAttr.g0.PosFrac, &m_native_vtx_decl.position);
+  for_each_lane([&] {
+    OpArg data = GetVertexAddr(CPArray::Position, m_VtxDesc.low.Position);
+    ReadVertex(data, m_VtxDesc.low.Position, m_VtxAttr.g0.PosFormat, pos_elements, pos_elements,
+               m_VtxAttr.g0.ByteDequant, m_VtxAttr.g0.PosFrac, &m_native_vtx_decl.position);
+  });
 
   if (m_VtxDesc.low.Normal != VertexComponentFormat::NotPresent)
   {
@@ -476,9 +590,13 @@ void VertexLoaderX64::GenerateVertexLoader()
     const u8 scaling_exponent = SCALE_MAP[m_VtxAttr.g0.NormalFormat];
 
     // Normal
-    data = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
-    ReadVertex(data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3, true, scaling_exponent,
-               &m_native_vtx_decl.normals[0]);
+    const u32 normal_src_ofs = m_src_ofs;
+    OpArg data;
+    for_each_lane([&] {
+      data = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
+      ReadVertex(data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3, true,
+                 scaling_exponent, &m_native_vtx_decl.normals[0]);
+    });
 
     if (m_VtxAttr.g0.NormalElements == NormalComponentCount::NTB)
     {
@@ -486,30 +604,40 @@ void VertexLoaderX64::GenerateVertexLoader()
       const int elem_size = GetElementSize(m_VtxAttr.g0.NormalFormat);
       const int load_bytes = elem_size * 3;
 
-      // Tangent
       // If in Index3 mode, and indexed components are used, replace the index with a new index.
-      if (index3)
-        data = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
+      // Otherwise, the tangent and binormal come after the normal. With a pair of vertices, the
+      // address of the normal has to be recalculated for each of them.
+      const auto get_normal_addr = [&] {
+        if (index3)
+          return GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
+        if (m_num_lanes == 1)
+          return data;
+
+        const u32 src_ofs = m_src_ofs;
+        m_src_ofs = normal_src_ofs;
+        const OpArg normal_data = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
+        m_src_ofs = src_ofs;
+        return normal_data;
+      };
+
+      // Tangent
       // The tangent comes after the normal; even in index3 mode, this offset is applied.
       // Note that this is different from adding 1 to the index, as the stride for indices may be
       // different from the size of the tangent itself.
-      data.AddMemOffset(load_bytes);
-
-      ReadVertex(data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3, true,
-                 scaling_exponent, &m_native_vtx_decl.normals[1]);
-
-      // Undo the offset above so that data points to the normal instead of the tangent.
-      // This way, we can add 2*elem_size below to always point to the binormal, even if we replace
-      // data with a new index (which would point to the normal).
-      data.AddMemOffset(-load_bytes);
+      for_each_lane([&] {
+        OpArg tangent_data = get_normal_addr();
+        tangent_data.AddMemOffset(load_bytes);
+        ReadVertex(tangent_data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3, true,
+                   scaling_exponent, &m_native_vtx_decl.normals[1]);
+      });
 
       // Binormal
-      if (index3)
-        data = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
-      data.AddMemOffset(load_bytes * 2);
-
-      ReadVertex(data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3, true,
-                 scaling_exponent, &m_native_vtx_decl.normals[2]);
+      for_each_lane([&] {
+        OpArg binormal_data = get_normal_addr();
+        binormal_data.AddMemOffset(load_bytes * 2);
+        ReadVertex(binormal_data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3, true,
+                   scaling_exponent, &m_native_vtx_decl.normals[2]);
+      });
     }
   }
 
@@ -517,8 +645,10 @@ void VertexLoaderX64::GenerateVertexLoader()
   {
     if (m_VtxDesc.low.Color[i] != VertexComponentFormat::NotPresent)
     {
-      data = GetVertexAddr(CPArray::Color0 + i, m_VtxDesc.low.Color[i]);
-      ReadColor(data, m_VtxDesc.low.Color[i], m_VtxAttr.GetColorFormat(i));
+      for_each_lane([&] {
+        OpArg data = GetVertexAddr(CPArray::Color0 + i, m_VtxDesc.low.Color[i]);
+        ReadColor(data, m_VtxDesc.low.Color[i], m_VtxAttr.GetColorFormat(i));
+      });
       m_native_vtx_decl.colors[i].components = 4;
       m_native_vtx_decl.colors[i].enable = true;
       m_native_vtx_decl.colors[i].offset = m_dst_ofs;
@@ -533,11 +663,13 @@ void VertexLoaderX64::GenerateVertexLoader()
     int elements = m_VtxAttr.GetTexElements(i) == TexComponentCount::ST ? 2 : 1;
     if (m_VtxDesc.high.TexCoord[i] != VertexComponentFormat::NotPresent)
     {
-      data = GetVertexAddr(CPArray::TexCoord0 + i, m_VtxDesc.high.TexCoord[i]);
-      u8 scaling_exponent = m_VtxAttr.GetTexFrac(i);
-      ReadVertex(data, m_VtxDesc.high.TexCoord[i], m_VtxAttr.GetTexFormat(i), elements,
-                 m_VtxDesc.low.TexMatIdx[i] ? 2 : elements, m_VtxAttr.g0.ByteDequant,
-                 scaling_exponent, &m_native_vtx_decl.texcoords[i]);
+      for_each_lane([&] {
+        OpArg data = GetVertexAddr(CPArray::TexCoord0 + i, m_VtxDesc.high.TexCoord[i]);
+        u8 scaling_exponent = m_VtxAttr.GetTexFrac(i);
+        ReadVertex(data, m_VtxDesc.high.TexCoord[i], m_VtxAttr.GetTexFormat(i), elements,
+                   m_VtxDesc.low.TexMatIdx[i] ? 2 : elements, m_VtxAttr.g0.ByteDequant,
+                   scaling_exponent, &m_native_vtx_decl.texcoords[i]);
+      });
     }
     if (m_VtxDesc.low.TexMatIdx[i])
     {
@@ -545,24 +677,116 @@ void VertexLoaderX64::GenerateVertexLoader()
       m_native_vtx_decl.texcoords[i].enable = true;
       m_native_vtx_decl.texcoords[i].type = ComponentFormat::Float;
       m_native_vtx_decl.texcoords[i].integer = false;
-      MOVZX(64, 8, scratch1, MDisp(src_reg, texmatidx_ofs[i]));
       if (m_VtxDesc.high.TexCoord[i] != VertexComponentFormat::NotPresent)
       {
-        CVTSI2SS(XMM0, R(scratch1));
-        MOVSS(MDisp(dst_reg, m_dst_ofs), XMM0);
+        for_each_lane([&] {
+          MOVZX(64, 8, scratch1, SrcAddr(texmatidx_ofs[i]));
+          if (m_num_lanes > 1)
+          {
+            VCVTSI2SS(XMM0, XMM0, R(scratch1));
+            VMOVSS(DstAddr(m_dst_ofs), XMM0);
+          }
+          else
+          {
+            CVTSI2SS(XMM0, R(scratch1));
+            MOVSS(DstAddr(m_dst_ofs), XMM0);
+          }
+        });
         m_dst_ofs += sizeof(float);
       }
       else
       {
         m_native_vtx_decl.texcoords[i].offset = m_dst_ofs;
-        PXOR(XMM0, R(XMM0));
-        CVTSI2SS(XMM0, R(scratch1));
-        SHUFPS(XMM0, R(XMM0), 0x45);  // 000X -> 0X00
-        MOVUPS(MDisp(dst_reg, m_dst_ofs), XMM0);
+        for_each_lane([&] {
+          MOVZX(64, 8, scratch1, SrcAddr(texmatidx_ofs[i]));
+          if (m_num_lanes > 1)
+          {
+            VPXOR(XMM0, XMM0, R(XMM0));
+            VCVTSI2SS(XMM0, XMM0, R(scratch1));
+            VSHUFPS(XMM0, XMM0, R(XMM0), 0x45);  // 000X -> 0X00
+            if (m_lane == 0)
+              StoreFirstVertex(m_dst_ofs, XMM0, 3);
+            else
+              VMOVUPS(DstAddr(m_dst_ofs), XMM0);
+          }
+          else
+          {
+            PXOR(XMM0, R(XMM0));
+            CVTSI2SS(XMM0, R(scratch1));
+            SHUFPS(XMM0, R(XMM0), 0x45);  // 000X -> 0X00
+            MOVUPS(DstAddr(m_dst_ofs), XMM0);
+          }
+        });
         m_dst_ofs += sizeof(float) * 3;
       }
     }
   }
+}
+
+void VertexLoaderX64::GenerateVertexPairLoop(const u8* single_vertex)
+{
+  m_num_lanes = 2;
+  m_src_ofs = 0;
+  m_dst_ofs = 0;
+
+  const u8* loop_start = GetCodePtr();
+
+  GenerateVertex();
+
+  ADD(64, R(dst_reg), Imm32(m_dst_ofs * 2));
+  ADD(64, R(src_reg), Imm32(m_src_ofs * 2));
+
+  SUB(32, R(remaining_reg), Imm8(2));
+  CMP(32, R(remaining_reg), Imm8(PAIR_LOOP_MIN_REMAINING));
+  J_CC(CC_AE, loop_start);
+
+  // The remaining vertices, and pairs containing a skipped vertex, go through the single vertex
+  // loop. Clear the upper halves of the YMM registers first, as it uses SSE instructions.
+  for (const FixupBranch& branch : m_split_pair)
+    SetJumpTarget(branch);
+  m_split_pair.clear();
+  VZEROUPPER();
+  JMP(single_vertex, Jump::Near);
+
+  m_num_lanes = 1;
+}
+
+void VertexLoaderX64::GenerateVertexLoader()
+{
+  BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
+                   scratch3, remaining_reg, skipped_reg, base_reg};
+  regs &= ABI_ALL_CALLEE_SAVED;
+  regs[RBP] = true;  // Give us a stack frame
+  ABI_PushRegistersAndAdjustStack(regs, 0);
+
+  // Backup count since we're going to count it down.
+  PUSH(32, R(ABI_PARAM3));
+
+  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
+  // We also have it end at a value of 0, to simplify indexing for zfreeze;
+  // this requires subtracting 1 at the start.
+  LEA(32, remaining_reg, MDisp(ABI_PARAM3, -1));
+
+  MOV(64, R(base_reg), R(ABI_PARAM4));
+
+  if (IsIndexed(m_VtxDesc.low.Position))
+    XOR(32, R(skipped_reg), R(skipped_reg));
+
+  // TODO: load constants into registers outside the main loop
+
+  const u8* loop_start = GetCodePtr();
+
+  const bool use_pairs = cpu_info.bAVX2;
+  FixupBranch to_pair_loop;
+  if (use_pairs)
+  {
+    CMP(32, R(remaining_reg), Imm8(PAIR_LOOP_MIN_REMAINING));
+    to_pair_loop = J_CC(CC_AE, Jump::Near);
+  }
+
+  const u8* single_vertex = GetCodePtr();
+
+  GenerateVertex();
 
   // Prepare for the next vertex.
   ADD(64, R(dst_reg), Imm32(m_dst_ofs));
@@ -597,6 +821,12 @@ void VertexLoaderX64::GenerateVertexLoader()
              m_src_ofs, m_vertex_size, m_VtxDesc.low.Hex, m_VtxDesc.high.Hex, m_VtxAttr.g0.Hex,
              m_VtxAttr.g1.Hex, m_VtxAttr.g2.Hex);
   m_native_vtx_decl.stride = m_dst_ofs;
+
+  if (use_pairs)
+  {
+    SetJumpTarget(to_pair_loop);
+    GenerateVertexPairLoop(single_vertex);
+  }
 }
 
 int VertexLoaderX64::RunVertices(const u8* src, u8* dst, int count)
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -23,11 +25,21 @@ protected:
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
+  // With AVX2, two vertices are converted per loop iteration while enough of them remain.
+  // m_lane is the vertex of the pair that code is currently being generated for.
+  u32 m_num_lanes = 1;
+  u32 m_lane = 0;
   Gen::FixupBranch m_skip_vertex;
+  std::vector<Gen::FixupBranch> m_split_pair;
+  Gen::OpArg SrcAddr(u32 offset) const;
+  Gen::OpArg DstAddr(u32 offset) const;
   Gen::OpArg GetVertexAddr(CPArray array, VertexComponentFormat attribute);
   void ReadVertex(Gen::OpArg data, VertexComponentFormat attribute, ComponentFormat format,
                   int count_in, int count_out, bool dequantize, u8 scaling_exponent,
                   AttributeFormat* native_format);
   void ReadColor(Gen::OpArg data, VertexComponentFormat attribute, ColorFormat format);
+  void StoreFirstVertex(u32 offset, Gen::X64Reg src, int count);
+  void GenerateVertex();
+  void GenerateVertexPairLoop(const u8* single_vertex);
   void GenerateVertexLoader();
 };
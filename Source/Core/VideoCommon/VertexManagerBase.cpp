@@ -13,6 +13,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/SmallVector.h"
+#include "Common/TraceRecorder.h"
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/SystemTimers.h"
@@ -125,6 +126,7 @@ bool VertexManagerBase::Initialize()
   m_index_generator.Init();
   m_custom_shader_cache = std::make_unique<CustomShaderCache>();
   m_cpu_cull.Init();
+  m_cpu_cull.SetNumThreads(g_ActiveConfig.bCPUCull ? g_ActiveConfig.GetCPUCullThreads() : 0);
   return true;
 }
 
@@ -437,6 +439,8 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  TRACE_ZONE("VertexManagerBase::Flush");
+
   m_is_flushed = true;
 
   if (m_draw_counter == 0)
@@ -561,7 +565,7 @@ void VertexManagerBase::Flush()
   CalculateBinormals(VertexLoaderManager::GetCurrentVertexFormat());
   // Calculate ZSlope for zfreeze
   const auto used_textures = UsedTextures();
-  std::vector<std::string> texture_names;
+  Common::SmallVector<u64, 8> texture_keys;
   Common::SmallVector<u32, 8> texture_units;
   std::array<SamplerState, 8> samplers;
   if (!m_cull_all)
@@ -585,10 +589,10 @@ void VertexManagerBase::Flush()
         const auto cache_entry = g_texture_cache->Load(TextureInfo::FromStage(i));
         if (cache_entry)
         {
-          if (std::find(texture_names.begin(), texture_names.end(),
-                        cache_entry->texture_info_name) == texture_names.end())
+          if (std::find(texture_keys.begin(), texture_keys.end(),
+                        cache_entry->texture_info_name_key) == texture_keys.end())
           {
-            texture_names.push_back(cache_entry->texture_info_name);
+            texture_keys.push_back(cache_entry->texture_info_name_key);
             texture_units.push_back(i);
           }
 
@@ -599,7 +603,7 @@ void VertexManagerBase::Flush()
       }
     }
   }
-  vertex_shader_manager.SetConstants(texture_names, xf_state_manager);
+  vertex_shader_manager.SetConstants(texture_keys, xf_state_manager);
   if (!bpmem.genMode.zfreeze)
   {
     // Must be done after VertexShaderManager::SetConstants()
@@ -615,21 +619,17 @@ void VertexManagerBase::Flush()
   {
     CustomPixelShaderContents custom_pixel_shader_contents;
     std::optional<CustomPixelShader> custom_pixel_shader;
-    std::vector<std::string> custom_pixel_texture_names;
     std::span<u8> custom_pixel_shader_uniforms;
     bool skip = false;
-    for (size_t i = 0; i < texture_names.size(); i++)
+    for (const u64 texture_key : texture_keys)
     {
       GraphicsModActionData::DrawStarted draw_started{texture_units, &skip, &custom_pixel_shader,
                                                       &custom_pixel_shader_uniforms};
-      for (const auto& action : g_graphics_mod_manager->GetDrawStartedActions(texture_names[i]))
+      for (const auto& action : g_graphics_mod_manager->GetDrawStartedActions(texture_key))
       {
         action->OnDrawStarted(&draw_started);
         if (custom_pixel_shader)
-        {
           custom_pixel_shader_contents.shaders.push_back(*custom_pixel_shader);
-          custom_pixel_texture_names.push_back(texture_names[i]);
-        }
         custom_pixel_shader = std::nullopt;
       }
     }
@@ -932,6 +932,7 @@ void VertexManagerBase::OnConfigChange()
 {
   // Reload index generator function tables in case VS expand config changed
   m_index_generator.Init();
+  m_cpu_cull.SetNumThreads(g_ActiveConfig.bCPUCull ? g_ActiveConfig.GetCPUCullThreads() : 0);
 }
 
 void VertexManagerBase::OnDraw()
@@ -158,7 +158,7 @@ bool VertexShaderManager::UseVertexDepthRange()
 
 // Syncs the shader constant buffers with xfmem
 // TODO: A cleaner way to control the matrices without making a mess in the parameters field
-void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
+void VertexShaderManager::SetConstants(std::span<const u64> texture_keys,
                                        XFStateManager& xf_state_manager)
 {
   if (constants.missing_color_hex != g_ActiveConfig.iMissingColorValue)
@@ -397,10 +397,10 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures,
       projection_actions.push_back(action);
     }
 
-    for (const auto& texture : textures)
+    for (const u64 texture_key : texture_keys)
     {
       for (const auto& action :
-           g_graphics_mod_manager->GetProjectionTextureActions(xfmem.projection.type, texture))
+           g_graphics_mod_manager->GetProjectionTextureActions(xfmem.projection.type, texture_key))
       {
         projection_actions.push_back(action);
       }
@@ -116,8 +116,10 @@ void VideoConfig::Refresh()
   bDumpTextures = Config::Get(Config::GFX_DUMP_TEXTURES);
   bDumpMipmapTextures = Config::Get(Config::GFX_DUMP_MIP_TEXTURES);
   bDumpBaseTextures = Config::Get(Config::GFX_DUMP_BASE_TEXTURES);
+  bDumpShaderManifest = Config::Get(Config::GFX_DUMP_SHADER_MANIFEST);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
+  iHiresTextureBudgetMB = Config::Get(Config::GFX_HIRES_TEXTURE_BUDGET_MB);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpXFBTarget = Config::Get(Config::GFX_DUMP_XFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
@@ -128,6 +130,8 @@ void VideoConfig::Refresh()
   sDumpEncoder = Config::Get(Config::GFX_DUMP_ENCODER);
   sDumpPath = Config::Get(Config::GFX_DUMP_PATH);
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
+  iFrameDumpReadbackBuffers = Config::Get(Config::GFX_FRAME_DUMP_READBACK_BUFFERS);
+  iFrameDumpConversionThreads = Config::Get(Config::GFX_FRAME_DUMP_CONVERSION_THREADS);
   frame_dumps_resolution_type = Config::Get(Config::GFX_FRAME_DUMPS_RESOLUTION_TYPE);
   bEnableGPUTextureDecoding = Config::Get(Config::GFX_ENABLE_GPU_TEXTURE_DECODING);
   bPreferVSForLinePointExpansion = Config::Get(Config::GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION);
@@ -149,7 +153,10 @@ void VideoConfig::Refresh()
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iTextureDecodingThreads = Config::Get(Config::GFX_TEXTURE_DECODING_THREADS);
+  iTextureCacheBudgetMB = Config::Get(Config::GFX_TEXTURE_CACHE_BUDGET_MB);
   bCPUCull = Config::Get(Config::GFX_CPU_CULL);
+  iCPUCullThreads = Config::Get(Config::GFX_CPU_CULL_THREADS);
 
   texture_filtering_mode = Config::Get(Config::GFX_ENHANCE_FORCE_TEXTURE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -195,6 +202,7 @@ void VideoConfig::Refresh()
   iEFBAccessTileSize = Config::Get(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE);
   iMissingColorValue = Config::Get(Config::GFX_HACK_MISSING_COLOR_VALUE);
   bFastTextureSampling = Config::Get(Config::GFX_HACK_FAST_TEXTURE_SAMPLING);
+  bTrackTextureWrites = Config::Get(Config::GFX_HACK_TRACK_TEXTURE_WRITES);
 #ifdef __APPLE__
   bNoMipmapping = Config::Get(Config::GFX_HACK_NO_MIPMAPPING);
 #endif
@@ -276,6 +284,49 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return 1;
 }
 
+u32 VideoConfig::GetShaderManifestPrecompilerThreads() const
+{
+  if (!backend_info.bSupportsBackgroundCompiling)
+    return 0;
+
+  // The game hasn't started yet, so the only other thread running is the one showing progress.
+  if (iShaderPrecompilerThreads >= 0)
+    return static_cast<u32>(iShaderPrecompilerThreads);
+  else if (!DriverDetails::HasBug(DriverDetails::BUG_BROKEN_MULTITHREADED_SHADER_PRECOMPILATION))
+    return static_cast<u32>(std::max(cpu_info.num_cores - 1, 1));
+  else
+    return 1;
+}
+
+u32 VideoConfig::GetTextureDecodingThreads() const
+{
+  if (iTextureDecodingThreads >= 0)
+    return static_cast<u32>(iTextureDecodingThreads);
+
+  // Automatic number. The CPU and GPU threads are already busy, so only use the cores beyond
+  // those, and stop at a point where memory bandwidth limits the decoders anyway.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 2, 0, 3));
+}
+
+u32 VideoConfig::GetCPUCullThreads() const
+{
+  if (iCPUCullThreads >= 0)
+    return static_cast<u32>(iCPUCullThreads);
+
+  // Only large draws are split, so a couple of threads beyond the CPU and GPU threads is plenty.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 2, 0, 2));
+}
+
+u32 VideoConfig::GetFrameDumpConversionThreads() const
+{
+  if (iFrameDumpConversionThreads >= 0)
+    return static_cast<u32>(std::max(iFrameDumpConversionThreads, 1));
+
+  // Automatic number. The CPU and GPU threads are busy while dumping, so only use the cores beyond
+  // them.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 2, 1, 4));
+}
+
 void CheckForConfigChanges()
 {
   const ShaderHostConfig old_shader_host_config = ShaderHostConfig::GetCurrent();
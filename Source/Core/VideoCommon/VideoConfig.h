@@ -188,8 +188,12 @@ struct VideoConfig final
   bool bDumpTextures = false;
   bool bDumpMipmapTextures = false;
   bool bDumpBaseTextures = false;
+  bool bDumpShaderManifest = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  // Memory custom textures may use before the least recently used ones are unloaded, in MiB.
+  // 0 limits them to the memory available for all custom assets.
+  int iHiresTextureBudgetMB = 0;
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
@@ -205,6 +209,11 @@ struct VideoConfig final
   bool bEnableGPUTextureDecoding = false;
   bool bPreferVSForLinePointExpansion = false;
   int iBitrateKbps = 0;
+  // Frames which can be read back or waiting to be encoded at the same time.
+  int iFrameDumpReadbackBuffers = 0;
+  // Number of threads swscale uses to convert each dumped frame. 0 is treated as 1.
+  // -1 uses an automatic number based on the CPU threads.
+  int iFrameDumpConversionThreads = 0;
   bool bGraphicMods = false;
   std::optional<GraphicsModGroupConfig> graphics_mod_config;
 
@@ -235,6 +244,7 @@ struct VideoConfig final
   int iSaveTargetId = 0;  // TODO: Should be dropped
   u32 iMissingColorValue = 0;
   bool bFastTextureSampling = false;
+  bool bTrackTextureWrites = false;
 #ifdef __APPLE__
   bool bNoMipmapping = false;  // Used by macOS fifoci to work around an M1 bug
 #endif
@@ -275,6 +285,20 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of extra threads used to decode large textures on the CPU.
+  // 0 decodes on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecodingThreads = 0;
+
+  // Number of extra threads used to transform and cull large draws when bCPUCull is set.
+  // 0 culls on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iCPUCullThreads = 0;
+
+  // Memory the texture cache may use for textures before it starts evicting the least recently
+  // used ones, in MiB. 0 means no limit.
+  int iTextureCacheBudgetMB = 0;
+
   // Loading custom drivers on Android
   std::string customDriverLibraryName;
 
@@ -381,6 +405,10 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetShaderManifestPrecompilerThreads() const;
+  u32 GetTextureDecodingThreads() const;
+  u32 GetCPUCullThreads() const;
+  u32 GetFrameDumpConversionThreads() const;
 
   float GetCustomAspectRatio() const { return (float)custom_aspect_width / custom_aspect_height; }
 };
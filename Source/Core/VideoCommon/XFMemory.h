@@ -467,5 +467,8 @@ static_assert(sizeof(XFMemory) == sizeof(u32) * XFMEM_REGISTERS_END);
 extern XFMemory xfmem;
 
 void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data);
+// Returns whether draws with the given native vertex components read any of the XF memory in
+// [start, end) with the current XF and CP state.
+bool IsXFMemoryUsed(u32 start, u32 end, u32 components);
 void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size);
 void PreprocessIndexedXF(CPArray array, u32 index, u16 address, u8 size);
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/XFStructs.h"
 
+#include <array>
 #include <bit>
 
 #include "Common/CommonTypes.h"
@@ -16,18 +17,109 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/GeometryShaderManager.h"
+#include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/XFMemory.h"
 #include "VideoCommon/XFStateManager.h"
 
+bool IsXFMemoryUsed(u32 start, u32 end, u32 components)
+{
+  const auto overlaps = [start, end](u32 range_start, u32 range_size) {
+    return start < range_start + range_size && end > range_start;
+  };
+
+  // Per-vertex matrix indices can select any of the matrices.
+  if (components & VB_HAS_POSMTXIDX)
+  {
+    if (overlaps(XFMEM_POSMATRICES, XFMEM_POSMATRICES_END - XFMEM_POSMATRICES) ||
+        overlaps(XFMEM_NORMALMATRICES, XFMEM_NORMALMATRICES_END - XFMEM_NORMALMATRICES))
+    {
+      return true;
+    }
+  }
+  else
+  {
+    const u32 index = g_main_cp_state.matrix_index_a.PosNormalMtxIdx;
+    if (overlaps(XFMEM_POSMATRICES + index * 4, 12) ||
+        overlaps(XFMEM_NORMALMATRICES + (index & 31) * 3, 9))
+    {
+      return true;
+    }
+  }
+
+  const std::array<u32, 8> tex_matrix_indices = {
+      g_main_cp_state.matrix_index_a.Tex0MtxIdx, g_main_cp_state.matrix_index_a.Tex1MtxIdx,
+      g_main_cp_state.matrix_index_a.Tex2MtxIdx, g_main_cp_state.matrix_index_a.Tex3MtxIdx,
+      g_main_cp_state.matrix_index_b.Tex4MtxIdx, g_main_cp_state.matrix_index_b.Tex5MtxIdx,
+      g_main_cp_state.matrix_index_b.Tex6MtxIdx, g_main_cp_state.matrix_index_b.Tex7MtxIdx,
+  };
+  u32 light_mask = 0;
+  for (u32 i = 0; i < xfmem.numTexGen.numTexGens; i++)
+  {
+    if (components & (VB_HAS_TEXMTXIDX0 << i))
+    {
+      if (overlaps(XFMEM_POSMATRICES, XFMEM_POSMATRICES_END - XFMEM_POSMATRICES))
+        return true;
+    }
+    else if (overlaps(XFMEM_POSMATRICES + tex_matrix_indices[i] * 4, 12))
+    {
+      return true;
+    }
+
+    if (xfmem.dualTexTrans.enabled &&
+        overlaps(XFMEM_POSTMATRICES + xfmem.postMtxInfo[i].index * 4, 12))
+    {
+      return true;
+    }
+
+    if (xfmem.texMtxInfo[i].texgentype == TexGenType::EmbossMap)
+      light_mask |= 1u << xfmem.texMtxInfo[i].embosslightshift;
+  }
+
+  for (u32 i = 0; i < xfmem.numChan.numColorChans; i++)
+  {
+    if (xfmem.color[i].enablelighting)
+      light_mask |= xfmem.color[i].GetFullLightMask();
+    if (xfmem.alpha[i].enablelighting)
+      light_mask |= xfmem.alpha[i].GetFullLightMask();
+  }
+
+  constexpr u32 light_size = sizeof(Light) / sizeof(u32);
+  for (u32 i = 0; i < 8; i++)
+  {
+    if ((light_mask & (1u << i)) && overlaps(XFMEM_LIGHTS + i * light_size, light_size))
+      return true;
+  }
+
+  return false;
+}
+
 static void XFMemWritten(XFStateManager& xf_state_manager, u32 transferSize, u32 baseAddress)
 {
-  g_vertex_manager->Flush();
+  // Games often load matrices for the next object while the previous one is still pending. Those
+  // draws don't need to be flushed unless they read the changed memory.
+  if (IsXFMemoryUsed(baseAddress, baseAddress + transferSize,
+                     VertexLoaderManager::g_current_components))
+  {
+    g_vertex_manager->Flush();
+  }
+  else if (g_vertex_manager->HasSendableVertices())
+  {
+    INCSTAT(g_stats.this_frame.num_merged_state_changes);
+  }
   xf_state_manager.InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Counts the writes which would have flushed the pending draws without changing anything.
+static void CountRedundantWrite()
+{
+  if (g_vertex_manager->HasSendableVertices())
+    INCSTAT(g_stats.this_frame.num_redundant_state_writes);
+}
+
 static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager, u32 address,
                          u32 value)
 {
@@ -120,6 +212,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        CountRedundantWrite();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetViewportChanged();
       system.GetPixelShaderManager().SetViewportChanged();
@@ -133,6 +230,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        CountRedundantWrite();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetProjectionChanged();
       system.GetGeometryShaderManager().SetProjectionChanged();
@@ -151,6 +253,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        CountRedundantWrite();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
       break;
@@ -163,6 +270,11 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
+      if (((u32*)&xfmem)[address] == value)
+      {
+        CountRedundantWrite();
+        break;
+      }
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
       break;
@@ -232,12 +344,29 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_state_manager, xf_mem_transfer_size, xf_mem_base);
+    // Games often load the same matrices again, which doesn't need to flush anything.
+    u32* const xf_mem = reinterpret_cast<u32*>(&xfmem) + xf_mem_base;
+    bool changed = false;
     for (u32 i = 0; i < xf_mem_transfer_size; i++)
     {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
+      if (xf_mem[i] != Common::swap32(data + i * 4))
+      {
+        changed = true;
+        break;
+      }
+    }
+
+    if (changed)
+    {
+      XFMemWritten(xf_state_manager, xf_mem_transfer_size, xf_mem_base);
+      for (u32 i = 0; i < xf_mem_transfer_size; i++)
+        xf_mem[i] = Common::swap32(data + i * 4);
+    }
+    else
+    {
+      CountRedundantWrite();
     }
+    data += xf_mem_transfer_size * 4;
   }
 
   // write to XF regs
@@ -293,6 +422,10 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
     for (u32 i = 0; i < size; ++i)
       currData[i] = Common::swap32(newData[i]);
   }
+  else
+  {
+    CountRedundantWrite();
+  }
 }
 
 void PreprocessIndexedXF(CPArray array, u32 index, u16 address, u8 size)
@@ -0,0 +1,248 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/IndexedDiskCache.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+// Roughly the size of a serialized pipeline UID.
+struct TestKey
+{
+  u32 values[32];
+};
+
+TestKey MakeKey(u32 index)
+{
+  TestKey key{};
+  for (u32 i = 0; i < std::size(key.values); i++)
+    key.values[i] = index * 2654435761u + i;
+  return key;
+}
+
+std::vector<u8> MakeValue(u32 index, u32 size)
+{
+  std::vector<u8> value(size);
+  for (u32 i = 0; i < size; i++)
+    value[i] = static_cast<u8>(index * 31 + i);
+  return value;
+}
+
+using TestCache = Common::IndexedDiskCache<TestKey, u8>;
+
+class IndexedDiskCacheTest : public testing::Test
+{
+protected:
+  IndexedDiskCacheTest()
+      : m_directory(File::CreateTempDir()), m_filename(m_directory + "/test.cache")
+  {
+  }
+
+  ~IndexedDiskCacheTest() override { File::DeleteDirRecursively(m_directory); }
+
+  void Populate(u32 count)
+  {
+    TestCache cache;
+    EXPECT_EQ(cache.Open(m_filename), 0u);
+    for (u32 i = 0; i < count; i++)
+    {
+      const std::vector<u8> value = MakeValue(i, 100 + i);
+      cache.Append(MakeKey(i), value.data(), static_cast<u32>(value.size()));
+    }
+  }
+
+  void ExpectContents(TestCache& cache, u32 count)
+  {
+    ASSERT_EQ(cache.GetEntryCount(), count);
+    for (u32 i = 0; i < count; i++)
+    {
+      std::vector<u8> value;
+      ASSERT_TRUE(cache.Read(MakeKey(i), &value)) << i;
+      EXPECT_EQ(value, MakeValue(i, 100 + i)) << i;
+    }
+  }
+
+  // Overwrites part of the file, bypassing the cache.
+  void Patch(u64 offset, const void* data, size_t size)
+  {
+    File::IOFile file(m_filename, "r+b");
+    ASSERT_TRUE(file.Seek(offset, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteBytes(data, size));
+  }
+
+  std::string m_directory;
+  std::string m_filename;
+};
+}  // namespace
+
+TEST_F(IndexedDiskCacheTest, RoundTrip)
+{
+  Populate(50);
+
+  TestCache cache;
+  EXPECT_EQ(cache.Open(m_filename), 50u);
+  ExpectContents(cache, 50);
+  EXPECT_FALSE(cache.Contains(MakeKey(50)));
+  EXPECT_EQ(cache.GetStaleBytes(), 0u);
+
+  // Entries added after reopening must be readable before and after the index is rewritten.
+  const std::vector<u8> value = MakeValue(50, 150);
+  cache.Append(MakeKey(50), value.data(), static_cast<u32>(value.size()));
+  ExpectContents(cache, 51);
+  cache.Close();
+
+  EXPECT_EQ(cache.Open(m_filename), 51u);
+  ExpectContents(cache, 51);
+}
+
+TEST_F(IndexedDiskCacheTest, ReaderVisitsKeysInOrder)
+{
+  Populate(20);
+
+  class Reader : public Common::LinearDiskCacheReader<TestKey, u8>
+  {
+  public:
+    void Read(const TestKey& key, const u8* value, u32 value_size) override
+    {
+      if (!keys.empty())
+      {
+        EXPECT_LT(std::memcmp(&keys.back(), &key, sizeof(key)), 0);
+      }
+      keys.push_back(key);
+    }
+    std::vector<TestKey> keys;
+  } reader;
+
+  TestCache cache;
+  EXPECT_EQ(cache.OpenAndRead(m_filename, reader), 20u);
+  EXPECT_EQ(reader.keys.size(), 20u);
+}
+
+TEST_F(IndexedDiskCacheTest, VersionMismatch)
+{
+  Populate(10);
+
+  TestCache cache;
+  EXPECT_EQ(cache.Open(m_filename, "other"), 0u);
+  cache.Close();
+  EXPECT_EQ(cache.Open(m_filename, "other"), 0u);
+}
+
+TEST_F(IndexedDiskCacheTest, ReplaceAndCompact)
+{
+  TestCache cache;
+  cache.Open(m_filename);
+  for (u32 i = 0; i < 10; i++)
+  {
+    for (u32 j = 0; j < 10; j++)
+    {
+      const std::vector<u8> value = MakeValue(j == 9 ? i : 1000 + j, 100 + i);
+      cache.Append(MakeKey(i), value.data(), static_cast<u32>(value.size()));
+    }
+  }
+  ExpectContents(cache, 10);
+  EXPECT_GT(cache.GetStaleBytes(), 0u);
+
+  cache.Erase(MakeKey(9));
+  EXPECT_FALSE(cache.Contains(MakeKey(9)));
+
+  const u64 size_before = File::GetSize(m_filename);
+  cache.Close();
+  EXPECT_LT(File::GetSize(m_filename), size_before);
+
+  EXPECT_EQ(cache.Open(m_filename), 9u);
+  EXPECT_EQ(cache.GetStaleBytes(), 0u);
+  ExpectContents(cache, 9);
+  cache.Close();
+
+  EXPECT_TRUE(TestCache::CompactFile(m_filename));
+  EXPECT_EQ(cache.Open(m_filename), 9u);
+  ExpectContents(cache, 9);
+}
+
+TEST_F(IndexedDiskCacheTest, RebuildsMissingIndex)
+{
+  Populate(30);
+
+  // Clear the index offset in the header, as if Dolphin had crashed before writing the index, and
+  // add a partial record at the end.
+  const u64 file_size = File::GetSize(m_filename);
+  const u64 index_offset = 0;
+  Patch(16, &index_offset, sizeof(index_offset));
+  {
+    File::IOFile file(m_filename, "r+b");
+    file.Resize(file_size + 20);
+  }
+
+  TestCache cache;
+  EXPECT_EQ(cache.Open(m_filename), 30u);
+  ExpectContents(cache, 30);
+
+  // The rebuilt index is written back when the cache is closed.
+  cache.Close();
+  EXPECT_EQ(cache.Open(m_filename), 30u);
+  ExpectContents(cache, 30);
+}
+
+TEST_F(IndexedDiskCacheTest, CorruptValueIsDropped)
+{
+  Populate(5);
+
+  // The first record starts after the 64-byte header, its value after the record header and key.
+  const u8 garbage = 0xAA;
+  Patch(64 + 8 + sizeof(TestKey) + 3, &garbage, 1);
+
+  TestCache cache;
+  EXPECT_EQ(cache.Open(m_filename), 5u);
+  std::vector<u8> value;
+  EXPECT_FALSE(cache.Read(MakeKey(0), &value));
+
+  u32 visited = 0;
+  cache.ForEach([&](const TestKey&, const u8*, u32) { visited++; });
+  EXPECT_EQ(visited, 4u);
+  EXPECT_EQ(cache.GetEntryCount(), 4u);
+}
+
+TEST_F(IndexedDiskCacheTest, AppendAfterSyncInvalidatesIndex)
+{
+  Populate(10);
+
+  TestCache cache;
+  EXPECT_EQ(cache.Open(m_filename), 10u);
+  for (u32 i = 10; i < 13; i++)
+  {
+    const std::vector<u8> value = MakeValue(i, 100 + i);
+    cache.Append(MakeKey(i), value.data(), static_cast<u32>(value.size()));
+
+    // The first record appended after this overwrites the index that was just written.
+    if (i == 10)
+      cache.Sync();
+  }
+
+  // Look at the file as if Dolphin had crashed now, without the Sync done by Close.
+  const std::string crashed_filename = m_directory + "/crashed.cache";
+  ASSERT_TRUE(File::CopyRegularFile(m_filename, crashed_filename));
+
+  u64 index_offset = 1;
+  {
+    File::IOFile file(crashed_filename, "rb");
+    ASSERT_TRUE(file.Seek(16, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.ReadArray(&index_offset, 1));
+  }
+  EXPECT_EQ(index_offset, 0u);
+
+  // The records up to the one whose write was last flushed are recovered by scanning.
+  TestCache crashed;
+  EXPECT_GE(crashed.Open(crashed_filename), 12u);
+  ExpectContents(crashed, crashed.GetEntryCount());
+}
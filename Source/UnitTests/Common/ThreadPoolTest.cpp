@@ -0,0 +1,63 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/ThreadPool.h"
+
+using Common::ThreadPool;
+
+TEST(ThreadPool, NoWorkers)
+{
+  ThreadPool pool("Test", 0);
+  EXPECT_EQ(pool.GetNumWorkers(), 0u);
+
+  std::vector<int> visited(100, 0);
+  pool.ParallelFor(visited.size(), [&](size_t i) { visited[i]++; });
+  for (int count : visited)
+    EXPECT_EQ(count, 1);
+}
+
+TEST(ThreadPool, EveryItemOnce)
+{
+  ThreadPool pool("Test", 3);
+  EXPECT_EQ(pool.GetNumWorkers(), 3u);
+
+  for (size_t count : {0, 1, 2, 7, 1000})
+  {
+    std::vector<std::atomic<int>> visited(count);
+    pool.ParallelFor(count, [&](size_t i) { visited[i]++; });
+    for (const auto& item : visited)
+      EXPECT_EQ(item.load(), 1);
+  }
+}
+
+TEST(ThreadPool, ManyJobs)
+{
+  ThreadPool pool("Test", 2);
+
+  // Items reference the caller's stack, so every job must be complete when ParallelFor returns.
+  for (int job = 0; job < 10000; job++)
+  {
+    std::atomic<int> sum = 0;
+    pool.ParallelFor(4, [&](size_t i) { sum += static_cast<int>(i) + 1; });
+    ASSERT_EQ(sum.load(), 10);
+  }
+}
+
+TEST(ThreadPool, Reset)
+{
+  ThreadPool pool;
+  pool.Reset("Test", 2);
+  pool.Reset("Test", 1);
+  EXPECT_EQ(pool.GetNumWorkers(), 1u);
+
+  std::atomic<int> sum = 0;
+  pool.ParallelFor(10, [&](size_t i) { sum += static_cast<int>(i); });
+  EXPECT_EQ(sum.load(), 45);
+
+  pool.Shutdown();
+  EXPECT_EQ(pool.GetNumWorkers(), 0u);
+}
@@ -0,0 +1,152 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/FileUtil.h"
+#include "Common/JsonUtil.h"
+#include "Common/TraceRecorder.h"
+
+namespace
+{
+struct TraceEvent
+{
+  std::string phase;
+  std::string name;
+  double ts = 0;
+  double dur = 0;
+};
+
+// Reads the events of a written trace, by thread name.
+std::map<std::string, std::vector<TraceEvent>> ReadTrace()
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/trace.json";
+  EXPECT_TRUE(Common::TraceRecorder::WriteChromeTrace(path));
+
+  picojson::value root;
+  std::string error;
+  EXPECT_TRUE(JsonFromFile(path, &root, &error)) << error;
+  File::DeleteDirRecursively(directory);
+
+  std::map<double, std::string> thread_names;
+  std::vector<std::pair<double, TraceEvent>> events;
+  for (const picojson::value& value : root.get("traceEvents").get<picojson::array>())
+  {
+    const double tid = value.get("tid").get<double>();
+    const std::string phase = value.get("ph").get<std::string>();
+    if (phase == "M")
+    {
+      thread_names[tid] = value.get("args").get("name").get<std::string>();
+      continue;
+    }
+    TraceEvent& event = events.emplace_back(tid, TraceEvent{phase}).second;
+    event.name = value.get("name").get<std::string>();
+    event.ts = value.get("ts").get<double>();
+    if (phase == "X")
+      event.dur = value.get("dur").get<double>();
+  }
+
+  std::map<std::string, std::vector<TraceEvent>> result;
+  for (auto& [tid, event] : events)
+    result[thread_names.at(tid)].push_back(std::move(event));
+  return result;
+}
+
+void RecordInnerZone()
+{
+  TRACE_ZONE("Inner");
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void RecordZones()
+{
+  {
+    TRACE_ZONE("Outer");
+    RecordInnerZone();
+  }
+  Common::TraceRecorder::AddMarker("Marker");
+}
+}  // namespace
+
+TEST(TraceRecorder, RecordsZonesOfEachThread)
+{
+  Common::TraceRecorder::Start();
+  std::vector<std::thread> threads;
+  for (const char* name : {"First", "Second"})
+  {
+    threads.emplace_back([name] {
+      Common::TraceRecorder::SetCurrentThreadName(name);
+      RecordZones();
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  Common::TraceRecorder::Stop();
+
+  // Nothing is recorded after stopping.
+  std::thread([] {
+    Common::TraceRecorder::SetCurrentThreadName("Late");
+    RecordZones();
+  }).join();
+
+  const auto trace = ReadTrace();
+  ASSERT_EQ(trace.size(), 2u);
+  for (const char* name : {"First", "Second"})
+  {
+    // Zones are added when they end.
+    const std::vector<TraceEvent>& events = trace.at(name);
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].phase, "X");
+    EXPECT_EQ(events[0].name, "Inner");
+    EXPECT_EQ(events[1].phase, "X");
+    EXPECT_EQ(events[1].name, "Outer");
+    EXPECT_EQ(events[2].phase, "i");
+    EXPECT_EQ(events[2].name, "Marker");
+
+    EXPECT_GE(events[0].dur, 1000);
+    EXPECT_LE(events[1].ts, events[0].ts);
+    EXPECT_GE(events[1].ts + events[1].dur, events[0].ts + events[0].dur);
+    EXPECT_GE(events[2].ts, events[1].ts + events[1].dur);
+  }
+  EXPECT_EQ(Common::TraceRecorder::GetNumOverwrittenEvents(), 0u);
+}
+
+TEST(TraceRecorder, KeepsLatestEventsOfFullThreads)
+{
+  Common::TraceRecorder::Start(10);
+  std::thread([] {
+    Common::TraceRecorder::SetCurrentThreadName("Busy");
+    for (int i = 0; i < 15; i++)
+      TRACE_ZONE("Old");
+    for (int i = 0; i < 10; i++)
+      TRACE_ZONE("New");
+  }).join();
+  Common::TraceRecorder::Stop();
+
+  EXPECT_EQ(Common::TraceRecorder::GetNumOverwrittenEvents(), 15u);
+  const auto trace = ReadTrace();
+  ASSERT_EQ(trace.size(), 1u);
+  const std::vector<TraceEvent>& events = trace.at("Busy");
+  ASSERT_EQ(events.size(), 10u);
+  for (size_t i = 0; i < events.size(); i++)
+  {
+    EXPECT_EQ(events[i].name, "New");
+    if (i != 0)
+      EXPECT_GE(events[i].ts, events[i - 1].ts);
+  }
+
+  // Starting again discards the previous recording.
+  Common::TraceRecorder::Start();
+  Common::TraceRecorder::Stop();
+  EXPECT_EQ(Common::TraceRecorder::GetNumOverwrittenEvents(), 0u);
+  EXPECT_TRUE(ReadTrace().empty());
+}
@@ -105,6 +105,7 @@ protected:
     cpu_info.bSSE4_2 = true;
     cpu_info.bLZCNT = true;
     cpu_info.bAVX = true;
+    cpu_info.bAVX2 = true;
     cpu_info.bBMI1 = true;
     cpu_info.bBMI2 = true;
     cpu_info.bBMI2FastParallelBitOps = true;
@@ -239,6 +240,7 @@ TEST_INSTR_NO_OPERANDS(CWDE, "cwde")
 TEST_INSTR_NO_OPERANDS(CDQE, "cdqe")
 TEST_INSTR_NO_OPERANDS(XCHG_AHAL, "xchg al, ah")
 TEST_INSTR_NO_OPERANDS(RDTSC, "rdtsc")
+TEST_INSTR_NO_OPERANDS(VZEROUPPER, "vzeroupper")
 
 TEST_F(x64EmitterTest, NOP_MultiByte)
 {
@@ -1362,6 +1364,113 @@ FMA4_TEST(VFNMSUB, S, false)
 FMA4_TEST(VFMADDSUB, P, true)
 FMA4_TEST(VFMSUBADD, P, true)
 
+// for VEX encoded loads, which take the form op reg, mem
+#define AVX_LOAD_TEST(Name, sizename)                                                              \
+  TEST_F(x64EmitterTest, Name)                                                                     \
+  {                                                                                                \
+    for (const auto& r : xmmnames)                                                                 \
+    {                                                                                              \
+      emitter->Name(r.reg, MatR(R12));                                                             \
+      ExpectDisassembly(#Name " " + r.name + ", " sizename " ptr ds:[r12]");                       \
+    }                                                                                              \
+  }
+
+// for VEX encoded stores, which take the form op mem, reg
+#define AVX_STORE_TEST(Name, sizename)                                                             \
+  TEST_F(x64EmitterTest, Name)                                                                     \
+  {                                                                                                \
+    for (const auto& r : xmmnames)                                                                 \
+    {                                                                                              \
+      emitter->Name(MatR(R12), r.reg);                                                             \
+      ExpectDisassembly(#Name " " sizename " ptr ds:[r12], " + r.name);                            \
+    }                                                                                              \
+  }
+
+AVX_LOAD_TEST(VMOVDQU, "dqword")
+AVX_STORE_TEST(VMOVSS, "dword")
+AVX_STORE_TEST(VMOVLPS, "qword")
+AVX_STORE_TEST(VMOVUPS, "dqword")
+
+TEST_F(x64EmitterTest, VMOVD_VMOVQ_xmm)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VMOVD_xmm(r.reg, MatR(R12));
+    emitter->VMOVQ_xmm(r.reg, MatR(R12));
+    ExpectDisassembly("vmovd " + r.name + ", dword ptr ds:[r12] vmovq " + r.name +
+                      ", qword ptr ds:[r12]");
+  }
+}
+
+TEST_F(x64EmitterTest, VEXTRACTPS)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VEXTRACTPS(MatR(R12), r.reg, 2);
+    ExpectDisassembly("vextractps dword ptr ds:[r12], " + r.name + ", 0x02");
+  }
+}
+
+TEST_F(x64EmitterTest, VCVTSI2SS)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VCVTSI2SS(r.reg, XMM0, R(EAX));
+    emitter->VCVTSI2SS(XMM0, r.reg, MatR(R12));
+    ExpectDisassembly("vcvtsi2ss " + r.name + ", xmm0, eax vcvtsi2ss xmm0, " + r.name +
+                      ", dword ptr ds:[r12]");
+  }
+}
+
+TEST_F(x64EmitterTest, AVX_256)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VCVTDQ2PS_256(r.reg, MatR(R12));
+    emitter->VMULPS_256(r.reg, YMM1, R(r.reg));
+    emitter->VPSHUFB_256(YMM1, r.reg, MatR(R12));
+    emitter->VPSRAD_256(r.reg, YMM1, 24);
+    ExpectDisassembly("vcvtdq2ps " + r.name + ", qqword ptr ds:[r12] vmulps " + r.name +
+                      ", ymm1, " + r.name + " vpshufb ymm1, " + r.name +
+                      ", qqword ptr ds:[r12] vpsrad " + r.name + ", ymm1, 0x18");
+  }
+}
+
+TEST_F(x64EmitterTest, VPBLENDD_256)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VPBLENDD_256(r.reg, YMM2, R(YMM10), 0xF0);
+    ExpectDisassembly("vpblendd " + r.name + ", ymm2, ymm10, 0xf0");
+    emitter->VPBLENDD_256(YMM0, r.reg, MatR(R12), 0x0F);
+    ExpectDisassembly("vpblendd ymm0, " + r.name + ", qqword ptr ds:[r12], 0x0f");
+  }
+}
+
+TEST_F(x64EmitterTest, VPBROADCAST_VBROADCASTI128)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VPBROADCASTD_256(r.reg, MatR(R12));
+    ExpectDisassembly("vpbroadcastd " + r.name + ", dword ptr ds:[r12]");
+    emitter->VPBROADCASTQ_256(r.reg, MatR(R12));
+    ExpectDisassembly("vpbroadcastq " + r.name + ", qword ptr ds:[r12]");
+  }
+
+  // Bochs shows the memory operand of this as 256 bits wide, so check the encoding instead.
+  emitter->VBROADCASTI128(YMM1, MComplex(R8, RAX, 1, 3));
+  ExpectBytes({0xc4, 0xc2, 0x7d, 0x5a, 0x4c, 0x00, 0x03});
+}
+
+TEST_F(x64EmitterTest, VEXTRACTI128)
+{
+  // Bochs shows the 128-bit operand as a YMM register, so check the encoding instead.
+  emitter->VEXTRACTI128(R(XMM1), YMM12, 1);
+  ExpectBytes({0xc4, 0x63, 0x7d, 0x39, 0xe1, 0x01});
+  emitter->VEXTRACTI128(MDisp(RAX, 0x20), YMM3, 1);
+  ExpectBytes({0xc4, 0xe3, 0x7d, 0x39, 0x58, 0x20, 0x01});
+}
+
 }  // namespace Gen
 
 #ifdef _MSC_VER
@@ -0,0 +1,153 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest-spi.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+namespace
+{
+constexpr u32 NUM_FRAMES = 4;
+
+// Offsets into the file format, for corrupting files.
+constexpr u64 HEADER_FRAME_LIST_OFFSET = 60;
+constexpr u64 FRAME_MEMORY_UPDATES_OFFSET = 20;
+constexpr u64 MEMORY_UPDATE_DATA_SIZE = 16;
+
+std::vector<u8> MakeData(u32 size, u32 seed)
+{
+  std::vector<u8> data(size);
+  for (u32 i = 0; i < size; i++)
+    data[i] = static_cast<u8>(i * 7 + seed);
+  return data;
+}
+
+// Every frame but the last has memory updates, and the texture of the first frame is loaded again
+// by the third one, so its data is only stored once.
+FifoFrameInfo MakeFrame(u32 frame)
+{
+  FifoFrameInfo info;
+  info.fifoData = MakeData(1000 + frame * 100, frame);
+  info.fifoStart = frame * 0x1000;
+  info.fifoEnd = info.fifoStart + static_cast<u32>(info.fifoData.size());
+  if (frame == NUM_FRAMES - 1)
+    return info;
+
+  const u32 texture_seed = frame == 2 ? 0 : frame;
+  info.memoryUpdates.push_back(
+      {10, 0x80001000, MakeData(4096, texture_seed), MemoryUpdate::Type::TextureMap});
+  info.memoryUpdates.push_back(
+      {500, 0x80100000 + frame, MakeData(96, 100 + frame), MemoryUpdate::Type::VertexStream});
+  return info;
+}
+
+// The loaded file is read in place, so it is destroyed before the directory is deleted.
+std::unique_ptr<FifoDataFile> s_loaded_file;
+std::string s_path;
+
+class FifoDataFileTest : public testing::TestWithParam<bool>
+{
+protected:
+  void SetUp() override
+  {
+    Config::Init();
+    Config::SetCurrent(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS, GetParam());
+    m_directory = File::CreateTempDir();
+    s_path = m_directory + "/test.dff";
+
+    FifoDataFile file;
+    file.SetIsWii(true);
+    for (u32 i = 0; i < FifoDataFile::BP_MEM_SIZE; i++)
+      file.GetBPMem()[i] = i * 3;
+    for (u32 i = 0; i < NUM_FRAMES; i++)
+      file.AddFrame(MakeFrame(i));
+    ASSERT_TRUE(file.Save(s_path));
+  }
+
+  void TearDown() override
+  {
+    s_loaded_file.reset();
+    File::DeleteDirRecursively(m_directory);
+    Config::Shutdown();
+  }
+
+  // Sets the size of the first memory update of the first frame.
+  void CorruptMemoryUpdateSize(u32 size)
+  {
+    File::IOFile file(s_path, "r+b");
+    u64 frame_list_offset;
+    u64 memory_updates_offset;
+    ASSERT_TRUE(file.Seek(HEADER_FRAME_LIST_OFFSET, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.ReadBytes(&frame_list_offset, sizeof(frame_list_offset)));
+    ASSERT_TRUE(
+        file.Seek(frame_list_offset + FRAME_MEMORY_UPDATES_OFFSET, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.ReadBytes(&memory_updates_offset, sizeof(memory_updates_offset)));
+    ASSERT_TRUE(
+        file.Seek(memory_updates_offset + MEMORY_UPDATE_DATA_SIZE, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteBytes(&size, sizeof(size)));
+  }
+
+  std::string m_directory;
+};
+}  // namespace
+
+TEST_P(FifoDataFileTest, RoundTrip)
+{
+  s_loaded_file = FifoDataFile::Load(s_path, false);
+  ASSERT_TRUE(s_loaded_file);
+  EXPECT_TRUE(s_loaded_file->GetIsWii());
+  EXPECT_EQ(s_loaded_file->GetBPMem()[5], 15u);
+  ASSERT_EQ(s_loaded_file->GetFrameCount(), NUM_FRAMES);
+
+  // Each frame is requested twice, as the compressed frames are cached, and once more without the
+  // memory updates.
+  for (u32 i = 0; i < NUM_FRAMES * 3; i++)
+  {
+    const u32 frame = i / 3;
+    const bool include_memory_updates = i % 3 != 2;
+    const FifoFrameInfo expected = MakeFrame(frame);
+    const FifoFrameView view = s_loaded_file->GetFrame(frame, include_memory_updates);
+    EXPECT_EQ(std::vector<u8>(view.fifoData.begin(), view.fifoData.end()), expected.fifoData);
+    EXPECT_EQ(view.fifoStart, expected.fifoStart);
+    EXPECT_EQ(view.fifoEnd, expected.fifoEnd);
+
+    if (!include_memory_updates)
+    {
+      EXPECT_TRUE(view.memoryUpdates.empty());
+      continue;
+    }
+
+    ASSERT_EQ(view.memoryUpdates.size(), expected.memoryUpdates.size()) << frame;
+    for (size_t j = 0; j < expected.memoryUpdates.size(); j++)
+    {
+      const MemoryUpdateView& update = view.memoryUpdates[j];
+      EXPECT_EQ(update.fifoPosition, expected.memoryUpdates[j].fifoPosition);
+      EXPECT_EQ(update.address, expected.memoryUpdates[j].address);
+      EXPECT_EQ(update.type, expected.memoryUpdates[j].type);
+      EXPECT_EQ(std::vector<u8>(update.data.begin(), update.data.end()),
+                expected.memoryUpdates[j].data);
+    }
+  }
+}
+
+TEST_P(FifoDataFileTest, RejectsOutOfBoundsMemoryUpdate)
+{
+  CorruptMemoryUpdateSize(0x10000000);
+
+  // Loading the file alerts the user, which fails the test unless it is expected.
+  EXPECT_NONFATAL_FAILURE(s_loaded_file = FifoDataFile::Load(s_path, false), "");
+  EXPECT_FALSE(s_loaded_file);
+}
+
+INSTANTIATE_TEST_SUITE_P(CompressedAndUncompressed, FifoDataFileTest, testing::Bool());
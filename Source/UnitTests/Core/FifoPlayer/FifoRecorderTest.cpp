@@ -0,0 +1,149 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/FileUtil.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/FifoPlayer/FifoRecorder.h"
+#include "Core/System.h"
+
+namespace
+{
+constexpr u32 NUM_FRAMES = 3;
+
+// A BP register write, which the recorder passes through without looking at memory.
+std::array<u8, 5> MakeCommand(u8 value)
+{
+  return {0x61, 0x49, 0x00, 0x00, value};
+}
+
+// Feeds frames to a recorder the way the video thread does, and keeps track of the data that each
+// frame should contain.
+class FrameFeeder
+{
+public:
+  FrameFeeder(FifoRecorder& recorder, u8 seed) : m_recorder(recorder), m_seed(seed) {}
+
+  void Start()
+  {
+    const std::array<u32, FifoDataFile::BP_MEM_SIZE> bpmem{};
+    const std::array<u32, FifoDataFile::CP_MEM_SIZE> cpmem{};
+    const std::array<u32, FifoDataFile::XF_MEM_SIZE + FifoDataFile::XF_REGS_SIZE> xfmem{};
+    const std::vector<u8> texmem(FifoDataFile::TEX_MEM_SIZE);
+    m_recorder.SetVideoMemory(bpmem.data(), cpmem.data(), xfmem.data(),
+                              xfmem.data() + FifoDataFile::XF_MEM_SIZE,
+                              FifoDataFile::XF_REGS_SIZE, texmem.data());
+
+    // The first command after recording starts is skipped.
+    m_recorder.EndFrame(0, 0);
+    const std::array<u8, 5> command = MakeCommand(0xff);
+    m_recorder.WriteGPCommand(command.data(), static_cast<u32>(command.size()));
+  }
+
+  void Frame(u32 frame)
+  {
+    for (u32 i = 0; i < frame + 2; i++)
+      Write(static_cast<u8>(m_seed + frame * 16 + i));
+    m_recorder.EndFrame(frame * 0x100, frame * 0x100 + 0x20);
+    m_frame_ended = true;
+  }
+
+  // Ends the last frame, and writes the data of each frame.
+  std::vector<std::vector<u8>> Finish()
+  {
+    Write(static_cast<u8>(m_seed + 0xf0));
+    return m_frames;
+  }
+
+private:
+  void Write(u8 value)
+  {
+    const std::array<u8, 5> command = MakeCommand(value);
+    m_recorder.WriteGPCommand(command.data(), static_cast<u32>(command.size()));
+
+    if (m_frames.empty() || m_start_new_frame)
+      m_frames.emplace_back();
+    m_frames.back().insert(m_frames.back().end(), command.begin(), command.end());
+
+    // The command after the end of a frame still belongs to it.
+    m_start_new_frame = m_frame_ended;
+    m_frame_ended = false;
+  }
+
+  FifoRecorder& m_recorder;
+  const u8 m_seed;
+  std::vector<std::vector<u8>> m_frames;
+  bool m_frame_ended = false;
+  bool m_start_new_frame = false;
+};
+
+class FifoRecorderTest : public testing::Test
+{
+protected:
+  FifoRecorderTest() : m_directory(File::CreateTempDir())
+  {
+    File::SetUserPath(D_CACHE_IDX, m_directory);
+  }
+
+  ~FifoRecorderTest() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+};
+}  // namespace
+
+// Two recordings at once must not share their file.
+TEST_F(FifoRecorderTest, RecordWriteAndReread)
+{
+  auto& system = Core::System::GetInstance();
+  std::array<std::unique_ptr<FifoRecorder>, 2> recorders;
+  std::array<Common::Event, 2> done;
+  std::vector<FrameFeeder> feeders;
+  for (u32 i = 0; i < recorders.size(); i++)
+  {
+    recorders[i] = std::make_unique<FifoRecorder>(system);
+    recorders[i]->StartRecording(NUM_FRAMES, [&done, i] { done[i].Set(); });
+    feeders.emplace_back(*recorders[i], static_cast<u8>(i * 0x80));
+    feeders[i].Start();
+  }
+
+  for (u32 frame = 0; frame < NUM_FRAMES; frame++)
+  {
+    for (FrameFeeder& feeder : feeders)
+      feeder.Frame(frame);
+  }
+
+  std::array<std::vector<std::vector<u8>>, 2> expected_frames;
+  for (u32 i = 0; i < recorders.size(); i++)
+    expected_frames[i] = feeders[i].Finish();
+  for (Common::Event& event : done)
+    event.Wait();
+
+  for (u32 i = 0; i < recorders.size(); i++)
+  {
+    const std::vector<std::vector<u8>>& expected = expected_frames[i];
+    ASSERT_TRUE(recorders[i]->IsRecordingDone());
+    EXPECT_FALSE(recorders[i]->IsRecording());
+    EXPECT_EQ(recorders[i]->GetStatistics().frames, NUM_FRAMES);
+
+    const FifoDataFile* file = recorders[i]->GetRecordedFile();
+    ASSERT_EQ(file->GetFrameCount(), NUM_FRAMES);
+    ASSERT_EQ(expected.size(), NUM_FRAMES);
+    for (u32 frame = 0; frame < NUM_FRAMES; frame++)
+    {
+      const FifoFrameView view = file->GetFrame(frame);
+      EXPECT_EQ(std::vector<u8>(view.fifoData.begin(), view.fifoData.end()), expected[frame]);
+      EXPECT_EQ(view.fifoStart, frame * 0x100);
+      EXPECT_EQ(view.fifoEnd, frame * 0x100 + 0x20);
+      EXPECT_TRUE(view.memoryUpdates.empty());
+    }
+  }
+}
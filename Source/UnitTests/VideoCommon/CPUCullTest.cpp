@@ -0,0 +1,164 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Core/System.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/CPUCull.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/XFMemory.h"
+
+namespace
+{
+using Primitive = OpcodeDecoder::Primitive;
+
+// Enough vertices for the draws to be split between the culling threads, and not a multiple of the
+// four vertices the AVX-512 transform handles at once.
+constexpr u32 NUM_VERTICES = 6006;
+constexpr u32 NUM_QUAD_VERTICES = 6004;
+
+// The vertex which makes its primitives visible is put at the start of the draw, around the
+// boundaries of the chunks of the culling threads, in the middle, and at the end.
+constexpr std::array<u32, 7> VISIBLE_VERTICES = {0, 1, 1534, 1535, 1536, 1537, 3000};
+
+// Each visible vertex is tried at several positions, so that its primitives face different ways.
+constexpr u32 NUM_TRIES = 8;
+
+constexpr std::array<Primitive, 4> PRIMITIVES = {
+    Primitive::GX_DRAW_QUADS, Primitive::GX_DRAW_TRIANGLES, Primitive::GX_DRAW_TRIANGLE_STRIP,
+    Primitive::GX_DRAW_TRIANGLE_FAN};
+
+constexpr std::array<CullMode, 4> CULL_MODES = {CullMode::None, CullMode::Back, CullMode::Front,
+                                                CullMode::All};
+
+class CPUCullTest : public testing::TestWithParam<std::tuple<bool, bool>>
+{
+protected:
+  void SetUp() override
+  {
+    std::tie(m_pos_has_3_elems, m_per_vertex_posmtx) = GetParam();
+    m_stride = (m_pos_has_3_elems ? 3 : 2) * sizeof(float);
+    if (m_per_vertex_posmtx)
+      m_stride += sizeof(u32);
+
+    // Clip space is the position, moved right by the matrix of each vertex.
+    auto& projection = Core::System::GetInstance().GetVertexShaderManager().constants.projection;
+    projection = {{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}};
+    for (u32 row = 0; row < 63; row += 3)
+    {
+      const float offset = row * (0.25f / 63);
+      const float matrix[12] = {1, 0, 0, offset, 0, 1, 0, 0, 0, 0, 1, 0};
+      std::memcpy(&xfmem.posMatrices[row * 4], matrix, sizeof(matrix));
+    }
+    g_main_cp_state.matrix_index_a.PosNormalMtxIdx = 3;
+  }
+
+  // Puts every vertex on a horizontal line through the screen, so that all primitives are
+  // degenerate, except for the visible vertex which is above or below it.
+  // The vector loads may read the whole last position, so the data is padded.
+  std::vector<u8> MakeVertices(u32 count, u32 visible_vertex, std::mt19937& rng) const
+  {
+    std::uniform_real_distribution<float> on_screen(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> off_line(0.1f, 0.5f);
+    std::bernoulli_distribution below;
+    std::uniform_int_distribution<u32> matrix(0, 20);
+    std::vector<u8> data(count * m_stride + 16);
+    for (u32 i = 0; i < count; i++)
+    {
+      u8* vertex = data.data() + i * m_stride;
+      if (m_per_vertex_posmtx)
+      {
+        const u32 posmtx = matrix(rng) * 3;
+        std::memcpy(vertex, &posmtx, sizeof(posmtx));
+        vertex += sizeof(posmtx);
+      }
+      float y = 0.0f;
+      if (i == visible_vertex)
+        y = below(rng) ? -off_line(rng) : off_line(rng);
+      const float position[3] = {on_screen(rng), y, on_screen(rng)};
+      std::memcpy(vertex, position, (m_pos_has_3_elems ? 3 : 2) * sizeof(float));
+    }
+    return data;
+  }
+
+  bool Cull(CPUCull& cpu_cull, Primitive primitive, CullMode cullmode,
+            const std::vector<u8>& vertices, u32 count) const
+  {
+    return cpu_cull.TransformAndCull(primitive, cullmode, m_pos_has_3_elems, m_per_vertex_posmtx,
+                                     vertices.data(), m_stride, count);
+  }
+
+  // Checks that cpu_cull culls the same draws as the scalar functions.
+  void CompareWithScalar(CPUCull& cpu_cull)
+  {
+    CPUCull scalar;
+    scalar.InitScalar();
+
+    std::mt19937 rng(1234);
+    for (Primitive primitive : PRIMITIVES)
+    {
+      const u32 count = primitive == Primitive::GX_DRAW_QUADS ? NUM_QUAD_VERTICES : NUM_VERTICES;
+      const std::vector<u8> hidden = MakeVertices(count, count, rng);
+      for (CullMode cullmode : CULL_MODES)
+      {
+        EXPECT_TRUE(Cull(scalar, primitive, cullmode, hidden, count));
+        EXPECT_TRUE(Cull(cpu_cull, primitive, cullmode, hidden, count));
+      }
+
+      std::vector<u32> visible_vertices(VISIBLE_VERTICES.begin(), VISIBLE_VERTICES.end());
+      visible_vertices.insert(visible_vertices.end(), {count - 2, count - 1});
+      for (u32 visible_vertex : visible_vertices)
+      {
+        for (u32 i = 0; i < NUM_TRIES; i++)
+        {
+          const std::vector<u8> vertices = MakeVertices(count, visible_vertex, rng);
+          EXPECT_FALSE(Cull(scalar, primitive, CullMode::None, vertices, count));
+          for (CullMode cullmode : CULL_MODES)
+          {
+            EXPECT_EQ(Cull(cpu_cull, primitive, cullmode, vertices, count),
+                      Cull(scalar, primitive, cullmode, vertices, count))
+                << "primitive " << static_cast<u32>(primitive) << ", cull mode "
+                << static_cast<u32>(cullmode) << ", visible vertex " << visible_vertex;
+          }
+        }
+      }
+    }
+  }
+
+  bool m_pos_has_3_elems = false;
+  bool m_per_vertex_posmtx = false;
+  u32 m_stride = 0;
+};
+}  // namespace
+
+TEST_P(CPUCullTest, AVX512MatchesScalar)
+{
+  if (!cpu_info.bAVX512F || !cpu_info.bFMA)
+    GTEST_SKIP() << "The CPU does not support AVX-512 and FMA";
+
+  CPUCull cpu_cull;
+  cpu_cull.Init();
+  CompareWithScalar(cpu_cull);
+}
+
+TEST_P(CPUCullTest, ParallelMatchesScalar)
+{
+  CPUCull cpu_cull;
+  cpu_cull.Init();
+  cpu_cull.SetNumThreads(3);
+  CompareWithScalar(cpu_cull);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllFormats, CPUCullTest,
+                         testing::Combine(testing::Bool(), testing::Bool()));
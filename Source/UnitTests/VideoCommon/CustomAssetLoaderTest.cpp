@@ -0,0 +1,246 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/CustomAssetLoader.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+
+namespace
+{
+constexpr std::size_t TEXTURE_SIZE = 1024 * 1024;
+const auto WRITE_TIME = VideoCommon::CustomAssetLibrary::TimeType{} + std::chrono::hours(1);
+
+// Provides a 4x4 texture for any asset, which claims to take TEXTURE_SIZE bytes.
+class TestLibrary final : public VideoCommon::CustomAssetLibrary
+{
+public:
+  LoadInfo LoadTexture(const AssetID& asset_id, VideoCommon::TextureData* data) override
+  {
+    m_num_started++;
+    {
+      std::unique_lock lk(m_lock);
+      m_unblocked.wait(lk, [this] { return !m_blocked; });
+      m_load_order.push_back(asset_id);
+    }
+    m_num_loads++;
+    data->m_type = VideoCommon::TextureData::Type::Type_Texture2D;
+    auto& level = data->m_texture.m_slices.emplace_back().m_levels.emplace_back();
+    level.width = 4;
+    level.height = 4;
+    level.data.resize(4 * 4 * 4);
+    return {TEXTURE_SIZE, m_write_time};
+  }
+  TimeType GetLastAssetWriteTime(const AssetID&) const override { return m_write_time; }
+  std::vector<std::filesystem::path> GetAssetFiles(const AssetID&) const override
+  {
+    return m_files;
+  }
+  LoadInfo LoadPixelShader(const AssetID&, VideoCommon::PixelShaderData*) override { return {}; }
+  LoadInfo LoadMaterial(const AssetID&, VideoCommon::MaterialData*) override { return {}; }
+  LoadInfo LoadMesh(const AssetID&, VideoCommon::MeshData*) override { return {}; }
+
+  // Holds up loads until it is cleared
+  void SetBlocked(bool blocked)
+  {
+    {
+      std::lock_guard lk(m_lock);
+      m_blocked = blocked;
+    }
+    m_unblocked.notify_all();
+  }
+
+  std::vector<AssetID> GetLoadOrder()
+  {
+    std::lock_guard lk(m_lock);
+    return m_load_order;
+  }
+
+  std::atomic<int> m_num_started = 0;
+  std::atomic<int> m_num_loads = 0;
+  std::atomic<TimeType> m_write_time = WRITE_TIME;
+  std::vector<std::filesystem::path> m_files;
+
+private:
+  std::mutex m_lock;
+  std::condition_variable m_unblocked;
+  bool m_blocked = false;
+  std::vector<AssetID> m_load_order;
+};
+
+class CustomAssetLoaderTest : public testing::Test
+{
+protected:
+  using LoadPriority = VideoCommon::CustomAssetLoader::LoadPriority;
+
+  CustomAssetLoaderTest() { m_loader.Init(); }
+  explicit CustomAssetLoaderTest(int num_load_threads) { m_loader.Init(num_load_threads); }
+  ~CustomAssetLoaderTest() override
+  {
+    m_textures.clear();
+    m_loader.Shutdown();
+  }
+
+  // The loader evicts textures and updates its statistics after the data of a load is set, so
+  // tests wait for it to be done with the loads rather than for their data.
+  bool WaitForLoads(u64 num_loads)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    while (m_loader.GetLoadStatistics().num_loads < num_loads)
+    {
+      if (std::chrono::steady_clock::now() - start > std::chrono::seconds(5))
+        return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  std::shared_ptr<VideoCommon::GameTextureAsset>
+  LoadTexture(int index, LoadPriority priority = LoadPriority::Normal)
+  {
+    auto texture = m_loader.LoadGameTexture("texture" + std::to_string(index), m_library, priority);
+    m_textures.push_back(texture);
+    return texture;
+  }
+
+  std::shared_ptr<TestLibrary> m_library = std::make_shared<TestLibrary>();
+  VideoCommon::CustomAssetLoader m_loader;
+  std::vector<std::shared_ptr<VideoCommon::GameTextureAsset>> m_textures;
+};
+
+// With a single load thread, so that the order of the loads is known.
+class CustomAssetLoaderSingleThreadTest : public CustomAssetLoaderTest
+{
+protected:
+  CustomAssetLoaderSingleThreadTest() : CustomAssetLoaderTest(1) {}
+};
+}  // namespace
+
+TEST_F(CustomAssetLoaderTest, EvictsLeastRecentlyUsed)
+{
+  m_loader.SetGameTextureMemoryBudget(3 * TEXTURE_SIZE);
+  // One at a time, so that they are used in a known order.
+  for (int i = 0; i < 3; i++)
+  {
+    LoadTexture(i);
+    ASSERT_TRUE(WaitForLoads(i + 1));
+  }
+
+  // Using the first texture makes the second one the least recently used.
+  EXPECT_TRUE(m_loader.UseGameTexture(m_textures[0]));
+  LoadTexture(3);
+  ASSERT_TRUE(WaitForLoads(4));
+  EXPECT_TRUE(m_textures[3]->GetData());
+  EXPECT_TRUE(m_textures[0]->GetData());
+  EXPECT_FALSE(m_textures[1]->GetData());
+  EXPECT_TRUE(m_textures[2]->GetData());
+
+  const auto statistics = m_loader.GetGameTextureStatistics();
+  EXPECT_EQ(statistics.num_loaded, 3u);
+  EXPECT_EQ(statistics.bytes_loaded, 3 * TEXTURE_SIZE);
+  EXPECT_EQ(statistics.num_evicted, 1u);
+}
+
+TEST_F(CustomAssetLoaderTest, ReloadsEvictedTextures)
+{
+  m_loader.SetGameTextureMemoryBudget(TEXTURE_SIZE);
+  const auto first = LoadTexture(0);
+  ASSERT_TRUE(WaitForLoads(1));
+  const auto loaded_time = first->GetLastLoadedTime();
+  LoadTexture(1);
+  ASSERT_TRUE(WaitForLoads(2));
+  EXPECT_FALSE(first->GetData());
+
+  // The file didn't change, so users of the texture which still have its data keep it.
+  EXPECT_FALSE(m_loader.UseGameTexture(first));
+  ASSERT_TRUE(WaitForLoads(3));
+  EXPECT_TRUE(first->GetData());
+  EXPECT_EQ(first->GetLastLoadedTime(), loaded_time);
+  EXPECT_TRUE(m_loader.UseGameTexture(first));
+  EXPECT_FALSE(m_textures[1]->GetData());
+  EXPECT_EQ(m_library->m_num_loads, 3);
+}
+
+TEST_F(CustomAssetLoaderTest, ReleasesMemoryOfDestroyedTextures)
+{
+  for (int i = 0; i < 8; i++)
+    LoadTexture(i);
+  ASSERT_TRUE(WaitForLoads(8));
+  EXPECT_EQ(m_loader.GetGameTextureStatistics().bytes_loaded, 8 * TEXTURE_SIZE);
+
+  m_textures.clear();
+  const auto statistics = m_loader.GetGameTextureStatistics();
+  EXPECT_EQ(statistics.num_loaded, 0u);
+  EXPECT_EQ(statistics.bytes_loaded, 0u);
+}
+
+TEST_F(CustomAssetLoaderSingleThreadTest, LoadsHigherPrioritiesFirst)
+{
+  // Keep the thread busy while the other loads are queued.
+  m_library->SetBlocked(true);
+  LoadTexture(0);
+  while (m_library->m_num_started == 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  LoadTexture(1, LoadPriority::Low);
+  LoadTexture(2, LoadPriority::Normal);
+  LoadTexture(3, LoadPriority::High);
+  LoadTexture(4, LoadPriority::Low);
+  LoadTexture(5, LoadPriority::Normal);
+  // Moves the texture ahead of the others which were queued before it.
+  EXPECT_FALSE(m_loader.UseGameTexture(m_textures[4], LoadPriority::High));
+  m_library->SetBlocked(false);
+
+  ASSERT_TRUE(WaitForLoads(6));
+
+  const std::vector<std::string> expected{"texture0", "texture3", "texture4",
+                                          "texture2", "texture5", "texture1"};
+  EXPECT_EQ(m_library->GetLoadOrder(), expected);
+
+  const auto statistics = m_loader.GetLoadStatistics();
+  EXPECT_EQ(statistics.num_loads, 6u);
+  EXPECT_GE(statistics.total_latency, statistics.total_load_time);
+  EXPECT_GE(statistics.max_latency, statistics.max_load_time);
+}
+
+TEST_F(CustomAssetLoaderTest, ReloadsChangedAssets)
+{
+  const std::string directory = File::CreateTempDir();
+  ASSERT_FALSE(directory.empty());
+  const std::filesystem::path file = std::filesystem::path(directory) / "texture.png";
+  ASSERT_TRUE(File::IOFile(file.string(), "wb").IsGood());
+  m_library->m_files = {file};
+
+  const auto texture = LoadTexture(0);
+  // The files are watched once the loader has finished with the asset.
+  ASSERT_TRUE(WaitForLoads(1));
+  const auto loaded_time = texture->GetLastLoadedTime();
+
+  m_library->m_write_time = WRITE_TIME + std::chrono::hours(1);
+  ASSERT_TRUE(File::IOFile(file.string(), "wb").WriteString("changed"));
+
+  const auto start = std::chrono::steady_clock::now();
+  while (m_library->m_num_loads < 2 &&
+         std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(m_library->m_num_loads, 2);
+  EXPECT_GT(texture->GetLastLoadedTime(), loaded_time);
+
+  File::DeleteDirRecursively(directory);
+}
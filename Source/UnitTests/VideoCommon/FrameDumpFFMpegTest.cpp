@@ -0,0 +1,80 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/FrameDumpFFMpeg.h"
+
+namespace
+{
+// The height doesn't split evenly between the threads, or into whole chroma rows.
+constexpr int WIDTH = 160;
+constexpr int HEIGHT = 123;
+
+struct FrameDeleter
+{
+  void operator()(AVFrame* frame) const { av_frame_free(&frame); }
+};
+using FramePtr = std::unique_ptr<AVFrame, FrameDeleter>;
+
+FramePtr AllocateYUVFrame()
+{
+  FramePtr frame(av_frame_alloc());
+  frame->format = AV_PIX_FMT_YUV420P;
+  frame->width = WIDTH;
+  frame->height = HEIGHT;
+  EXPECT_EQ(av_frame_get_buffer(frame.get(), 1), 0);
+  return frame;
+}
+
+// The planes of the converted frame, without the padding at the end of their rows.
+std::vector<std::vector<u8>> Convert(const FrameData& frame, int num_threads)
+{
+  FrameDumpScaler scaler;
+  const FramePtr src(av_frame_alloc());
+  const FramePtr dst = AllocateYUVFrame();
+  EXPECT_TRUE(scaler.Convert(frame, src.get(), dst.get(), num_threads));
+
+  std::vector<std::vector<u8>> planes;
+  for (int plane = 0; plane < 3; plane++)
+  {
+    const int width = plane == 0 ? WIDTH : (WIDTH + 1) / 2;
+    const int height = plane == 0 ? HEIGHT : (HEIGHT + 1) / 2;
+    std::vector<u8>& data = planes.emplace_back();
+    for (int row = 0; row < height; row++)
+    {
+      const u8* const row_data = dst->data[plane] + row * dst->linesize[plane];
+      data.insert(data.end(), row_data, row_data + width);
+    }
+  }
+  return planes;
+}
+}  // namespace
+
+// Splitting the frame between threads must not leave seams, which are most visible in the chroma
+// planes as their rows are filtered together with the rows above and below them.
+TEST(FrameDumpScaler, ThreadsMatchSingleThread)
+{
+  // Rows are padded like the rows of a mapped readback texture may be.
+  constexpr int STRIDE = WIDTH * 4 + 64;
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<u8> data(STRIDE * HEIGHT);
+  for (u8& value : data)
+    value = static_cast<u8>(byte(rng));
+  const FrameData frame{data.data(), WIDTH, HEIGHT, STRIDE, {}};
+
+  const std::vector<std::vector<u8>> expected = Convert(frame, 1);
+  for (int num_threads : {2, 3, 4, 7})
+    EXPECT_EQ(Convert(frame, num_threads), expected) << num_threads << " threads";
+}
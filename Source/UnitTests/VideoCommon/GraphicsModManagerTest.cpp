@@ -0,0 +1,83 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GraphicsModSystem/Config/GraphicsMod.h"
+#include "VideoCommon/GraphicsModSystem/Config/GraphicsModGroup.h"
+#include "VideoCommon/GraphicsModSystem/Runtime/Actions/SkipAction.h"
+#include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
+
+namespace
+{
+// A large pack, with a target for every other texture.
+constexpr u32 NUM_TEXTURES = 20000;
+
+std::string GetTextureName(u32 i)
+{
+  return fmt::format("tex1_64x64_{:016x}_14", u64(i) * 0x9E3779B97F4A7C15);
+}
+
+class GraphicsModManagerTest : public testing::Test
+{
+protected:
+  GraphicsModManagerTest()
+  {
+    GraphicsTargetGroupConfig group;
+    group.m_name = "Textures";
+    for (u32 i = 0; i < NUM_TEXTURES; i += 2)
+    {
+      DrawStartedTextureTarget draw_started;
+      draw_started.m_texture_info_string = GetTextureName(i);
+      group.m_targets.push_back(draw_started);
+
+      LoadTextureTarget load;
+      load.m_texture_info_string = GetTextureName(i);
+      group.m_targets.push_back(load);
+
+      ProjectionTarget projection;
+      projection.m_texture_info_string = GetTextureName(i);
+      projection.m_projection_type = ProjectionType::Orthographic;
+      group.m_targets.push_back(projection);
+    }
+
+    GraphicsModConfig mod;
+    mod.m_title = "Test";
+    mod.m_enabled = true;
+    mod.m_groups.push_back(std::move(group));
+    mod.m_features.push_back({"Textures", std::string(SkipAction::factory_name), {}});
+
+    GraphicsModGroupConfig config("GTEST");
+    config.GetMods().push_back(std::move(mod));
+    m_manager.Load(config);
+
+    for (u32 i = 0; i < NUM_TEXTURES; i++)
+      m_keys.push_back(GraphicsModManager::GetTextureKey(GetTextureName(i)));
+  }
+
+  GraphicsModManager m_manager;
+  std::vector<u64> m_keys;
+};
+}  // namespace
+
+TEST_F(GraphicsModManagerTest, FindsTargets)
+{
+  for (u32 i = 0; i < NUM_TEXTURES; i++)
+  {
+    const size_t expected = i % 2 == 0 ? 1 : 0;
+    ASSERT_EQ(m_manager.GetDrawStartedActions(m_keys[i]).size(), expected) << i;
+    ASSERT_EQ(m_manager.GetTextureLoadActions(m_keys[i]).size(), expected) << i;
+    ASSERT_EQ(m_manager.GetTextureCreateActions(m_keys[i]).size(), 0u) << i;
+    ASSERT_EQ(m_manager.GetProjectionTextureActions(ProjectionType::Orthographic, m_keys[i]).size(),
+              expected)
+        << i;
+    ASSERT_EQ(m_manager.GetProjectionTextureActions(ProjectionType::Perspective, m_keys[i]).size(),
+              0u)
+        << i;
+  }
+}
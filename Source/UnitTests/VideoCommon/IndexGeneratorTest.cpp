@@ -0,0 +1,119 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+using OpcodeDecoder::Primitive;
+
+constexpr Primitive PRIMITIVES[] = {
+    Primitive::GX_DRAW_QUADS,          Primitive::GX_DRAW_QUADS_2,
+    Primitive::GX_DRAW_TRIANGLES,      Primitive::GX_DRAW_TRIANGLE_STRIP,
+    Primitive::GX_DRAW_TRIANGLE_FAN,   Primitive::GX_DRAW_LINES,
+    Primitive::GX_DRAW_LINE_STRIP,     Primitive::GX_DRAW_POINTS,
+};
+
+// Enough for the largest draws below, at up to six indices per vertex.
+constexpr u32 BUFFER_SIZE = 0x10000 * 6;
+
+struct Config
+{
+  bool primitive_restart;
+  bool vs_expand;
+};
+
+class IndexGeneratorTest : public testing::TestWithParam<Config>
+{
+protected:
+  IndexGeneratorTest() : m_expected(BUFFER_SIZE), m_actual(BUFFER_SIZE)
+  {
+    g_Config.backend_info.bSupportsPrimitiveRestart = GetParam().primitive_restart;
+    g_Config.backend_info.bSupportsVSLinePointExpand = GetParam().vs_expand;
+    g_Config.backend_info.bSupportsGeometryShaders = false;
+    m_scalar.Init(false);
+  }
+
+  // Adds the same draws to the scalar and the SIMD generator, and compares the indices.
+  void Compare(IndexGenerator& simd)
+  {
+    for (Primitive primitive : PRIMITIVES)
+    {
+      for (u32 base_index : {0u, 1u, 1000u})
+      {
+        m_scalar.Start(m_expected.data());
+        simd.Start(m_actual.data());
+
+        m_scalar.AddIndices(Primitive::GX_DRAW_POINTS, base_index);
+        simd.AddIndices(Primitive::GX_DRAW_POINTS, base_index);
+        for (u32 num_vertices = 0; num_vertices < 150; num_vertices++)
+        {
+          m_scalar.AddIndices(primitive, num_vertices);
+          simd.AddIndices(primitive, num_vertices);
+        }
+
+        ASSERT_EQ(simd.GetIndexLen(), m_scalar.GetIndexLen());
+        ASSERT_EQ(simd.GetNumVerts(), m_scalar.GetNumVerts());
+        for (u32 i = 0; i < m_scalar.GetIndexLen(); i++)
+        {
+          ASSERT_EQ(m_actual[i], m_expected[i])
+              << "primitive " << static_cast<int>(primitive) << ", base " << base_index
+              << ", index " << i;
+        }
+      }
+    }
+  }
+
+  IndexGenerator m_scalar;
+  std::vector<u16> m_expected;
+  std::vector<u16> m_actual;
+};
+}  // namespace
+
+TEST_P(IndexGeneratorTest, MatchesScalar)
+{
+  IndexGenerator simd;
+  simd.Init();
+  Compare(simd);
+
+#ifdef _M_X86_64
+  // Also check the SSE2 kernels on machines that would use the AVX2 ones.
+  if (cpu_info.bAVX2)
+  {
+    cpu_info.bAVX2 = false;
+    simd.Init();
+    cpu_info.bAVX2 = true;
+    Compare(simd);
+  }
+#endif
+}
+
+TEST_P(IndexGeneratorTest, LargeDraw)
+{
+  // The largest draw that fits, which uses every index but the restart index.
+  IndexGenerator simd;
+  simd.Init();
+  const u32 num_vertices = GetParam().vs_expand ? 0x3FFF : 0xFFFF;
+  for (Primitive primitive : PRIMITIVES)
+  {
+    m_scalar.Start(m_expected.data());
+    simd.Start(m_actual.data());
+    m_scalar.AddIndices(primitive, num_vertices);
+    simd.AddIndices(primitive, num_vertices);
+    ASSERT_EQ(simd.GetIndexLen(), m_scalar.GetIndexLen());
+    for (u32 i = 0; i < m_scalar.GetIndexLen(); i++)
+      ASSERT_EQ(m_actual[i], m_expected[i]) << static_cast<int>(primitive) << ", " << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(All, IndexGeneratorTest,
+                         testing::Values(Config{false, false}, Config{true, false},
+                                         Config{false, true}, Config{true, true}));
@@ -0,0 +1,130 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+namespace
+{
+constexpr u32 VERTEX_SIZE = 12;
+
+// Counts the commands that are run, with every vertex format taking VERTEX_SIZE bytes.
+class CountingCallback final : public OpcodeDecoder::Callback
+{
+public:
+  OPCODE_CALLBACK(void OnXF(u16, u8, const u8*)) {}
+  OPCODE_CALLBACK(void OnCP(u8, u32)) {}
+  OPCODE_CALLBACK(void OnBP(u8, u32)) {}
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray, u32, u16, u8)) {}
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive, u8, u32, u16, const u8*)) {}
+  OPCODE_CALLBACK(void OnDisplayList(u32, u32)) {}
+  OPCODE_CALLBACK(void OnNop(u32)) {}
+  OPCODE_CALLBACK(void OnUnknown(u8, const u8*)) {}
+  OPCODE_CALLBACK(void OnCommand(const u8*, u32)) { num_commands++; }
+  OPCODE_CALLBACK(CPState& GetCPState()) { return m_cp_state; }
+  OPCODE_CALLBACK(u32 GetVertexSize(u8)) { return VERTEX_SIZE; }
+
+  u32 num_commands = 0;
+
+private:
+  CPState m_cp_state;
+};
+
+std::vector<u8> MakeCommand(std::vector<u8> header, u32 payload_size)
+{
+  header.resize(header.size() + payload_size, 0xab);
+  return header;
+}
+
+std::vector<u8> MakeXFLoad(u16 address, u32 count)
+{
+  return MakeCommand({0x10, 0x00, static_cast<u8>(count - 1), static_cast<u8>(address >> 8),
+                      static_cast<u8>(address)},
+                     count * 4);
+}
+
+std::vector<u8> Concat(const std::vector<std::vector<u8>>& commands)
+{
+  std::vector<u8> result;
+  for (const std::vector<u8>& command : commands)
+    result.insert(result.end(), command.begin(), command.end());
+  return result;
+}
+
+OpcodeDecoder::XFLoadBatch Scan(const std::vector<u8>& data)
+{
+  return OpcodeDecoder::ScanXFLoadBatch(data.data(), static_cast<u32>(data.size()));
+}
+}  // namespace
+
+TEST(OpcodeDecoding, CommandSizeMatchesRun)
+{
+  const std::vector<std::vector<u8>> commands{
+      MakeCommand({0x08, 0x50}, 4),                        // CP
+      MakeCommand({0x10, 0x00, 0x03, 0x10, 0x00}, 4 * 4),  // XF, 4 values
+      MakeCommand({0x20}, 4),                              // Indexed load
+      MakeCommand({0x40}, 8),                              // Display list
+      MakeCommand({0x61}, 4),                              // BP
+      MakeCommand({0x90, 0x00, 0x03}, 3 * VERTEX_SIZE),    // Triangles, 3 vertices
+      MakeCommand({0x48}, 0),                              // Invalidate vertex cache
+  };
+
+  for (const std::vector<u8>& command : commands)
+  {
+    CountingCallback callback;
+    const u32 size = static_cast<u32>(command.size());
+    EXPECT_EQ(OpcodeDecoder::GetCommandSize(command.data(), size, callback), size);
+    EXPECT_EQ(OpcodeDecoder::Run(command.data(), size, callback), size);
+    EXPECT_EQ(callback.num_commands, 1u);
+
+    // Until the whole command has arrived, nothing is run, and more data is asked for.
+    for (u32 available = 0; available < size; available++)
+    {
+      EXPECT_EQ(OpcodeDecoder::Run(command.data(), available, callback), 0u);
+      const u32 needed = OpcodeDecoder::GetCommandSize(command.data(), available, callback);
+      EXPECT_GT(needed, available);
+      EXPECT_LE(needed, size);
+    }
+    EXPECT_EQ(callback.num_commands, 1u);
+  }
+}
+
+TEST(OpcodeDecoding, ScanXFLoadBatch)
+{
+  // Consecutive loads are batched, up to the first one that doesn't continue the range.
+  const std::vector<u8> loads =
+      Concat({MakeXFLoad(0x20, 12), MakeXFLoad(0x2c, 4), MakeXFLoad(0x40, 4)});
+  OpcodeDecoder::XFLoadBatch batch = Scan(loads);
+  EXPECT_EQ(batch.address, 0x20);
+  EXPECT_EQ(batch.num_words, 16u);
+  EXPECT_EQ(batch.num_commands, 2u);
+  EXPECT_EQ(batch.size, 5u + 12 * 4 + 5 + 4 * 4);
+
+  // Other commands end the batch.
+  batch = Scan(Concat({MakeXFLoad(0x20, 12), MakeCommand({0x61}, 4), MakeXFLoad(0x2c, 4)}));
+  EXPECT_EQ(batch.num_commands, 1u);
+  EXPECT_EQ(Scan(MakeCommand({0x61}, 4)).num_commands, 0u);
+
+  // So do loads which haven't fully arrived.
+  batch = OpcodeDecoder::ScanXFLoadBatch(loads.data(), 5 + 12 * 4 + 5 + 4 * 4 - 1);
+  EXPECT_EQ(batch.num_commands, 1u);
+  EXPECT_EQ(OpcodeDecoder::ScanXFLoadBatch(loads.data(), 5).num_commands, 0u);
+
+  // XF registers are loaded one command at a time.
+  batch = Scan(Concat({MakeXFLoad(0xff8, 8), MakeXFLoad(0x1000, 4)}));
+  EXPECT_EQ(batch.num_commands, 1u);
+  EXPECT_EQ(Scan(MakeXFLoad(0xffc, 8)).num_commands, 0u);
+
+  // Batches are limited to what LoadXFReg takes at once.
+  std::vector<std::vector<u8>> matrices;
+  for (u16 address = 0; address < 0x200; address += 16)
+    matrices.push_back(MakeXFLoad(address, 16));
+  batch = Scan(Concat(matrices));
+  EXPECT_EQ(batch.num_words, 240u);
+  EXPECT_LE(batch.num_words, OpcodeDecoder::MAX_XF_BATCH_WORDS);
+}
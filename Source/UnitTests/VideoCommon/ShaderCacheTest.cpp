@@ -0,0 +1,94 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/GXPipelineTypes.h"
+#include "VideoCommon/ShaderCache.h"
+
+namespace
+{
+std::vector<VideoCommon::SerializedGXPipelineUid> MakeUids(u32 count)
+{
+  std::vector<VideoCommon::SerializedGXPipelineUid> uids(count);
+  for (u32 i = 0; i < count; i++)
+  {
+    uids[i].vertex_decl.stride = static_cast<int>(12 + i * 4);
+    uids[i].ps_uid.GetUidData()->genMode_numtevstages = i % 16;
+    uids[i].rasterization_state_bits = i;
+    uids[i].blending_state_bits = i * 0x10001;
+  }
+  return uids;
+}
+
+bool SameUids(const std::vector<VideoCommon::SerializedGXPipelineUid>& a,
+              const std::vector<VideoCommon::SerializedGXPipelineUid>& b)
+{
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0;
+}
+}  // namespace
+
+class PipelineUIDManifestTest : public testing::Test
+{
+protected:
+  PipelineUIDManifestTest()
+      : m_directory(File::CreateTempDir()), m_filename(m_directory + "/GALE01.uidmanifest")
+  {
+  }
+
+  ~PipelineUIDManifestTest() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+  std::string m_filename;
+};
+
+TEST_F(PipelineUIDManifestTest, RoundTrip)
+{
+  const std::vector<VideoCommon::SerializedGXPipelineUid> uids = MakeUids(100);
+  ASSERT_TRUE(VideoCommon::WritePipelineUIDManifest(m_filename, "GALE01", uids));
+
+  const auto read_uids = VideoCommon::ReadPipelineUIDManifest(m_filename, "GALE01");
+  ASSERT_TRUE(read_uids.has_value());
+  EXPECT_TRUE(SameUids(*read_uids, uids));
+
+  // Manifests are only used for the game they were written for.
+  EXPECT_FALSE(VideoCommon::ReadPipelineUIDManifest(m_filename, "GALP01").has_value());
+
+  ASSERT_TRUE(VideoCommon::WritePipelineUIDManifest(m_filename, "GALE01", {}));
+  const auto empty_uids = VideoCommon::ReadPipelineUIDManifest(m_filename, "GALE01");
+  ASSERT_TRUE(empty_uids.has_value());
+  EXPECT_TRUE(empty_uids->empty());
+}
+
+TEST_F(PipelineUIDManifestTest, RejectsBadCount)
+{
+  ASSERT_TRUE(VideoCommon::WritePipelineUIDManifest(m_filename, "GALE01", MakeUids(10)));
+
+  // The count follows the magic and version in the header.
+  const auto set_count = [&](u32 count) {
+    File::IOFile file(m_filename, "r+b");
+    ASSERT_TRUE(file.Seek(8, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteArray(&count, 1));
+  };
+
+  set_count(11);
+  EXPECT_FALSE(VideoCommon::ReadPipelineUIDManifest(m_filename, "GALE01").has_value());
+
+  // A huge count must be rejected without trying to allocate for it.
+  set_count(0xFFFFFFFF);
+  EXPECT_FALSE(VideoCommon::ReadPipelineUIDManifest(m_filename, "GALE01").has_value());
+
+  set_count(9);
+  const auto read_uids = VideoCommon::ReadPipelineUIDManifest(m_filename, "GALE01");
+  ASSERT_TRUE(read_uids.has_value());
+  EXPECT_EQ(read_uids->size(), 9u);
+}
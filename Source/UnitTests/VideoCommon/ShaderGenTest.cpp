@@ -0,0 +1,173 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderGenCommon.h"
+
+namespace
+{
+// A spread of pixel shaders with different numbers of TEV stages and texgens.
+std::vector<PixelShaderUid> MakePixelShaderUids()
+{
+  std::vector<PixelShaderUid> uids;
+  for (u32 stages = 0; stages < 16; stages++)
+  {
+    for (u32 texgens = 0; texgens < 8; texgens++)
+    {
+      PixelShaderUid uid;
+      pixel_shader_uid_data* data = uid.GetUidData();
+      data->genMode_numtevstages = stages;
+      data->genMode_numtexgens = texgens;
+      data->numColorChans = 2;
+      for (u32 i = 0; i <= stages; i++)
+      {
+        data->stagehash[i].cc = i * 0x1234567;
+        data->stagehash[i].ac = (i * 0x7654321) & ~3u;
+        data->stagehash[i].tevorders_texmap = i & 7;
+        data->stagehash[i].tevorders_texcoord = i % (texgens + 1);
+      }
+      uids.push_back(uid);
+    }
+  }
+  return uids;
+}
+}  // namespace
+
+TEST(ShaderCode, Write)
+{
+  ShaderCode code;
+  code.Write("void main() {{\n");
+  code.Write("  return;\n");
+  code.Write("  x = {};\n", 42);
+  code.Write("}}\n");
+  EXPECT_EQ(code.GetBuffer(), "void main() {\n  return;\n  x = 42;\n}\n");
+}
+
+TEST(ShaderCode, ReusesBuffers)
+{
+  const char* data;
+  {
+    ShaderCode code;
+    code.Write("first shader\n");
+    data = code.GetBuffer().data();
+  }
+
+  // The buffer of the previous object is handed to the next one, which must start out empty.
+  ShaderCode code;
+  EXPECT_TRUE(code.GetBuffer().empty());
+  EXPECT_EQ(code.GetBuffer().data(), data);
+
+  // Copies must not share the buffer.
+  code.Write("second shader\n");
+  ShaderCode copy = code;
+  copy.Write("copy\n");
+  EXPECT_EQ(code.GetBuffer(), "second shader\n");
+  EXPECT_EQ(copy.GetBuffer(), "second shader\ncopy\n");
+}
+
+TEST(ShaderSourceMemo, GeneratesOnce)
+{
+  ShaderSourceMemo memo;
+  PixelShaderUid uid;
+  ShaderHostConfig host_config = {};
+  int calls = 0;
+  const auto generate = [&] {
+    calls++;
+    ShaderCode code;
+    code.Write("shader {}\n", calls);
+    return code;
+  };
+
+  const ShaderSourceMemo::Source first =
+      memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, host_config, uid, generate);
+  const ShaderSourceMemo::Source second =
+      memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, host_config, uid, generate);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(*first, "shader 1\n");
+
+  // Anything else that affects the generated code is part of the key.
+  memo.Get(ShaderSourceMemo::Kind::UberPixel, APIType::Vulkan, host_config, uid, generate);
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::D3D, host_config, uid, generate);
+  host_config.msaa = true;
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, host_config, uid, generate);
+  uid.GetUidData()->genMode_numtevstages = 1;
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, host_config, uid, generate);
+  EXPECT_EQ(calls, 5);
+  EXPECT_EQ(memo.GetHits(), 1u);
+  EXPECT_EQ(memo.GetMisses(), 5u);
+
+  memo.Clear();
+  EXPECT_EQ(memo.GetSize(), 0u);
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, host_config, uid, generate);
+  EXPECT_EQ(calls, 6);
+}
+
+TEST(ShaderSourceMemo, EvictsOldest)
+{
+  ShaderSourceMemo memo(250);
+  const std::vector<PixelShaderUid> uids = MakePixelShaderUids();
+  const auto generate = [] {
+    ShaderCode code;
+    code.Write("{}", std::string(100, 'x'));
+    return code;
+  };
+
+  for (size_t i = 0; i < 3; i++)
+    memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[i], generate);
+  EXPECT_EQ(memo.GetSize(), 200u);
+
+  // The first shader was evicted to make room for the third, the other two are still there.
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[2], generate);
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[1], generate);
+  EXPECT_EQ(memo.GetHits(), 2u);
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[0], generate);
+  EXPECT_EQ(memo.GetHits(), 2u);
+}
+
+TEST(ShaderSourceMemo, EvictsOverEntryLimit)
+{
+  ShaderSourceMemo memo(ShaderSourceMemo::DEFAULT_MAX_SIZE, 2);
+  const std::vector<PixelShaderUid> uids = MakePixelShaderUids();
+  const auto generate = [] {
+    ShaderCode code;
+    code.Write("shader\n");
+    return code;
+  };
+
+  for (size_t i = 0; i < 3; i++)
+    memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[i], generate);
+  EXPECT_EQ(memo.GetSize(), 14u);
+
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[2], generate);
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[1], generate);
+  EXPECT_EQ(memo.GetHits(), 2u);
+  memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, {}, uids[0], generate);
+  EXPECT_EQ(memo.GetHits(), 2u);
+}
+
+TEST(ShaderSourceMemo, MatchesGenerator)
+{
+  const ShaderHostConfig host_config = {};
+  ShaderSourceMemo memo;
+  for (const PixelShaderUid& uid : MakePixelShaderUids())
+  {
+    const std::string expected =
+        GeneratePixelShaderCode(APIType::Vulkan, host_config, uid.GetUidData(), {}).GetBuffer();
+    for (int i = 0; i < 2; i++)
+    {
+      const ShaderSourceMemo::Source source =
+          memo.Get(ShaderSourceMemo::Kind::Pixel, APIType::Vulkan, host_config, uid, [&] {
+            return GeneratePixelShaderCode(APIType::Vulkan, host_config, uid.GetUidData(), {});
+          });
+      EXPECT_EQ(*source, expected);
+    }
+  }
+  EXPECT_EQ(memo.GetHits(), memo.GetMisses());
+}
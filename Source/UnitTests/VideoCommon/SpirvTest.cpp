@@ -0,0 +1,53 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/Spirv.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace
+{
+constexpr std::string_view COMPUTE_SHADER = R"(#version 450
+layout(local_size_x = 8) in;
+layout(std430, binding = 0) buffer Data { uint v[]; };
+void main() { v[gl_GlobalInvocationID.x] *= 2u; }
+)";
+
+std::optional<SPIRV::CodeVector> Compile(std::string_view source, APIType api_type)
+{
+  return SPIRV::CompileComputeShader(source, api_type, glslang::EShTargetSpv_1_0);
+}
+}  // namespace
+
+TEST(Spirv, CacheHitsAndMisses)
+{
+  const SPIRV::CacheStats start = SPIRV::GetCacheStats();
+
+  const std::optional<SPIRV::CodeVector> compiled = Compile(COMPUTE_SHADER, APIType::Vulkan);
+  ASSERT_TRUE(compiled.has_value());
+  ASSERT_FALSE(compiled->empty());
+  SPIRV::CacheStats stats = SPIRV::GetCacheStats();
+  EXPECT_EQ(stats.misses, start.misses + 1);
+  EXPECT_EQ(stats.hits, start.hits);
+
+  // The same source with the same options comes from the cache.
+  const std::optional<SPIRV::CodeVector> cached = Compile(COMPUTE_SHADER, APIType::Vulkan);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(*cached, *compiled);
+  stats = SPIRV::GetCacheStats();
+  EXPECT_EQ(stats.misses, start.misses + 1);
+  EXPECT_EQ(stats.hits, start.hits + 1);
+
+  // Changing the source or the target API compiles again.
+  const std::string changed_source = std::string(COMPUTE_SHADER) + "// changed\n";
+  EXPECT_TRUE(Compile(changed_source, APIType::Vulkan).has_value());
+  EXPECT_TRUE(Compile(COMPUTE_SHADER, APIType::Metal).has_value());
+  stats = SPIRV::GetCacheStats();
+  EXPECT_EQ(stats.misses, start.misses + 3);
+  EXPECT_EQ(stats.hits, start.hits + 1);
+}
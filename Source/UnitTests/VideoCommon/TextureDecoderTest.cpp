@@ -0,0 +1,158 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+// The SIMD code paths TexDecoder_Decode can pick from. They are selected by masking out CPU
+// features, so a path that the host doesn't support is skipped.
+enum class DecoderPath
+{
+  Default,
+  SSE2,
+  SSSE3,
+  AVX2,
+};
+
+constexpr std::string_view GetPathName(DecoderPath path)
+{
+  switch (path)
+  {
+  case DecoderPath::SSE2:
+    return "SSE2";
+  case DecoderPath::SSSE3:
+    return "SSSE3";
+  case DecoderPath::AVX2:
+    return "AVX2";
+  default:
+    return "Default";
+  }
+}
+
+// Large enough for the TLUT of C14X2 textures.
+constexpr size_t TLUT_SIZE = 0x4000 * sizeof(u16);
+}  // namespace
+
+class TextureDecoderTest : public testing::Test
+{
+protected:
+  void SetUp() override { m_saved_cpu_info = cpu_info; }
+  void TearDown() override { cpu_info = m_saved_cpu_info; }
+
+  bool SelectPath(DecoderPath path)
+  {
+    cpu_info = m_saved_cpu_info;
+#ifdef _M_X86_64
+    switch (path)
+    {
+    case DecoderPath::SSE2:
+      cpu_info.bSSSE3 = false;
+      cpu_info.bAVX2 = false;
+      return true;
+    case DecoderPath::SSSE3:
+      cpu_info.bAVX2 = false;
+      return m_saved_cpu_info.bSSSE3;
+    case DecoderPath::AVX2:
+      return m_saved_cpu_info.bAVX2;
+    default:
+      return true;
+    }
+#else
+    return path == DecoderPath::Default;
+#endif
+  }
+
+  void FillRandom(int width, int height, TextureFormat format)
+  {
+    std::mt19937 rng(width * 31 + height + static_cast<int>(format));
+    std::uniform_int_distribution<int> dist(0, 255);
+    m_src.resize(TexDecoder_GetTextureSizeInBytes(width, height, format));
+    for (u8& byte : m_src)
+      byte = static_cast<u8>(dist(rng));
+    m_tlut.resize(TLUT_SIZE);
+    for (u8& byte : m_tlut)
+      byte = static_cast<u8>(dist(rng));
+  }
+
+  // Decodes every texel separately with the generic reference decoder.
+  std::vector<u32> DecodeReference(int width, int height, TextureFormat format, TLUTFormat tlutfmt)
+  {
+    std::vector<u32> result(width * height);
+    for (int t = 0; t < height; t++)
+    {
+      for (int s = 0; s < width; s++)
+      {
+        TexDecoder_DecodeTexel(reinterpret_cast<u8*>(&result[t * width + s]), m_src, s, t,
+                               width - 1, format, m_tlut, tlutfmt);
+      }
+    }
+    return result;
+  }
+
+  std::vector<u32> Decode(int width, int height, TextureFormat format, TLUTFormat tlutfmt)
+  {
+    std::vector<u32> result(width * height, 0xDEADBEEF);
+    TexDecoder_Decode(reinterpret_cast<u8*>(result.data()), m_src.data(), width, height, format,
+                      m_tlut.data(), tlutfmt);
+    return result;
+  }
+
+  std::vector<u8> m_src;
+  std::vector<u8> m_tlut;
+
+private:
+  CPUInfo m_saved_cpu_info;
+};
+
+class TextureDecoderParamTest
+    : public TextureDecoderTest,
+      public ::testing::WithParamInterface<std::tuple<TextureFormat, TLUTFormat, DecoderPath>>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    AllFormats, TextureDecoderParamTest,
+    ::testing::Combine(::testing::Values(TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4,
+                                         TextureFormat::IA8, TextureFormat::RGB565,
+                                         TextureFormat::RGB5A3, TextureFormat::RGBA8,
+                                         TextureFormat::C4, TextureFormat::C8,
+                                         TextureFormat::C14X2, TextureFormat::CMPR),
+                       ::testing::Values(TLUTFormat::IA8, TLUTFormat::RGB565, TLUTFormat::RGB5A3),
+                       ::testing::Values(DecoderPath::Default, DecoderPath::SSE2,
+                                         DecoderPath::SSSE3, DecoderPath::AVX2)));
+
+TEST_P(TextureDecoderParamTest, MatchesReference)
+{
+  const auto [format, tlutfmt, path] = GetParam();
+  if (!IsColorIndexed(format) && tlutfmt != TLUTFormat::IA8)
+    GTEST_SKIP() << "TLUT format is irrelevant";
+  if (!SelectPath(path))
+    GTEST_SKIP() << GetPathName(path) << " is not supported on this host";
+
+  // 8x8 and 8x16 are smaller than the threshold some paths use to pick a decoder.
+  static constexpr std::pair<int, int> sizes[] = {{8, 8}, {8, 16}, {24, 16}, {64, 40}, {128, 128}};
+  for (const auto& [width, height] : sizes)
+  {
+    FillRandom(width, height, format);
+    const std::vector<u32> expected = DecodeReference(width, height, format, tlutfmt);
+    const std::vector<u32> actual = Decode(width, height, format, tlutfmt);
+    for (int i = 0; i < width * height; i++)
+    {
+      ASSERT_EQ(expected[i], actual[i])
+          << fmt::format("{}x{} texel ({}, {})", width, height, i % width, i / width);
+    }
+  }
+}
@@ -0,0 +1,145 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+#include "VideoCommon/Assets/TexturePackFile.h"
+
+namespace
+{
+constexpr u32 NUM_TEXTURES = 500;
+constexpr u32 NUM_LEVELS = 3;
+
+// Offsets into the file format, for corrupting files.
+constexpr u64 HEADER_LEVELS_OFFSET = 24;
+constexpr u64 LEVEL_SIZE_OFFSET = 16;
+
+std::string GetTextureName(u32 i)
+{
+  return "tex1_64x64_" + std::to_string(i) + "_6";
+}
+
+// Every other texture is block compressed, which is stored as is rather than with zstd.
+VideoCommon::CustomTextureData MakeTexture(u32 i)
+{
+  VideoCommon::CustomTextureData data;
+  auto& slice = data.m_slices.emplace_back();
+  for (u32 level_index = 0; level_index < NUM_LEVELS; level_index++)
+  {
+    auto& level = slice.m_levels.emplace_back();
+    level.width = 64 >> level_index;
+    level.height = 64 >> level_index;
+    level.row_length = level.width;
+    if (i % 2 == 0)
+    {
+      level.format = AbstractTextureFormat::RGBA8;
+      level.data.resize(level.width * level.height * 4);
+    }
+    else
+    {
+      // 8 bytes for each block of 4x4 texels
+      level.format = AbstractTextureFormat::DXT1;
+      level.data.resize((level.width / 4) * (level.height / 4) * 8);
+    }
+    for (std::size_t j = 0; j < level.data.size(); j++)
+      level.data[j] = static_cast<u8>(j / 16 + i + level_index);
+  }
+  return data;
+}
+
+class TexturePackFileTest : public testing::Test
+{
+protected:
+  TexturePackFileTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/pack.dtp")
+  {
+    VideoCommon::TexturePackWriter writer;
+    EXPECT_TRUE(writer.Open(m_path));
+    for (u32 i = 0; i < NUM_TEXTURES; i++)
+    {
+      EXPECT_TRUE(writer.AddTexture(VideoCommon::TexturePackWriter::Encode(
+          GetTextureName(i), i % 3 == 0, MakeTexture(i), 3)));
+    }
+    EXPECT_TRUE(writer.Close());
+  }
+
+  ~TexturePackFileTest() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(TexturePackFileTest, RoundTrip)
+{
+  VideoCommon::TexturePackFile pack;
+  ASSERT_TRUE(pack.Open(m_path));
+  ASSERT_EQ(pack.GetTextureCount(), NUM_TEXTURES);
+  EXPECT_FALSE(pack.FindTexture("tex1_64x64_missing_6"));
+
+  for (u32 i = 0; i < NUM_TEXTURES; i++)
+  {
+    const auto index = pack.FindTexture(GetTextureName(i));
+    ASSERT_TRUE(index) << i;
+    EXPECT_EQ(pack.GetTextureName(*index), GetTextureName(i));
+    EXPECT_EQ(pack.HasArbitraryMipmaps(*index), i % 3 == 0);
+
+    VideoCommon::CustomTextureData data;
+    ASSERT_TRUE(pack.LoadTexture(*index, &data)) << i;
+    const VideoCommon::CustomTextureData expected = MakeTexture(i);
+    ASSERT_EQ(data.m_slices.size(), 1u);
+    ASSERT_EQ(data.m_slices[0].m_levels.size(), NUM_LEVELS);
+    for (u32 level_index = 0; level_index < NUM_LEVELS; level_index++)
+    {
+      const auto& level = data.m_slices[0].m_levels[level_index];
+      const auto& expected_level = expected.m_slices[0].m_levels[level_index];
+      EXPECT_EQ(level.format, expected_level.format);
+      EXPECT_EQ(level.width, expected_level.width);
+      EXPECT_EQ(level.height, expected_level.height);
+      EXPECT_EQ(level.row_length, expected_level.row_length);
+      EXPECT_EQ(level.data, expected_level.data) << i << ", " << level_index;
+    }
+  }
+}
+
+TEST_F(TexturePackFileTest, RejectsLevelOfWrongSize)
+{
+  // The size of the first level, which is checked against its dimensions
+  File::IOFile file(m_path, "r+b");
+  u64 levels_offset;
+  ASSERT_TRUE(file.Seek(HEADER_LEVELS_OFFSET, File::SeekOrigin::Begin));
+  ASSERT_TRUE(file.ReadBytes(&levels_offset, sizeof(levels_offset)));
+  u64 size;
+  ASSERT_TRUE(file.Seek(levels_offset + LEVEL_SIZE_OFFSET, File::SeekOrigin::Begin));
+  ASSERT_TRUE(file.ReadBytes(&size, sizeof(size)));
+  size *= 2;
+  ASSERT_TRUE(file.Seek(levels_offset + LEVEL_SIZE_OFFSET, File::SeekOrigin::Begin));
+  ASSERT_TRUE(file.WriteBytes(&size, sizeof(size)));
+  file.Close();
+
+  VideoCommon::TexturePackFile pack;
+  EXPECT_FALSE(pack.Open(m_path));
+}
+
+TEST(TexturePackWriter, LeavesOutLevelOfWrongSize)
+{
+  VideoCommon::CustomTextureData data = MakeTexture(1);
+  data.m_slices[0].m_levels[1].data.resize(32 * 32 * 4);
+  EXPECT_TRUE(
+      VideoCommon::TexturePackWriter::Encode(GetTextureName(1), false, data, 3).levels.empty());
+}
+
+TEST_F(TexturePackFileTest, RejectsTruncatedFile)
+{
+  File::IOFile file(m_path, "r+b");
+  ASSERT_TRUE(file.Resize(file.GetSize() - 1));
+  file.Close();
+
+  VideoCommon::TexturePackFile pack;
+  EXPECT_FALSE(pack.Open(m_path));
+}
@@ -0,0 +1,256 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Image.h"
+#include "Core/ConfigManager.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/AbstractFramebuffer.h"
+#include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/AbstractPipeline.h"
+#include "VideoCommon/AbstractShader.h"
+#include "VideoCommon/AbstractStagingTexture.h"
+#include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/TextureConfig.h"
+#include "VideoCommon/TextureUtils.h"
+
+namespace
+{
+constexpr u32 TEXTURE_SIZE = 16;
+constexpr u32 NUM_LEVELS = 2;
+// More than the readbacks which are flushed at once.
+constexpr u32 NUM_TEXTURES = 70;
+
+u8 MakeTexel(u8 seed, u32 level, std::size_t offset)
+{
+  return static_cast<u8>(seed + level * 64 + offset);
+}
+
+class TestTexture final : public AbstractTexture
+{
+public:
+  explicit TestTexture(u8 seed)
+      : AbstractTexture(TextureConfig(TEXTURE_SIZE, TEXTURE_SIZE, NUM_LEVELS, 1, 1,
+                                      AbstractTextureFormat::RGBA8, 0,
+                                      AbstractTextureType::Texture_2DArray)),
+        m_seed(seed)
+  {
+  }
+
+  void CopyRectangleFromTexture(const AbstractTexture*, const MathUtil::Rectangle<int>&, u32, u32,
+                                const MathUtil::Rectangle<int>&, u32, u32) override
+  {
+  }
+  void ResolveFromTexture(const AbstractTexture*, const MathUtil::Rectangle<int>&, u32,
+                          u32) override
+  {
+  }
+  void Load(u32, u32, u32, u32, const u8*, size_t, u32) override {}
+
+  const u8 m_seed;
+};
+
+// Reads back the texels of a TestTexture, which are made from its seed and the level.
+class TestStagingTexture final : public AbstractStagingTexture
+{
+public:
+  TestStagingTexture(StagingTextureType type, const TextureConfig& config)
+      : AbstractStagingTexture(type, config), m_data(m_texel_size * config.width * config.height)
+  {
+    m_map_pointer = reinterpret_cast<char*>(m_data.data());
+    m_map_stride = m_texel_size * config.width;
+  }
+
+  void CopyFromTexture(const AbstractTexture* src, const MathUtil::Rectangle<int>&, u32,
+                       u32 src_level, const MathUtil::Rectangle<int>&) override
+  {
+    const u8 seed = static_cast<const TestTexture*>(src)->m_seed;
+    for (std::size_t i = 0; i < m_data.size(); i++)
+      m_data[i] = MakeTexel(seed, src_level, i);
+    m_needs_flush = true;
+  }
+  void CopyToTexture(const MathUtil::Rectangle<int>&, AbstractTexture*,
+                     const MathUtil::Rectangle<int>&, u32, u32) override
+  {
+  }
+  bool Map() override { return true; }
+  void Unmap() override {}
+  void Flush() override { m_needs_flush = false; }
+
+private:
+  std::vector<u8> m_data;
+};
+
+class TestGfx final : public AbstractGfx
+{
+public:
+  bool IsHeadless() const override { return true; }
+  std::unique_ptr<AbstractTexture> CreateTexture(const TextureConfig&, std::string_view) override
+  {
+    return nullptr;
+  }
+  std::unique_ptr<AbstractStagingTexture> CreateStagingTexture(StagingTextureType type,
+                                                               const TextureConfig& config) override
+  {
+    m_num_staging_textures++;
+    if (m_fail_staging_textures)
+      return nullptr;
+    return std::make_unique<TestStagingTexture>(type, config);
+  }
+  std::unique_ptr<AbstractFramebuffer> CreateFramebuffer(AbstractTexture*, AbstractTexture*,
+                                                         std::vector<AbstractTexture*>) override
+  {
+    return nullptr;
+  }
+  std::unique_ptr<AbstractShader> CreateShaderFromSource(ShaderStage, std::string_view,
+                                                         std::string_view) override
+  {
+    return nullptr;
+  }
+  std::unique_ptr<AbstractShader> CreateShaderFromBinary(ShaderStage, const void*, size_t,
+                                                         std::string_view) override
+  {
+    return nullptr;
+  }
+  std::unique_ptr<NativeVertexFormat>
+  CreateNativeVertexFormat(const PortableVertexDeclaration&) override
+  {
+    return nullptr;
+  }
+  std::unique_ptr<AbstractPipeline> CreatePipeline(const AbstractPipelineConfig&, const void*,
+                                                   size_t) override
+  {
+    return nullptr;
+  }
+  SurfaceInfo GetSurfaceInfo() const override { return {}; }
+
+  u32 m_num_staging_textures = 0;
+  bool m_fail_staging_textures = false;
+};
+
+class TextureDumperTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    // Created when Dolphin starts.
+    File::CreateFullPath(File::GetUserPath(D_DUMPTEXTURES_IDX));
+    Config::Init();
+    SConfig::Init();
+    auto gfx = std::make_unique<TestGfx>();
+    m_gfx = gfx.get();
+    g_gfx = std::move(gfx);
+  }
+
+  void TearDown() override
+  {
+    g_gfx.reset();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  static std::string GetDumpPath(const std::string& name)
+  {
+    return fmt::format("{}{}/{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
+                       SConfig::GetInstance().GetGameID(), name);
+  }
+
+  // Checks that the dumped image holds the texels of the given texture level.
+  static void ExpectDumped(const std::string& name, u8 seed, u32 level)
+  {
+    std::string file;
+    ASSERT_TRUE(File::ReadFileToString(GetDumpPath(name), file)) << name;
+    const std::vector<u8> png(file.begin(), file.end());
+    std::vector<u8> data;
+    u32 width = 0;
+    u32 height = 0;
+    ASSERT_TRUE(Common::LoadPNG(png, &data, &width, &height)) << name;
+
+    const u32 size = TEXTURE_SIZE >> level;
+    EXPECT_EQ(width, size);
+    EXPECT_EQ(height, size);
+    ASSERT_EQ(data.size(), std::size_t(size) * size * 4);
+    for (std::size_t i = 0; i < data.size(); i++)
+      ASSERT_EQ(data[i], MakeTexel(seed, level, i)) << name << ", byte " << i;
+  }
+
+  std::string m_profile_path;
+  TestGfx* m_gfx = nullptr;
+};
+}  // namespace
+
+TEST_F(TextureDumperTest, DumpsEachTextureOnce)
+{
+  std::vector<std::unique_ptr<TestTexture>> textures;
+  for (u32 i = 0; i < NUM_TEXTURES; i++)
+    textures.push_back(std::make_unique<TestTexture>(static_cast<u8>(i)));
+
+  VideoCommon::TextureUtils::TextureDumper dumper;
+  // Every texture is loaded twice, as a game would.
+  for (u32 pass = 0; pass < 2; pass++)
+  {
+    for (u32 i = 0; i < NUM_TEXTURES; i++)
+    {
+      for (u32 level = 0; level < NUM_LEVELS; level++)
+        dumper.DumpTexture(*textures[i], fmt::format("tex_{}", i), level, false);
+    }
+    dumper.Flush();
+  }
+  dumper.Shutdown();
+
+  EXPECT_EQ(m_gfx->m_num_staging_textures, NUM_TEXTURES * NUM_LEVELS);
+  for (u32 i = 0; i < NUM_TEXTURES; i++)
+  {
+    ExpectDumped(fmt::format("tex_{}", i), static_cast<u8>(i), 0);
+    ExpectDumped(fmt::format("tex_{}_mip1", i), static_cast<u8>(i), 1);
+  }
+}
+
+TEST_F(TextureDumperTest, RetriesTexturesWhichFailedToReadBack)
+{
+  const TestTexture texture(7);
+  VideoCommon::TextureUtils::TextureDumper dumper;
+
+  m_gfx->m_fail_staging_textures = true;
+  dumper.DumpTexture(texture, "tex", 0, false);
+  dumper.Flush();
+  EXPECT_FALSE(File::Exists(GetDumpPath("tex")));
+
+  m_gfx->m_fail_staging_textures = false;
+  dumper.DumpTexture(texture, "tex", 0, false);
+  dumper.Shutdown();
+
+  EXPECT_EQ(m_gfx->m_num_staging_textures, 2u);
+  ExpectDumped("tex", 7, 0);
+}
+
+TEST_F(TextureDumperTest, SkipsTexturesAlreadyInTheDumpFolder)
+{
+  const TestTexture texture(7);
+  ASSERT_TRUE(File::CreateFullPath(GetDumpPath("tex")));
+  ASSERT_TRUE(File::WriteStringToFile(GetDumpPath("tex"), "existing"));
+
+  VideoCommon::TextureUtils::TextureDumper dumper;
+  dumper.DumpTexture(texture, "tex", 0, false);
+  dumper.Shutdown();
+
+  EXPECT_EQ(m_gfx->m_num_staging_textures, 0u);
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(GetDumpPath("tex"), contents));
+  EXPECT_EQ(contents, "existing");
+}
@@ -1,15 +1,19 @@
 // Copyright 2014 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <bit>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <gtest/gtest.h>  // NOLINT
 
+#include "Common/CPUDetect.h"
 #include "Common/Common.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/CPMemory.h"
@@ -1065,6 +1069,146 @@ TEST_P(VertexLoaderSkippedTexCoordsTest, SkippedTextures)
   }
 }
 
+class VertexLoaderAVX2Test
+    : public VertexLoaderTest,
+      public ::testing::WithParamInterface<std::tuple<VertexComponentFormat, ComponentFormat>>
+{
+protected:
+  // Creates the loader for the current format with and without the AVX2 pair loop.
+  std::unique_ptr<VertexLoaderBase> CreateLoader(bool avx2)
+  {
+    const bool had_avx2 = cpu_info.bAVX2;
+    cpu_info.bAVX2 = avx2;
+    std::unique_ptr<VertexLoaderBase> loader =
+        VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
+    cpu_info.bAVX2 = had_avx2;
+    return loader;
+  }
+
+  // Copied as bytes, as they may hold NaNs.
+  struct ZFreezeCaches
+  {
+    static ZFreezeCaches Get()
+    {
+      return {VertexLoaderManager::position_cache, VertexLoaderManager::position_matrix_index_cache,
+              VertexLoaderManager::tangent_cache, VertexLoaderManager::binormal_cache};
+    }
+
+    std::array<std::array<float, 4>, 3> position;
+    std::array<u32, 3> position_matrix_index;
+    std::array<float, 4> tangent;
+    std::array<float, 4> binormal;
+  };
+
+  static void ResetCaches()
+  {
+    VertexLoaderManager::position_cache = {};
+    VertexLoaderManager::position_matrix_index_cache = {};
+    VertexLoaderManager::tangent_cache = {};
+    VertexLoaderManager::binormal_cache = {};
+  }
+
+  // Uses every attribute, with a mix of direct and indexed addressing.
+  void SetUpAllAttributes(VertexComponentFormat addr, ComponentFormat format)
+  {
+    const VertexComponentFormat other_addr = IsIndexed(addr) ? VertexComponentFormat::Direct :
+                                                               VertexComponentFormat::Index16;
+    m_vtx_desc.low.PosMatIdx = 1;
+    m_vtx_desc.low.Tex1MatIdx = 1;
+    m_vtx_desc.low.Tex2MatIdx = 1;
+    m_vtx_desc.low.Position = addr;
+    m_vtx_desc.low.Normal = other_addr;
+    m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+    m_vtx_desc.low.Color1 = addr;
+    m_vtx_desc.high.Tex0Coord = addr;
+    m_vtx_desc.high.Tex1Coord = other_addr;
+
+    m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+    m_vtx_attr.g0.PosFormat = format;
+    m_vtx_attr.g0.PosFrac = 5;
+    m_vtx_attr.g0.ByteDequant = true;
+    m_vtx_attr.g0.NormalElements = NormalComponentCount::NTB;
+    m_vtx_attr.g0.NormalFormat = format;
+    m_vtx_attr.g0.NormalIndex3 = true;
+    m_vtx_attr.g0.Color0Elements = ColorComponentCount::RGBA;
+    m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+    m_vtx_attr.g0.Color1Elements = ColorComponentCount::RGB;
+    m_vtx_attr.g0.Color1Comp = ColorFormat::RGB565;
+    m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g0.Tex0CoordFormat = format;
+    m_vtx_attr.g0.Tex0Frac = 3;
+    m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::S;
+    m_vtx_attr.g1.Tex1CoordFormat = format;
+  }
+};
+INSTANTIATE_TEST_SUITE_P(
+    AllCombinations, VertexLoaderAVX2Test,
+    ::testing::Combine(::testing::Values(VertexComponentFormat::Direct,
+                                         VertexComponentFormat::Index8,
+                                         VertexComponentFormat::Index16),
+                       ::testing::Values(ComponentFormat::UByte, ComponentFormat::Byte,
+                                         ComponentFormat::UShort, ComponentFormat::Short,
+                                         ComponentFormat::Float)));
+
+TEST_P(VertexLoaderAVX2Test, MatchesSSE)
+{
+  if (!cpu_info.bAVX2)
+    GTEST_SKIP() << "AVX2 is not supported";
+
+  VertexComponentFormat addr;
+  ComponentFormat format;
+  std::tie(addr, format) = GetParam();
+  SetUpAllAttributes(addr, format);
+
+  const std::unique_ptr<VertexLoaderBase> sse_loader = CreateLoader(false);
+  const std::unique_ptr<VertexLoaderBase> avx2_loader = CreateLoader(true);
+  const u32 vertex_size = sse_loader->m_vertex_size;
+  const u32 stride = sse_loader->m_native_vtx_decl.stride;
+  ASSERT_EQ(avx2_loader->m_vertex_size, vertex_size);
+  ASSERT_EQ(avx2_loader->m_native_vtx_decl.stride, stride);
+
+  // Random vertex data, with indices into arrays that are also random.
+  u32 seed = 12345;
+  for (u8& byte : input_memory)
+  {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<u8>(seed >> 16);
+  }
+  u8* const array_base = input_memory + sizeof(input_memory) / 2;
+  for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; i++)
+  {
+    VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] = array_base;
+    g_main_cp_state.array_strides[static_cast<CPArray>(i)] = 40 + i;
+  }
+
+  // Skip some vertices, both at the start and in the middle of a pair. The position comes after
+  // the three matrix indices.
+  if (IsIndexed(addr))
+  {
+    const size_t index_size = addr == VertexComponentFormat::Index8 ? 1 : 2;
+    for (u32 i = 3; i < 10000; i += 7)
+      memset(input_memory + i * vertex_size + 3, 0xFF, index_size);
+  }
+
+  std::vector<u8> expected(10000 * stride + 16);
+  for (int count : {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 9999})
+  {
+    // Fewer than three vertices only update some of the zfreeze caches.
+    ResetCaches();
+    memset(output_memory, 0xFF, expected.size());
+    const int expected_count = sse_loader->RunVertices(input_memory, output_memory, count);
+    memcpy(expected.data(), output_memory, expected.size());
+    const ZFreezeCaches expected_caches = ZFreezeCaches::Get();
+    ResetCaches();
+    memset(output_memory, 0xFF, expected.size());
+    ASSERT_EQ(avx2_loader->RunVertices(input_memory, output_memory, count), expected_count);
+    EXPECT_EQ(memcmp(expected.data(), output_memory, expected_count * stride), 0)
+        << "count " << count;
+    const ZFreezeCaches caches = ZFreezeCaches::Get();
+    EXPECT_EQ(memcmp(&expected_caches, &caches, sizeof(caches)), 0) << "count " << count;
+  }
+}
+
 // For gtest, which doesn't know about our fmt::formatters by default
 static void PrintTo(const VertexComponentFormat& t, std::ostream* os)
 {
@@ -0,0 +1,107 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/XFMemory.h"
+
+namespace
+{
+class XFMemoryUsedTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::memset(static_cast<void*>(&xfmem), 0, sizeof(xfmem));
+    g_main_cp_state.matrix_index_a.Hex = 0;
+    g_main_cp_state.matrix_index_b.Hex = 0;
+  }
+
+  static bool IsRowUsed(u32 address, u32 components = 0)
+  {
+    return IsXFMemoryUsed(address, address + 1, components);
+  }
+};
+}  // namespace
+
+TEST_F(XFMemoryUsedTest, PositionMatrix)
+{
+  g_main_cp_state.matrix_index_a.PosNormalMtxIdx = 3;
+
+  // Three rows of four values, and the three rows of the matching normal matrix.
+  EXPECT_FALSE(IsRowUsed(XFMEM_POSMATRICES + 11));
+  EXPECT_TRUE(IsRowUsed(XFMEM_POSMATRICES + 12));
+  EXPECT_TRUE(IsRowUsed(XFMEM_POSMATRICES + 23));
+  EXPECT_FALSE(IsRowUsed(XFMEM_POSMATRICES + 24));
+  EXPECT_FALSE(IsRowUsed(XFMEM_NORMALMATRICES + 8));
+  EXPECT_TRUE(IsRowUsed(XFMEM_NORMALMATRICES + 9));
+  EXPECT_TRUE(IsRowUsed(XFMEM_NORMALMATRICES + 17));
+  EXPECT_FALSE(IsRowUsed(XFMEM_NORMALMATRICES + 18));
+
+  // Loads which span the matrix.
+  EXPECT_TRUE(IsXFMemoryUsed(XFMEM_POSMATRICES, XFMEM_POSMATRICES_END, 0));
+  EXPECT_FALSE(IsXFMemoryUsed(XFMEM_POSMATRICES + 24, XFMEM_POSMATRICES + 36, 0));
+
+  // With per-vertex indices, any of them may be used.
+  EXPECT_TRUE(IsRowUsed(XFMEM_POSMATRICES + 100, VB_HAS_POSMTXIDX));
+  EXPECT_TRUE(IsRowUsed(XFMEM_NORMALMATRICES + 50, VB_HAS_POSMTXIDX));
+  EXPECT_FALSE(IsRowUsed(XFMEM_POSTMATRICES, VB_HAS_POSMTXIDX));
+}
+
+TEST_F(XFMemoryUsedTest, TextureMatrices)
+{
+  g_main_cp_state.matrix_index_a.Tex1MtxIdx = 30;
+  g_main_cp_state.matrix_index_b.Tex4MtxIdx = 40;
+  EXPECT_FALSE(IsRowUsed(XFMEM_POSMATRICES + 120));
+
+  // Only the matrices of enabled texgens are used.
+  xfmem.numTexGen.numTexGens = 2;
+  EXPECT_TRUE(IsRowUsed(XFMEM_POSMATRICES + 120));
+  EXPECT_FALSE(IsRowUsed(XFMEM_POSMATRICES + 160));
+  EXPECT_TRUE(IsRowUsed(XFMEM_POSMATRICES + 160, VB_HAS_TEXMTXIDX1));
+  xfmem.numTexGen.numTexGens = 5;
+  EXPECT_TRUE(IsRowUsed(XFMEM_POSMATRICES + 171));
+
+  // Post-transform matrices are only used with dual texture transforms.
+  xfmem.postMtxInfo[0].index = 5;
+  EXPECT_FALSE(IsRowUsed(XFMEM_POSTMATRICES + 20));
+  xfmem.dualTexTrans.enabled = true;
+  EXPECT_TRUE(IsRowUsed(XFMEM_POSTMATRICES + 20));
+  EXPECT_FALSE(IsRowUsed(XFMEM_POSTMATRICES + 32));
+}
+
+TEST_F(XFMemoryUsedTest, Lights)
+{
+  const u32 light_size = sizeof(Light) / sizeof(u32);
+  xfmem.numChan.numColorChans = 1;
+  xfmem.color[0].lightMask0_3 = 0b0100;
+  EXPECT_FALSE(IsRowUsed(XFMEM_LIGHTS + light_size * 2));
+
+  xfmem.color[0].enablelighting = true;
+  EXPECT_TRUE(IsRowUsed(XFMEM_LIGHTS + light_size * 2));
+  EXPECT_FALSE(IsRowUsed(XFMEM_LIGHTS + light_size * 3));
+
+  xfmem.alpha[0].enablelighting = true;
+  xfmem.alpha[0].lightMask4_7 = 0b0010;
+  EXPECT_TRUE(IsRowUsed(XFMEM_LIGHTS + light_size * 5 + light_size - 1));
+
+  // Emboss mapping uses the position of a light.
+  xfmem.numTexGen.numTexGens = 1;
+  xfmem.texMtxInfo[0].texgentype = TexGenType::EmbossMap;
+  xfmem.texMtxInfo[0].embosslightshift = 7;
+  EXPECT_TRUE(IsRowUsed(XFMEM_LIGHTS + light_size * 7));
+}
+
+TEST_F(XFMemoryUsedTest, UnusedMemory)
+{
+  xfmem.numTexGen.numTexGens = 8;
+  xfmem.numChan.numColorChans = 2;
+  EXPECT_FALSE(IsXFMemoryUsed(XFMEM_POSMATRICES_END, XFMEM_NORMALMATRICES, VB_HAS_POSMTXIDX));
+  EXPECT_FALSE(IsXFMemoryUsed(XFMEM_NORMALMATRICES_END, XFMEM_POSTMATRICES, VB_HAS_POSMTXIDX));
+  EXPECT_FALSE(IsXFMemoryUsed(XFMEM_LIGHTS_END, XFMEM_REGISTERS_START, VB_HAS_POSMTXIDX));
+}